@@ -16,6 +16,15 @@
 
 package benchmarks;
 
+import com.google.caliper.AfterExperiment;
+import com.google.caliper.BeforeExperiment;
+import com.google.caliper.Param;
+import dalvik.system.PathClassLoader;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.util.zip.ZipEntry;
+import java.util.zip.ZipOutputStream;
 import junit.framework.Assert;
 
 public class ClassLoaderResourceBenchmark {
@@ -23,6 +32,68 @@ public class ClassLoaderResourceBenchmark {
   private static final String EXISTENT_RESOURCE = "java/util/logging/logging.properties";
   private static final String MISSING_RESOURCE = "missing_entry";
 
+  /** The number of jars (and library directories) on the path of the app class loader. */
+  @Param({"1", "10", "50"})
+  int elementCount;
+
+  private File tmpDir;
+  private PathClassLoader appClassLoader;
+  private String lastJarResource;
+  private String lastLibrary;
+
+  @BeforeExperiment
+  protected void setUp() throws Exception {
+    tmpDir = File.createTempFile("ClassLoaderResourceBenchmark", null);
+    tmpDir.delete();
+    tmpDir.mkdirs();
+
+    StringBuilder dexPath = new StringBuilder();
+    StringBuilder libraryPath = new StringBuilder();
+    for (int i = 0; i < elementCount; i++) {
+      if (i > 0) {
+        dexPath.append(File.pathSeparator);
+        libraryPath.append(File.pathSeparator);
+      }
+      File jar = new File(tmpDir, "split" + i + ".jar");
+      try (ZipOutputStream out = new ZipOutputStream(new FileOutputStream(jar))) {
+        // Give each jar a realistic number of entries.
+        for (int entry = 0; entry < 200; entry++) {
+          out.putNextEntry(new ZipEntry("res/split" + i + "/entry" + entry + ".xml"));
+          out.closeEntry();
+        }
+      }
+      dexPath.append(jar);
+
+      File libDir = new File(tmpDir, "lib" + i);
+      libDir.mkdirs();
+      touch(new File(libDir, "libsplit" + i + ".so"));
+      libraryPath.append(libDir);
+    }
+    lastJarResource = "res/split" + (elementCount - 1) + "/entry199.xml";
+    lastLibrary = "split" + (elementCount - 1);
+    appClassLoader = new PathClassLoader(dexPath.toString(), libraryPath.toString(),
+        Object.class.getClassLoader());
+  }
+
+  @AfterExperiment
+  protected void tearDown() {
+    deleteRecursively(tmpDir);
+  }
+
+  private static void touch(File file) throws IOException {
+    new FileOutputStream(file).close();
+  }
+
+  private static void deleteRecursively(File file) {
+    File[] children = file.listFiles();
+    if (children != null) {
+      for (File child : children) {
+        deleteRecursively(child);
+      }
+    }
+    file.delete();
+  }
+
   public void timeGetBootResource_hit(int reps) {
     ClassLoader currentClassLoader = getClass().getClassLoader();
     Assert.assertNotNull(currentClassLoader.getResource(EXISTENT_RESOURCE));
@@ -41,4 +112,35 @@ public class ClassLoaderResourceBenchmark {
     }
   }
 
+  public void timeGetAppResource_hitInLastJar(int reps) {
+    Assert.assertNotNull(appClassLoader.getResource(lastJarResource));
+
+    for (int rep = 0; rep < reps; ++rep) {
+      appClassLoader.getResource(lastJarResource);
+    }
+  }
+
+  public void timeGetAppResource_miss(int reps) {
+    Assert.assertNull(appClassLoader.getResource(MISSING_RESOURCE));
+
+    for (int rep = 0; rep < reps; ++rep) {
+      appClassLoader.getResource(MISSING_RESOURCE);
+    }
+  }
+
+  public void timeFindLibrary_hitInLastDirectory(int reps) {
+    Assert.assertNotNull(appClassLoader.findLibrary(lastLibrary));
+
+    for (int rep = 0; rep < reps; ++rep) {
+      appClassLoader.findLibrary(lastLibrary);
+    }
+  }
+
+  public void timeFindLibrary_miss(int reps) {
+    Assert.assertNull(appClassLoader.findLibrary(MISSING_RESOURCE));
+
+    for (int rep = 0; rep < reps; ++rep) {
+      appClassLoader.findLibrary(MISSING_RESOURCE);
+    }
+  }
 }
@@ -16,10 +16,14 @@
 
 package benchmarks;
 
+import java.util.ArrayList;
 import java.util.HashMap;
+import java.util.HashSet;
 import java.util.Hashtable;
 import java.util.LinkedHashMap;
+import java.util.List;
 import java.util.concurrent.ConcurrentHashMap;
+import libcore.util.IntHashMap;
 
 /**
  * How do the various hash maps compare?
@@ -64,4 +68,58 @@ public class HashedCollectionsBenchmark {
             map.get("hello");
         }
     }
+
+    private static final int LARGE_SIZE = 10000;
+
+    public void timeHashMapCopy_Large(int reps) {
+        HashMap<Integer, Integer> source = new HashMap<Integer, Integer>();
+        for (int i = 0; i < LARGE_SIZE; ++i) {
+            source.put(i, i);
+        }
+        for (int i = 0; i < reps; ++i) {
+            new HashMap<Integer, Integer>(source);
+        }
+    }
+    public void timeHashMapPutAll_LargeIntoNonEmpty(int reps) {
+        HashMap<Integer, Integer> source = new HashMap<Integer, Integer>();
+        for (int i = 0; i < LARGE_SIZE; ++i) {
+            source.put(i, i);
+        }
+        for (int i = 0; i < reps; ++i) {
+            HashMap<Integer, Integer> map = new HashMap<Integer, Integer>();
+            map.put(-1, -1);
+            map.putAll(source);
+        }
+    }
+    public void timeHashSetFromCollection_Large(int reps) {
+        List<Integer> source = new ArrayList<Integer>();
+        for (int i = 0; i < LARGE_SIZE; ++i) {
+            source.add(i);
+        }
+        for (int i = 0; i < reps; ++i) {
+            new HashSet<Integer>(source);
+        }
+    }
+    public void timeHashMapPutGet_IntegerKeys(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            HashMap<Integer, String> map = new HashMap<Integer, String>();
+            for (int key = 0; key < LARGE_SIZE; ++key) {
+                map.put(key * 7919, "value");
+            }
+            for (int key = 0; key < LARGE_SIZE; ++key) {
+                map.get(key * 7919);
+            }
+        }
+    }
+    public void timeIntHashMapPutGet(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            IntHashMap<String> map = new IntHashMap<String>();
+            for (int key = 0; key < LARGE_SIZE; ++key) {
+                map.put(key * 7919, "value");
+            }
+            for (int key = 0; key < LARGE_SIZE; ++key) {
+                map.get(key * 7919);
+            }
+        }
+    }
 }
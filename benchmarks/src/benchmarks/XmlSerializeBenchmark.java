@@ -18,6 +18,7 @@ package benchmarks;
 
 import com.google.caliper.BeforeExperiment;
 import com.google.caliper.Param;
+import java.io.ByteArrayOutputStream;
 import java.io.CharArrayWriter;
 import java.lang.reflect.Constructor;
 import java.util.Random;
@@ -37,8 +38,8 @@ public class XmlSerializeBenchmark {
     private Constructor<? extends XmlSerializer> kxmlConstructor;
     private Constructor<? extends XmlSerializer> fastConstructor;
 
-    private void serializeRandomXml(Constructor<? extends XmlSerializer> ctor, long seed)
-            throws Exception {
+    private void serializeRandomXml(Constructor<? extends XmlSerializer> ctor, long seed,
+            boolean toUtf8Stream) throws Exception {
         double contChance = dataset[0];
         double levelUpChance = dataset[1];
         double levelDownChance = dataset[2];
@@ -48,8 +49,11 @@ public class XmlSerializeBenchmark {
 
         XmlSerializer serializer = (XmlSerializer) ctor.newInstance();
 
-        CharArrayWriter w = new CharArrayWriter();
-        serializer.setOutput(w);
+        if (toUtf8Stream) {
+            serializer.setOutput(new ByteArrayOutputStream(), "UTF-8");
+        } else {
+            serializer.setOutput(new CharArrayWriter());
+        }
         int level = 0;
         Random r = new Random(seed);
         char[] toWrite = {'a','b','c','d','s','z'};
@@ -92,18 +96,26 @@ public class XmlSerializeBenchmark {
         }
     }
 
-    private void internalTimeSerializer(Constructor<? extends XmlSerializer> ctor, int reps)
-            throws Exception {
+    private void internalTimeSerializer(Constructor<? extends XmlSerializer> ctor, int reps,
+            boolean toUtf8Stream) throws Exception {
         for (int i = 0; i < reps; i++) {
-            serializeRandomXml(ctor, seed);
+            serializeRandomXml(ctor, seed, toUtf8Stream);
         }
     }
 
     public void timeKxml(int reps) throws Exception {
-        internalTimeSerializer(kxmlConstructor, reps);
+        internalTimeSerializer(kxmlConstructor, reps, false);
+    }
+
+    public void timeKxmlUtf8Stream(int reps) throws Exception {
+        internalTimeSerializer(kxmlConstructor, reps, true);
     }
 
     public void timeFast(int reps) throws Exception {
-        internalTimeSerializer(fastConstructor, reps);
+        internalTimeSerializer(fastConstructor, reps, false);
+    }
+
+    public void timeFastUtf8Stream(int reps) throws Exception {
+        internalTimeSerializer(fastConstructor, reps, true);
     }
 }
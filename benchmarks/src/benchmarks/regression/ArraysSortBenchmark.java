@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import com.google.caliper.BeforeExperiment;
+import com.google.caliper.Param;
+import java.util.Arrays;
+import java.util.Random;
+
+/**
+ * Sorts random primitive arrays. Each rep restores the unsorted contents,
+ * so compare against timeCopy for the cost of the sort alone.
+ */
+public class ArraysSortBenchmark {
+    @Param({"1000", "100000", "1000000", "10000000", "100000000"})
+    private int size;
+
+    @Param private Type type;
+
+    public enum Type { INT, LONG, FLOAT, DOUBLE };
+
+    // Only the arrays for the selected type are allocated.
+    private Object original;
+    private Object array;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        Random random = new Random(0);
+        switch (type) {
+            case INT: {
+                int[] a = new int[size];
+                for (int i = 0; i < size; i++) a[i] = random.nextInt();
+                original = a;
+                array = new int[size];
+                break;
+            }
+            case LONG: {
+                long[] a = new long[size];
+                for (int i = 0; i < size; i++) a[i] = random.nextLong();
+                original = a;
+                array = new long[size];
+                break;
+            }
+            case FLOAT: {
+                float[] a = new float[size];
+                for (int i = 0; i < size; i++) a[i] = (float) random.nextGaussian();
+                original = a;
+                array = new float[size];
+                break;
+            }
+            case DOUBLE: {
+                double[] a = new double[size];
+                for (int i = 0; i < size; i++) a[i] = random.nextGaussian();
+                original = a;
+                array = new double[size];
+                break;
+            }
+        }
+    }
+
+    public void timeCopy(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            System.arraycopy(original, 0, array, 0, size);
+        }
+    }
+
+    public void timeSort(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            System.arraycopy(original, 0, array, 0, size);
+            switch (type) {
+                case INT: Arrays.sort((int[]) array); break;
+                case LONG: Arrays.sort((long[]) array); break;
+                case FLOAT: Arrays.sort((float[]) array); break;
+                case DOUBLE: Arrays.sort((double[]) array); break;
+            }
+        }
+    }
+
+    public void timeParallelSort(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            System.arraycopy(original, 0, array, 0, size);
+            switch (type) {
+                case INT: Arrays.parallelSort((int[]) array); break;
+                case LONG: Arrays.parallelSort((long[]) array); break;
+                case FLOAT: Arrays.parallelSort((float[]) array); break;
+                case DOUBLE: Arrays.parallelSort((double[]) array); break;
+            }
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import com.google.caliper.BeforeExperiment;
+import com.google.caliper.Param;
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+import java.util.Base64;
+import java.util.Random;
+
+public class Base64Benchmark {
+    @Param({"64", "4096", "1048576"})
+    private int size;
+
+    public enum Variant {
+        BASIC {
+            Base64.Encoder encoder() { return Base64.getEncoder(); }
+            Base64.Decoder decoder() { return Base64.getDecoder(); }
+        },
+        URL {
+            Base64.Encoder encoder() { return Base64.getUrlEncoder(); }
+            Base64.Decoder decoder() { return Base64.getUrlDecoder(); }
+        },
+        MIME {
+            Base64.Encoder encoder() { return Base64.getMimeEncoder(); }
+            Base64.Decoder decoder() { return Base64.getMimeDecoder(); }
+        };
+
+        abstract Base64.Encoder encoder();
+        abstract Base64.Decoder decoder();
+    }
+
+    @Param private Variant variant;
+
+    private Base64.Encoder encoder;
+    private Base64.Decoder decoder;
+    private byte[] plain;
+    private byte[] encoded;
+    private ByteBuffer directPlain;
+    private byte[] streamBuffer;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        encoder = variant.encoder();
+        decoder = variant.decoder();
+        plain = new byte[size];
+        new Random(0).nextBytes(plain);
+        encoded = encoder.encode(plain);
+        directPlain = ByteBuffer.allocateDirect(size);
+        directPlain.put(plain);
+        streamBuffer = new byte[8192];
+    }
+
+    public void timeEncode(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            encoder.encode(plain);
+        }
+    }
+
+    public void timeDecode(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            decoder.decode(encoded);
+        }
+    }
+
+    public void timeEncodeDirectByteBuffer(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            directPlain.position(0);
+            encoder.encode(directPlain);
+        }
+    }
+
+    public void timeEncodeStream(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            ByteArrayOutputStream out = new ByteArrayOutputStream(encoded.length);
+            try (OutputStream os = encoder.wrap(out)) {
+                // Small writes, as from a serializer.
+                for (int off = 0; off < plain.length; off += 16) {
+                    os.write(plain, off, Math.min(16, plain.length - off));
+                }
+            }
+        }
+    }
+
+    public void timeDecodeStream(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            try (InputStream is = decoder.wrap(new ByteArrayInputStream(encoded))) {
+                while (is.read(streamBuffer) != -1) {
+                }
+            }
+        }
+    }
+}
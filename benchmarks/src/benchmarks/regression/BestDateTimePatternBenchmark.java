@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import java.util.Locale;
+import libcore.icu.ICU;
+
+/**
+ * Looks up patterns with ICU.getBestDateTimePattern, as DateFormat.getBestDateTimePattern
+ * and the framework's date formatting do.
+ */
+public class BestDateTimePatternBenchmark {
+    // Cycling through more combinations than ICU.java caches patterns for means each lookup
+    // goes to ICU4C, which still has a pattern generator cached for each of the locales.
+    private static final String[] SKELETONS = {
+        "MMMMd", "yMMMd", "yMd", "Hm", "hm", "MMMEd", "yMMMMEEEEd", "Hms", "hms", "yMMM",
+    };
+    private static final Locale[] LOCALES = {
+        Locale.US, Locale.GERMANY, Locale.FRANCE, Locale.JAPAN,
+    };
+
+    public void timeCachedPattern(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            ICU.getBestDateTimePattern("yMMMd", Locale.US);
+        }
+    }
+
+    public void timeUncachedPattern(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            ICU.getBestDateTimePattern(SKELETONS[i % SKELETONS.length],
+                    LOCALES[(i / SKELETONS.length) % LOCALES.length]);
+        }
+    }
+}
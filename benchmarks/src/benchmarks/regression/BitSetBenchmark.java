@@ -19,16 +19,36 @@ package benchmarks.regression;
 import com.google.caliper.BeforeExperiment;
 import com.google.caliper.Param;
 import java.util.BitSet;
+import java.util.Random;
 
 public class BitSetBenchmark {
-    @Param({ "1000", "10000" })
+    @Param({ "1000", "10000", "1000000", "10000000", "100000000" })
     private int size;
 
     private BitSet bs;
 
+    // Half of the bits set at random, for the bulk operations.
+    private BitSet dense;
+    private BitSet other;
+    private int[] indices;
+
     @BeforeExperiment
     protected void setUp() throws Exception {
         bs = new BitSet(size);
+        Random random = new Random(0);
+        dense = randomBitSet(random, size);
+        other = randomBitSet(random, size);
+        indices = new int[4096];
+    }
+
+    private static BitSet randomBitSet(Random random, int nbits) {
+        long[] words = new long[(nbits + 63) / 64];
+        for (int i = 0; i < words.length; i++) {
+            words[i] = random.nextLong();
+        }
+        BitSet result = BitSet.valueOf(words);
+        result.clear(nbits, words.length * 64);
+        return result;
     }
 
     public void timeIsEmptyTrue(int reps) {
@@ -73,4 +93,61 @@ public class BitSetBenchmark {
             bs.set(i % size, false);
         }
     }
+
+    public void timeCardinality(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            dense.cardinality();
+        }
+    }
+
+    public void timeAnd(int reps) {
+        BitSet target = (BitSet) dense.clone();
+        for (int i = 0; i < reps; ++i) {
+            target.and(other);
+        }
+    }
+
+    public void timeAndRange(int reps) {
+        BitSet target = (BitSet) dense.clone();
+        int from = size / 4;
+        int to = size - size / 4;
+        for (int i = 0; i < reps; ++i) {
+            target.and(other, from, to);
+        }
+    }
+
+    public void timeOrRange(int reps) {
+        BitSet target = (BitSet) dense.clone();
+        int from = size / 4;
+        int to = size - size / 4;
+        for (int i = 0; i < reps; ++i) {
+            target.or(other, from, to);
+        }
+    }
+
+    public void timeNextSetBitLoop(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            long sum = 0;
+            for (int j = dense.nextSetBit(0); j >= 0; j = dense.nextSetBit(j + 1)) {
+                sum += j;
+            }
+        }
+    }
+
+    public void timeForEachSetBit(int reps) {
+        final long[] sum = new long[1];
+        for (int i = 0; i < reps; ++i) {
+            dense.forEachSetBit(j -> sum[0] += j);
+        }
+    }
+
+    public void timeNextSetBits(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            int from = 0;
+            int n;
+            while ((n = dense.nextSetBits(from, indices, 0, indices.length)) == indices.length) {
+                from = indices[n - 1] + 1;
+            }
+        }
+    }
 }
@@ -159,4 +159,22 @@ public class DecimalFormatBenchmark {
             new DecimalFormat();
         }
     }
+
+    public void time_instantiationWithPattern(int reps) {
+        for (int i = 0; i < reps; i++) {
+            new DecimalFormat("#,##0.00");
+        }
+    }
+
+    public void time_getInstance(int reps) {
+        for (int i = 0; i < reps; i++) {
+            NumberFormat.getInstance(Locale.US);
+        }
+    }
+
+    public void time_instantiationAndFormat(int reps) {
+        for (int i = 0; i < reps; i++) {
+            new DecimalFormat("#,##0.00").format(TWO_DP_NUMBER);
+        }
+    }
 }
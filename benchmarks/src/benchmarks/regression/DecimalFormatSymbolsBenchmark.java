@@ -27,4 +27,10 @@ public class DecimalFormatSymbolsBenchmark {
             new DecimalFormatSymbols(locale);
         }
     }
+
+    public void time_getInstance(int reps) {
+        for (int i = 0; i < reps; i++) {
+            DecimalFormatSymbols.getInstance(locale);
+        }
+    }
 }
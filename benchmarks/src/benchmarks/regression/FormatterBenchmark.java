@@ -128,4 +128,39 @@ public class FormatterBenchmark {
             sb.append(" in it");
         }
     }
+
+    public void timeStringFormat_IntAndFixedPoint(int reps) {
+        Integer count = Integer.valueOf(1024); // We're not trying to benchmark boxing here.
+        Double ratio = Double.valueOf(10.24);
+        for (int i = 0; i < reps; i++) {
+            String.format(Locale.US, "count=%d ratio=%.2f", count, ratio);
+        }
+    }
+
+    public void timeStringFormat_IntAndFixedPointGerman(int reps) {
+        Integer count = Integer.valueOf(1024); // We're not trying to benchmark boxing here.
+        Double ratio = Double.valueOf(10.24);
+        for (int i = 0; i < reps; i++) {
+            String.format(Locale.GERMANY, "count=%d ratio=%.2f", count, ratio);
+        }
+    }
+
+    public void timeStringFormat_GroupedInt(int reps) {
+        Integer value = Integer.valueOf(1234567); // We're not trying to benchmark boxing here.
+        for (int i = 0; i < reps; i++) {
+            String.format(Locale.FRANCE, "%,d", value);
+        }
+    }
+
+    public void timeFormatter_ManyFormatsOneDestination(int reps) {
+        Integer value = Integer.valueOf(1024); // We're not trying to benchmark boxing here.
+        StringBuilder sb = new StringBuilder();
+        Formatter f = new Formatter(sb, Locale.US);
+        for (int i = 0; i < reps; i++) {
+            sb.setLength(0);
+            f.format("[%d] ", value);
+            f.format("%s: ", "name");
+            f.format("%.3f", 1.5);
+        }
+    }
 }
@@ -16,8 +16,15 @@
 
 package benchmarks.regression;
 
+import com.google.caliper.AfterExperiment;
+import com.google.caliper.BeforeExperiment;
 import com.google.caliper.Param;
 import java.io.File;
+import java.io.InputStream;
+import java.nio.file.Files;
+import java.nio.file.StandardCopyOption;
+import java.util.Enumeration;
+import java.util.jar.JarEntry;
 import java.util.jar.JarFile;
 import java.util.jar.Manifest;
 
@@ -28,6 +35,25 @@ public class JarFileBenchmark {
     })
     private String filename;
 
+    /** Worker threads used by the verifyAllEntries benchmarks. */
+    @Param({"1", "4"})
+    private int parallelism;
+
+    /** A writable copy of the jar, so that its timestamps can be changed. */
+    private File copy;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        copy = File.createTempFile("JarFileBenchmark", ".jar");
+        Files.copy(new File(filename).toPath(), copy.toPath(),
+                StandardCopyOption.REPLACE_EXISTING);
+    }
+
+    @AfterExperiment
+    protected void tearDown() {
+        copy.delete();
+    }
+
     public void time(int reps) throws Exception {
         File f = new File(filename);
         for (int i = 0; i < reps; ++i) {
@@ -36,4 +62,48 @@ public class JarFileBenchmark {
             jf.close();
         }
     }
+
+    /** Verifies a signed jar by streaming every entry on the calling thread. */
+    public void timeReadAllEntriesVerified(int reps) throws Exception {
+        File f = new File(filename);
+        byte[] buffer = new byte[8192];
+        for (int i = 0; i < reps; ++i) {
+            try (JarFile jf = new JarFile(f, true)) {
+                Enumeration<JarEntry> entries = jf.entries();
+                while (entries.hasMoreElements()) {
+                    try (InputStream in = jf.getInputStream(entries.nextElement())) {
+                        while (in.read(buffer) != -1) {
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Verifies a signed jar with worker threads. The file's timestamps are
+     * touched so that the verification result cache never hits.
+     */
+    public void timeVerifyAllEntries(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            // Changes the inode change time, which is part of the cache key.
+            copy.setLastModified(copy.lastModified());
+            try (JarFile jf = new JarFile(copy, true)) {
+                jf.verifyAllEntries(parallelism);
+            }
+        }
+    }
+
+    /** Reopens a signed jar whose verification result is already cached. */
+    public void timeVerifyAllEntries_cached(int reps) throws Exception {
+        File f = new File(filename);
+        try (JarFile jf = new JarFile(f, true)) {
+            jf.verifyAllEntries(parallelism);
+        }
+        for (int i = 0; i < reps; ++i) {
+            try (JarFile jf = new JarFile(f, true)) {
+                jf.verifyAllEntries(parallelism);
+            }
+        }
+    }
 }
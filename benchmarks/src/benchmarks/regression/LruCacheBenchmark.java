@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import com.google.caliper.BeforeExperiment;
+import com.google.caliper.Param;
+import libcore.util.BasicLruCache;
+import libcore.util.ConcurrentLruCache;
+
+/**
+ * Compares reads of the synchronized BasicLruCache with ConcurrentLruCache.
+ * Each thread does reps lookups, so the time per rep reflects how well reads
+ * scale with the number of threads.
+ */
+public class LruCacheBenchmark {
+    private static final int KEY_COUNT = 64;
+
+    @Param({"1", "4", "16"})
+    private int threadCount;
+
+    @Param({"BASIC", "CONCURRENT"})
+    private String implementation;
+
+    private Integer[] keys;
+    private BasicLruCache<Integer, Integer> basicCache;
+    private ConcurrentLruCache<Integer, Integer> concurrentCache;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        keys = new Integer[KEY_COUNT];
+        basicCache = new BasicLruCache<Integer, Integer>(KEY_COUNT);
+        concurrentCache = new ConcurrentLruCache<Integer, Integer>(KEY_COUNT);
+        for (int i = 0; i < KEY_COUNT; i++) {
+            keys[i] = i;
+            basicCache.put(keys[i], i);
+            concurrentCache.put(keys[i], i);
+        }
+    }
+
+    public void timeGet(final int reps) throws Exception {
+        final boolean concurrent = implementation.equals("CONCURRENT");
+        Thread[] threads = new Thread[threadCount];
+        for (int t = 0; t < threadCount; t++) {
+            threads[t] = new Thread(() -> {
+                for (int i = 0; i < reps; ++i) {
+                    Integer key = keys[i & (KEY_COUNT - 1)];
+                    if (concurrent) {
+                        concurrentCache.get(key);
+                    } else {
+                        basicCache.get(key);
+                    }
+                }
+            });
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+    }
+}
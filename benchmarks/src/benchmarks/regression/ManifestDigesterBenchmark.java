@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import com.google.caliper.BeforeExperiment;
+import com.google.caliper.Param;
+import java.nio.charset.StandardCharsets;
+import java.security.MessageDigest;
+import sun.security.util.ManifestDigester;
+
+/**
+ * Indexes a manifest with one section per JAR entry and digests every
+ * section, as JarVerifier does when verifying a signed JAR.
+ */
+public class ManifestDigesterBenchmark {
+    @Param({"100", "10000", "100000"})
+    private int entryCount;
+
+    private byte[] manifest;
+    private String[] names;
+    private MessageDigest digest;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        StringBuilder sb = new StringBuilder("Manifest-Version: 1.0\r\n\r\n");
+        names = new String[entryCount];
+        for (int i = 0; i < entryCount; i++) {
+            names[i] = "com/example/package" + (i % 100) + "/Class" + i + ".class";
+            sb.append("Name: ").append(names[i]).append("\r\n")
+                    .append("SHA-256-Digest: 47DEQpj8HBSa+/TImW+5JCeuQeRkm5NMpJWZG3hSuFU=\r\n")
+                    .append("\r\n");
+        }
+        manifest = sb.toString().getBytes(StandardCharsets.UTF_8);
+        digest = MessageDigest.getInstance("SHA-256");
+    }
+
+    public void timeIndex(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            new ManifestDigester(manifest);
+        }
+    }
+
+    public void timeIndexAndDigestAll(int reps) {
+        for (int i = 0; i < reps; ++i) {
+            ManifestDigester md = new ManifestDigester(manifest);
+            for (String name : names) {
+                md.get(name, false).digest(digest);
+            }
+        }
+    }
+}
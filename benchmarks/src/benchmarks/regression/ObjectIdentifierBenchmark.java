@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import com.google.caliper.BeforeExperiment;
+import java.util.HashMap;
+import java.util.Map;
+import sun.security.util.DerInputStream;
+import sun.security.util.DerOutputStream;
+import sun.security.util.ObjectIdentifier;
+import sun.security.x509.AlgorithmId;
+
+public class ObjectIdentifierBenchmark {
+    private byte[] encoded;
+    private Map<ObjectIdentifier, String> map;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        // sha256WithRSAEncryption, as found in most certificates.
+        DerOutputStream out = new DerOutputStream();
+        out.putOID(AlgorithmId.sha256WithRSAEncryption_oid);
+        encoded = out.toByteArray();
+        map = new HashMap<>();
+        map.put(AlgorithmId.sha256WithRSAEncryption_oid, "SHA256withRSA");
+    }
+
+    public void timeDecode(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            new DerInputStream(encoded).getOID();
+        }
+    }
+
+    public void timeDecodeAndLookup(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            map.get(new DerInputStream(encoded).getOID());
+        }
+    }
+
+    public void timeDecodeAndToString(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            new DerInputStream(encoded).getOID().toString();
+        }
+    }
+
+    public void timeOfString(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            ObjectIdentifier.of("1.2.840.113549.1.1.11");
+        }
+    }
+}
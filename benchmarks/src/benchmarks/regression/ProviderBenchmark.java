@@ -16,8 +16,10 @@
 
 package benchmarks.regression;
 
+import java.security.MessageDigest;
 import java.security.Provider;
 import java.security.Security;
+import java.security.Signature;
 import javax.crypto.Cipher;
 
 public class ProviderBenchmark {
@@ -27,6 +29,19 @@ public class ProviderBenchmark {
         }
     }
 
+    // Looked up by an alias, in a different case from its registration.
+    public void timeMessageDigestByAlias(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            MessageDigest.getInstance("sha-256");
+        }
+    }
+
+    public void timeSignatureGetInstance(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            Signature.getInstance("SHA256withECDSA");
+        }
+    }
+
     public void timeWithNewProvider(int reps) throws Exception {
         for (int i = 0; i < reps; ++i) {
             Security.addProvider(new MockProvider());
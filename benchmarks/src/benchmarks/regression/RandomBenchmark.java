@@ -18,6 +18,7 @@ package benchmarks.regression;
 
 import java.security.SecureRandom;
 import java.util.Random;
+import java.util.UUID;
 
 public class RandomBenchmark {
     public void timeNewRandom(int reps) throws Exception {
@@ -47,4 +48,43 @@ public class RandomBenchmark {
             rng.nextInt();
         }
     }
+
+    public void timeRandomUUID(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            UUID.randomUUID();
+        }
+    }
+
+    public void timeRandomUUIDs_bulk(int reps) throws Exception {
+        // 100 per call, so compare against timeRandomUUID * 100.
+        for (int i = 0; i < reps; ++i) {
+            UUID.randomUUIDs(100);
+        }
+    }
+
+    public void timeRandomUUID_4Threads(int reps) throws Exception {
+        randomUUIDOnThreads(4, reps);
+    }
+
+    public void timeRandomUUID_16Threads(int reps) throws Exception {
+        randomUUIDOnThreads(16, reps);
+    }
+
+    // Each thread generates reps UUIDs, so the time per rep reflects how
+    // well generation scales rather than the cost of a single UUID.
+    private static void randomUUIDOnThreads(int threadCount, final int reps)
+            throws InterruptedException {
+        Thread[] threads = new Thread[threadCount];
+        for (int t = 0; t < threadCount; t++) {
+            threads[t] = new Thread(() -> {
+                for (int i = 0; i < reps; ++i) {
+                    UUID.randomUUID();
+                }
+            });
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+    }
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import com.google.caliper.AfterExperiment;
+import com.google.caliper.BeforeExperiment;
+import com.google.caliper.Param;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledFuture;
+import java.util.concurrent.ScheduledThreadPoolExecutor;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Compares the heap and timing wheel work queues of ScheduledThreadPoolExecutor
+ * on timeouts: tasks scheduled far enough ahead that they are cancelled before
+ * they run. Each thread does reps schedule and cancel pairs while the queue
+ * holds pendingCount other timeouts.
+ */
+public class ScheduledThreadPoolExecutorBenchmark {
+    private static final Runnable NOOP = new Runnable() {
+        @Override
+        public void run() {}
+    };
+
+    @Param({"HEAP", "WHEEL"})
+    private String queue;
+
+    @Param({"1", "4", "16"})
+    private int threadCount;
+
+    @Param({"0", "100000"})
+    private int pendingCount;
+
+    private ScheduledThreadPoolExecutor executor;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        if (queue.equals("WHEEL")) {
+            executor = new ScheduledThreadPoolExecutor(1, Executors.defaultThreadFactory(),
+                    new ThreadPoolExecutor.AbortPolicy(), 1, TimeUnit.MILLISECONDS);
+        } else {
+            executor = new ScheduledThreadPoolExecutor(1);
+        }
+        executor.setRemoveOnCancelPolicy(true);
+        for (int i = 0; i < pendingCount; i++) {
+            executor.schedule(NOOP, 60 + (i % 600), TimeUnit.SECONDS);
+        }
+    }
+
+    @AfterExperiment
+    protected void tearDown() throws Exception {
+        executor.shutdownNow();
+    }
+
+    public void timeScheduleAndCancel(final int reps) throws Exception {
+        Thread[] threads = new Thread[threadCount];
+        for (int t = 0; t < threadCount; t++) {
+            threads[t] = new Thread(() -> {
+                for (int i = 0; i < reps; ++i) {
+                    ScheduledFuture<?> timeout =
+                            executor.schedule(NOOP, 30 + (i & 1023), TimeUnit.SECONDS);
+                    timeout.cancel(false);
+                }
+            });
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+    }
+}
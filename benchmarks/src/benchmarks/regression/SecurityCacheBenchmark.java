@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import com.google.caliper.BeforeExperiment;
+import com.google.caliper.Param;
+import sun.security.util.Cache;
+
+/**
+ * Reads and writes a sun.security.util.Cache, as X509Factory does for each
+ * certificate it parses. Each thread does reps operations, so the time per
+ * rep reflects how well the cache scales with the number of threads.
+ */
+public class SecurityCacheBenchmark {
+    private static final int KEY_COUNT = 1024;
+
+    @Param({"1", "4", "16"})
+    private int threadCount;
+
+    @Param({"true", "false"})
+    private boolean soft;
+
+    private Object[] keys;
+    private Cache<Object, Object> cache;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        keys = new Object[KEY_COUNT];
+        // Same size as X509Factory's caches.
+        cache = soft ? Cache.newSoftMemoryCache(750) : Cache.newHardMemoryCache(750);
+        for (int i = 0; i < KEY_COUNT; i++) {
+            keys[i] = new Cache.EqualByteArray(new byte[] { (byte) i, (byte) (i >> 8) });
+            cache.put(keys[i], keys[i]);
+        }
+    }
+
+    public void timeGet(int reps) throws Exception {
+        onThreads(reps, false);
+    }
+
+    public void timeGetOrPut(int reps) throws Exception {
+        onThreads(reps, true);
+    }
+
+    private void onThreads(final int reps, final boolean putOnMiss) throws Exception {
+        Thread[] threads = new Thread[threadCount];
+        for (int t = 0; t < threadCount; t++) {
+            final int seed = t;
+            threads[t] = new Thread(() -> {
+                for (int i = 0; i < reps; ++i) {
+                    Object key = keys[(i * 31 + seed) & (KEY_COUNT - 1)];
+                    if (cache.get(key) == null && putOnMiss) {
+                        cache.put(key, key);
+                    }
+                }
+            });
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+    }
+}
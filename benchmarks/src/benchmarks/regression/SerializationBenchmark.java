@@ -23,6 +23,7 @@ import java.io.ObjectOutputStream;
 import java.io.ObjectStreamClass;
 import java.io.Serializable;
 import java.util.ArrayList;
+import java.util.Arrays;
 
 public class SerializationBenchmark {
     private static byte[] bytes(Object o) throws Exception {
@@ -38,6 +39,26 @@ public class SerializationBenchmark {
         readSingleObject(reps, intArray);
     }
 
+    public void timeReadLargeIntArray(int reps) throws Exception {
+        readSingleObject(reps, new int[65536]);
+    }
+
+    public void timeReadLargeLongArray(int reps) throws Exception {
+        readSingleObject(reps, new long[32768]);
+    }
+
+    public void timeReadLongAsciiString(int reps) throws Exception {
+        char[] chars = new char[16384];
+        Arrays.fill(chars, 'x');
+        readSingleObject(reps, new String(chars));
+    }
+
+    public void timeReadLongNonAsciiString(int reps) throws Exception {
+        char[] chars = new char[16384];
+        Arrays.fill(chars, '\u00e9');
+        readSingleObject(reps, new String(chars));
+    }
+
     public void timeWriteIntArray(int reps) throws Exception {
         int[] intArray = new int[256];
         writeSingleObject(reps, intArray);
@@ -81,6 +102,25 @@ public class SerializationBenchmark {
         writeSingleObject(reps, osc);
     }
 
+    public void timeLookup(int reps) {
+        for (int rep = 0; rep < reps; ++rep) {
+            ObjectStreamClass.lookup(SerializableInt.class);
+        }
+    }
+
+    public void timeLookupSeveralClasses(int reps) {
+        // Alternates between classes, as when writing an object graph.
+        Class<?>[] classes = {
+            SerializableBoolean.class, SerializableByte.class, SerializableChar.class,
+            SerializableDouble.class, SerializableFloat.class, SerializableInt.class,
+            SerializableLong.class, SerializableShort.class, SerializableReference.class,
+            LittleBitOfEverything.class,
+        };
+        for (int rep = 0; rep < reps; ++rep) {
+            ObjectStreamClass.lookup(classes[rep % classes.length]);
+        }
+    }
+
     // This is a baseline for the others.
     public void timeWriteNoObjects(int reps) throws Exception {
         ByteArrayOutputStream baos = new ByteArrayOutputStream(1024);
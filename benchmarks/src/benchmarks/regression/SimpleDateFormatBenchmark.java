@@ -36,6 +36,27 @@ public class SimpleDateFormatBenchmark {
         }
     }
 
+    public void time_createFormatWithLocale(int reps) {
+        for (int i = 0; i < reps; i++) {
+            new SimpleDateFormat("yyyy-MM-dd'T'HH:mm:ss.SSS", Locale.US);
+        }
+    }
+
+    public void time_createAndFormatNumericFields(int reps) {
+        Date date = new Date();
+        for (int i = 0; i < reps; i++) {
+            new SimpleDateFormat("yyyy-MM-dd'T'HH:mm:ss.SSS", Locale.US).format(date);
+        }
+    }
+
+    public void time_formatNumericFields(int reps) {
+        SimpleDateFormat sdf = new SimpleDateFormat("yyyy-MM-dd'T'HH:mm:ss.SSS", Locale.US);
+        Date date = new Date();
+        for (int i = 0; i < reps; i++) {
+            sdf.format(date);
+        }
+    }
+
     public void time_parseWithTimeZoneShort(int reps) throws ParseException {
         SimpleDateFormat sdf = new SimpleDateFormat("yyyy.MM.dd z");
         for (int i = 0; i < reps; i++) {
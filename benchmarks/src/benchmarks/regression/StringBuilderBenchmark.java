@@ -17,6 +17,8 @@
 package benchmarks.regression;
 
 import com.google.caliper.Param;
+import java.nio.CharBuffer;
+import java.util.Arrays;
 
 /**
  * Tests the performance of various StringBuilder methods.
@@ -25,6 +27,13 @@ public class StringBuilderBenchmark {
 
     @Param({"1", "10", "100"}) private int length;
 
+    private static final String LONG_STRING;
+    static {
+        char[] chars = new char[1000];
+        Arrays.fill(chars, 'x');
+        LONG_STRING = new String(chars);
+    }
+
     public void timeAppendBoolean(int reps) {
         for (int i = 0; i < reps; ++i) {
             StringBuilder sb = new StringBuilder();
@@ -68,7 +77,37 @@ public class StringBuilderBenchmark {
         for (int i = 0; i < reps; ++i) {
             StringBuilder sb = new StringBuilder();
             for (int j = 0; j < length; ++j) {
-                sb.append(cs);
+                sb.append(cs, 1, 4);
+            }
+        }
+    }
+
+    public void timeAppendSubStringBuilder(int reps) {
+        CharSequence cs = new StringBuilder("chars");
+        for (int i = 0; i < reps; ++i) {
+            StringBuilder sb = new StringBuilder();
+            for (int j = 0; j < length; ++j) {
+                sb.append(cs, 1, 4);
+            }
+        }
+    }
+
+    public void timeAppendSubCharBuffer(int reps) {
+        CharSequence cs = CharBuffer.wrap("chars");
+        for (int i = 0; i < reps; ++i) {
+            StringBuilder sb = new StringBuilder();
+            for (int j = 0; j < length; ++j) {
+                sb.append(cs, 1, 4);
+            }
+        }
+    }
+
+    public void timeAppendLongSubString(int reps) {
+        CharSequence cs = LONG_STRING;
+        for (int i = 0; i < reps; ++i) {
+            StringBuilder sb = new StringBuilder();
+            for (int j = 0; j < length; ++j) {
+                sb.append(cs, 1, cs.length() - 1);
             }
         }
     }
@@ -83,6 +122,16 @@ public class StringBuilderBenchmark {
         }
     }
 
+    public void timeAppendIntegralDouble(int reps) {
+        double d = 1234.0;
+        for (int i = 0; i < reps; ++i) {
+            StringBuilder sb = new StringBuilder();
+            for (int j = 0; j < length; ++j) {
+                sb.append(d);
+            }
+        }
+    }
+
     public void timeAppendFloat(int reps) {
         float f = 1.2f;
         for (int i = 0; i < reps; ++i) {
@@ -103,6 +152,16 @@ public class StringBuilderBenchmark {
         }
     }
 
+    public void timeAppendLargeInt(int reps) {
+        int n = -1234567890;
+        for (int i = 0; i < reps; ++i) {
+            StringBuilder sb = new StringBuilder();
+            for (int j = 0; j < length; ++j) {
+                sb.append(n);
+            }
+        }
+    }
+
     public void timeAppendLong(int reps) {
         long l = 123;
         for (int i = 0; i < reps; ++i) {
@@ -128,6 +187,16 @@ public class StringBuilderBenchmark {
         }
     }
 
+    public void timeAppendLongString(int reps) {
+        // Mostly measures growth of the backing array.
+        for (int i = 0; i < reps; ++i) {
+            StringBuilder sb = new StringBuilder();
+            for (int j = 0; j < length; ++j) {
+                sb.append(LONG_STRING);
+            }
+        }
+    }
+
     public void timeAppendString(int reps) {
         String s = "chars";
         for (int i = 0; i < reps; ++i) {
@@ -16,16 +16,55 @@
 
 package benchmarks.regression;
 
+import com.google.caliper.BeforeExperiment;
+import com.google.caliper.Param;
+
 public class ThreadLocalBenchmark {
-    private static final ThreadLocal<char[]> BUFFER = new ThreadLocal<char[]>() {
-        @Override protected char[] initialValue() {
-            return new char[20];
+    private static final int LOCAL_COUNT = 32;
+
+    @Param({"HASHED", "INDEXED"})
+    private String mode;
+
+    private ThreadLocal<char[]> buffer;
+    private ThreadLocal<?>[] locals;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        buffer = newLocal();
+        locals = new ThreadLocal<?>[LOCAL_COUNT];
+        for (int i = 0; i < LOCAL_COUNT; i++) {
+            locals[i] = newLocal();
+            locals[i].get();
         }
-    };
+    }
+
+    private ThreadLocal<char[]> newLocal() {
+        return new ThreadLocal<char[]>(mode.equals("INDEXED")) {
+            @Override protected char[] initialValue() {
+                return new char[20];
+            }
+        };
+    }
 
     public void timeThreadLocal_get(int reps) {
         for (int rep = 0; rep < reps; ++rep) {
-            BUFFER.get();
+            buffer.get();
+        }
+    }
+
+    // Libraries that keep many thread locals per thread.
+    public void timeThreadLocal_getMany(int reps) {
+        for (int rep = 0; rep < reps; ++rep) {
+            locals[rep & (LOCAL_COUNT - 1)].get();
+        }
+    }
+
+    // Short-lived thread locals, which leave stale entries to be cleaned up.
+    public void timeThreadLocal_churn(int reps) {
+        for (int rep = 0; rep < reps; ++rep) {
+            ThreadLocal<char[]> local = newLocal();
+            local.get();
+            local.remove();
         }
     }
 }
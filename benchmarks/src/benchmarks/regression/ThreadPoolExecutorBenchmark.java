@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import com.google.caliper.AfterExperiment;
+import com.google.caliper.BeforeExperiment;
+import com.google.caliper.Param;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Measures ThreadPoolExecutor throughput for many small tasks: submitted one
+ * at a time, submitted in batches with executeAll, and spawned by the tasks
+ * themselves, with and without local queues. Times are per task.
+ */
+public class ThreadPoolExecutorBenchmark {
+    private static final int BATCH_SIZE = 1000;
+
+    @Param({"1", "4", "16"})
+    private int workerCount;
+
+    @Param({"false", "true"})
+    private boolean localQueues;
+
+    private ThreadPoolExecutor executor;
+    private CountDownLatch done;
+    private final Runnable countDown = new Runnable() {
+        @Override
+        public void run() {
+            done.countDown();
+        }
+    };
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        executor = new ThreadPoolExecutor(workerCount, workerCount, 0, TimeUnit.MILLISECONDS,
+                new LinkedBlockingQueue<Runnable>());
+        executor.allowLocalQueues(localQueues);
+        executor.prestartAllCoreThreads();
+    }
+
+    @AfterExperiment
+    protected void tearDown() throws Exception {
+        executor.shutdown();
+        executor.awaitTermination(10, TimeUnit.SECONDS);
+    }
+
+    public void timeExecute(int reps) throws Exception {
+        done = new CountDownLatch(reps);
+        for (int i = 0; i < reps; ++i) {
+            executor.execute(countDown);
+        }
+        done.await();
+    }
+
+    public void timeExecuteAll(int reps) throws Exception {
+        done = new CountDownLatch(reps);
+        List<Runnable> batch = new ArrayList<>(BATCH_SIZE);
+        for (int i = 0; i < reps; ++i) {
+            batch.add(countDown);
+            if (batch.size() == BATCH_SIZE || i == reps - 1) {
+                executor.executeAll(batch);
+                batch.clear();
+            }
+        }
+        done.await();
+    }
+
+    // Each task spawns up to two more, as divide-and-conquer code does.
+    public void timeSpawn(int reps) throws Exception {
+        done = new CountDownLatch(reps);
+        executor.execute(new SplitTask(reps));
+        done.await();
+    }
+
+    /** Counts down once, then splits the rest of its size between two children. */
+    private final class SplitTask implements Runnable {
+        private final int size;
+
+        SplitTask(int size) {
+            this.size = size;
+        }
+
+        @Override
+        public void run() {
+            int rest = size - 1;
+            if (rest > 1) {
+                executor.execute(new SplitTask(rest / 2));
+            }
+            if (rest > 0) {
+                executor.execute(new SplitTask(rest - rest / 2));
+            }
+            done.countDown();
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package benchmarks.regression;
+
+import com.google.caliper.BeforeExperiment;
+import java.io.File;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.util.ArrayList;
+import java.util.Base64;
+import java.util.List;
+import sun.security.x509.X509CertImpl;
+
+/**
+ * Parses every certificate in the system trust store with X509CertImpl.
+ * Times are per trust store, not per certificate.
+ */
+public class X509CertImplBenchmark {
+    private static final String CA_CERTS_DIR = "/system/etc/security/cacerts";
+    private static final String BEGIN = "-----BEGIN CERTIFICATE-----";
+    private static final String END = "-----END CERTIFICATE-----";
+
+    private byte[][] encodings;
+
+    @BeforeExperiment
+    protected void setUp() throws Exception {
+        List<byte[]> certs = new ArrayList<>();
+        File[] files = new File(CA_CERTS_DIR).listFiles();
+        if (files == null) {
+            throw new IllegalStateException("No certificates in " + CA_CERTS_DIR);
+        }
+        for (File file : files) {
+            String pem = new String(Files.readAllBytes(file.toPath()), StandardCharsets.US_ASCII);
+            int begin = pem.indexOf(BEGIN);
+            int end = pem.indexOf(END);
+            if (begin >= 0 && end > begin) {
+                String base64 = pem.substring(begin + BEGIN.length(), end);
+                certs.add(Base64.getMimeDecoder().decode(base64));
+            }
+        }
+        encodings = certs.toArray(new byte[certs.size()][]);
+    }
+
+    public void timeParse(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            for (byte[] encoding : encodings) {
+                new X509CertImpl(encoding);
+            }
+        }
+    }
+
+    // The fields a trust manager needs to find an issuer.
+    public void timeParseAndGetSubjectValidityKey(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            for (byte[] encoding : encodings) {
+                X509CertImpl cert = new X509CertImpl(encoding);
+                cert.getSubjectX500Principal();
+                cert.getNotAfter();
+                cert.getPublicKey();
+            }
+        }
+    }
+
+    public void timeParseAndGetExtensions(int reps) throws Exception {
+        for (int i = 0; i < reps; ++i) {
+            for (byte[] encoding : encodings) {
+                X509CertImpl cert = new X509CertImpl(encoding);
+                cert.getBasicConstraints();
+                cert.getKeyUsage();
+                cert.getSubjectAlternativeNames();
+            }
+        }
+    }
+}
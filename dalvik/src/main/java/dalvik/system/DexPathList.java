@@ -18,6 +18,7 @@ package dalvik.system;
 
 import android.system.ErrnoException;
 import android.system.StructStat;
+import android.system.StructTimespec;
 import dalvik.annotation.compat.UnsupportedAppUsage;
 import java.io.File;
 import java.io.IOException;
@@ -29,8 +30,11 @@ import java.util.Arrays;
 import java.util.Collection;
 import java.util.Collections;
 import java.util.Enumeration;
+import java.util.HashMap;
 import java.util.List;
+import java.util.Map;
 import java.util.Objects;
+import java.util.zip.ZipEntry;
 import libcore.io.ClassPathURLStreamHandler;
 import libcore.io.IoUtils;
 import libcore.io.Libcore;
@@ -87,6 +91,12 @@ public final class DexPathList {
     @UnsupportedAppUsage
     private IOException[] dexElementsSuppressedExceptions;
 
+    /**
+     * Index of the libraries in {@link #nativeLibraryPathElements}, built on first use. Null if
+     * it has not been built yet or was invalidated by {@link #addNativePath}.
+     */
+    private volatile NativeLibraryIndex nativeLibraryIndex;
+
     private List<File> getAllNativeLibraryDirectories() {
         List<File> allNativeLibraryDirectories = new ArrayList<>(nativeLibraryDirectories);
         allNativeLibraryDirectories.addAll(systemNativeLibraryDirectories);
@@ -596,15 +606,26 @@ public final class DexPathList {
     public String findLibrary(String libraryName) {
         String fileName = System.mapLibraryName(libraryName);
 
-        for (NativeLibraryElement element : nativeLibraryPathElements) {
-            String path = element.findNativeLibrary(fileName);
-
-            if (path != null) {
-                return path;
-            }
+        NativeLibraryIndex index = getNativeLibraryIndex();
+        String path = index.findNativeLibrary(fileName);
+        if (path == null && index.isStale()) {
+            // A library directory changed since it was listed. Look again with a fresh index.
+            nativeLibraryIndex = null;
+            path = getNativeLibraryIndex().findNativeLibrary(fileName);
         }
+        return path;
+    }
 
-        return null;
+    private NativeLibraryIndex getNativeLibraryIndex() {
+        // Apps are known to replace nativeLibraryPathElements by reflection, so check that the
+        // index matches the current array rather than relying on addNativePath() alone.
+        NativeLibraryElement[] elements = nativeLibraryPathElements;
+        NativeLibraryIndex index = nativeLibraryIndex;
+        if (index == null || index.elements != elements) {
+            index = new NativeLibraryIndex(elements);
+            nativeLibraryIndex = index;
+        }
+        return index;
     }
 
     /**
@@ -650,6 +671,7 @@ public final class DexPathList {
             }
         }
         nativeLibraryPathElements = newPaths.toArray(new NativeLibraryElement[newPaths.size()]);
+        nativeLibraryIndex = null;
     }
 
     /**
@@ -916,4 +938,138 @@ public final class DexPathList {
             return Objects.hash(path, zipDir);
         }
     }
+
+    /**
+     * Appends {@code position[0]} to the positions recorded for {@code name}. Positions must be
+     * added in ascending order. The single-element {@code position} array is shared between
+     * all the names that are only found in one element.
+     */
+    private static void addPosition(Map<String, int[]> positionsByName, String name,
+            int[] position) {
+        int[] existing = positionsByName.putIfAbsent(name, position);
+        if (existing != null && existing[existing.length - 1] != position[0]) {
+            int[] merged = Arrays.copyOf(existing, existing.length + 1);
+            merged[existing.length] = position[0];
+            positionsByName.put(name, merged);
+        }
+    }
+
+    /**
+     * Maps library file names to the native library elements that may contain them.
+     *
+     * <p>Directories are indexed by listing them. Because a directory may gain files after it
+     * was listed, the modification times of the directories are recorded so that a miss can be
+     * double-checked with {@link #isStale}. Directories that can be searched but not listed
+     * (for example because of their mode or SELinux policy) are always probed.
+     */
+    private static final class NativeLibraryIndex {
+        private static final int[] NO_POSITIONS = new int[0];
+
+        /** The array this index was built from. */
+        final NativeLibraryElement[] elements;
+
+        /** Positions of the elements containing each file name, in ascending order. */
+        private final Map<String, int[]> positionsByName = new HashMap<>();
+
+        /** Positions of the elements that must always be probed, in ascending order. */
+        private final int[] unindexedPositions;
+
+        private final File[] directories;
+        private final StructTimespec[] directoryModificationTimes;
+
+        NativeLibraryIndex(NativeLibraryElement[] elements) {
+            this.elements = elements;
+            List<File> listedDirectories = new ArrayList<>();
+            int[] unindexed = new int[elements.length];
+            int unindexedCount = 0;
+            for (int i = 0; i < elements.length; i++) {
+                NativeLibraryElement element = elements[i];
+                int[] position = { i };
+                if (element.zipDir == null) {
+                    String[] names = element.path.list();
+                    if (names == null) {
+                        // Missing, or not listable. A library may still be opened by name.
+                        unindexed[unindexedCount++] = i;
+                        continue;
+                    }
+                    listedDirectories.add(element.path);
+                    for (String name : names) {
+                        addPosition(positionsByName, name, position);
+                    }
+                    continue;
+                }
+                element.maybeInit();
+                if (element.urlHandler != null) {
+                    String prefix = element.zipDir + '/';
+                    Enumeration<? extends ZipEntry> entries = element.urlHandler.entries();
+                    while (entries.hasMoreElements()) {
+                        String entryName = entries.nextElement().getName();
+                        if (entryName.startsWith(prefix)
+                                && entryName.indexOf('/', prefix.length()) == -1) {
+                            addPosition(positionsByName,
+                                    entryName.substring(prefix.length()), position);
+                        }
+                    }
+                }
+            }
+            unindexedPositions = Arrays.copyOf(unindexed, unindexedCount);
+            directories = listedDirectories.toArray(new File[listedDirectories.size()]);
+            directoryModificationTimes = new StructTimespec[directories.length];
+            for (int i = 0; i < directories.length; i++) {
+                directoryModificationTimes[i] = modificationTime(directories[i]);
+            }
+        }
+
+        /**
+         * Returns the modification time of {@code directory} with full precision, or null if
+         * it can't be determined. {@link File#lastModified} only has a resolution of seconds.
+         */
+        private static StructTimespec modificationTime(File directory) {
+            try {
+                return Libcore.os.stat(directory.getPath()).st_mtim;
+            } catch (ErrnoException e) {
+                return null;
+            }
+        }
+
+        /**
+         * Returns the path of the first readable library named {@code fileName}, or null.
+         * Candidates from the index are confirmed with
+         * {@link NativeLibraryElement#findNativeLibrary}, so a hit is never stale.
+         */
+        String findNativeLibrary(String fileName) {
+            int[] indexed = positionsByName.get(fileName);
+            if (indexed == null) {
+                indexed = NO_POSITIONS;
+            }
+            // Probe the indexed and unindexed candidates in path order.
+            int i = 0;
+            int j = 0;
+            while (i < indexed.length || j < unindexedPositions.length) {
+                int position;
+                if (j == unindexedPositions.length
+                        || (i < indexed.length && indexed[i] < unindexedPositions[j])) {
+                    position = indexed[i++];
+                } else {
+                    position = unindexedPositions[j++];
+                }
+                String path = elements[position].findNativeLibrary(fileName);
+                if (path != null) {
+                    return path;
+                }
+            }
+            return null;
+        }
+
+        /** Returns true if any indexed directory was modified since it was listed. */
+        boolean isStale() {
+            for (int i = 0; i < directories.length; i++) {
+                if (!Objects.equals(modificationTime(directories[i]),
+                        directoryModificationTimes[i])) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
 }
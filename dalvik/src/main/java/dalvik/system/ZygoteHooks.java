@@ -21,6 +21,7 @@ import android.icu.text.DecimalFormatSymbols;
 import android.icu.util.ULocale;
 
 import java.io.File;
+import java.util.UUID;
 
 /**
  * Provides hooks for the zygote to call back into the runtime to perform
@@ -127,6 +128,7 @@ public final class ZygoteHooks {
         nativePostForkChild(token, runtimeFlags, isSystemServer, isZygote, instructionSet);
 
         Math.setRandomSeedInternal(System.currentTimeMillis());
+        UUID.discardBufferedRandomBytesInternal();
     }
 
     /**
@@ -36,7 +36,13 @@ public final class ICU {
 
   @UnsupportedAppUsage
   private static final BasicLruCache<String, String> CACHED_PATTERNS =
-      new BasicLruCache<String, String>(8);
+      new BasicLruCache<String, String>(32);
+
+  /**
+   * Incremented when CACHED_PATTERNS is cleared, so that patterns computed before then are not
+   * cached afterwards. Guarded by CACHED_PATTERNS.
+   */
+  private static int cachedPatternsGeneration;
 
   private static Locale[] availableLocalesCache;
 
@@ -299,14 +305,25 @@ public final class ICU {
   public static String getBestDateTimePattern(String skeleton, Locale locale) {
     String languageTag = locale.toLanguageTag();
     String key = skeleton + "\t" + languageTag;
+    String pattern;
+    int generation;
     synchronized (CACHED_PATTERNS) {
-      String pattern = CACHED_PATTERNS.get(key);
-      if (pattern == null) {
-        pattern = getBestDateTimePatternNative(skeleton, languageTag);
-        CACHED_PATTERNS.put(key, pattern);
+      pattern = CACHED_PATTERNS.get(key);
+      generation = cachedPatternsGeneration;
+    }
+    if (pattern == null) {
+      // Don't hold the lock while calling into ICU: a cache miss in one thread
+      // shouldn't stall lookups of cached patterns in others.
+      pattern = getBestDateTimePatternNative(skeleton, languageTag);
+      if (pattern != null) {
+        synchronized (CACHED_PATTERNS) {
+          if (generation == cachedPatternsGeneration) {
+            CACHED_PATTERNS.put(key, pattern);
+          }
+        }
       }
-      return pattern;
     }
+    return pattern;
   }
 
   @UnsupportedAppUsage
@@ -481,7 +498,16 @@ public final class ICU {
   /**
    * Takes a BCP-47 language tag (Locale.toLanguageTag()). e.g. en-US, not en_US
    */
-  public static native void setDefaultLocale(String languageTag);
+  public static void setDefaultLocale(String languageTag) {
+    setDefaultLocaleNative(languageTag);
+    // Patterns for locales ICU has no data for come from the default locale's data.
+    synchronized (CACHED_PATTERNS) {
+      CACHED_PATTERNS.evictAll();
+      cachedPatternsGeneration++;
+    }
+  }
+
+  private static native void setDefaultLocaleNative(String languageTag);
 
   /**
    * Returns a locale name, not a BCP-47 language tag. e.g. en_US not en-US.
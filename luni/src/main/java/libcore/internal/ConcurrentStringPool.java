@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.internal;
+
+import java.util.concurrent.atomic.AtomicReferenceArray;
+
+/**
+ * A bounded pool of string instances that may be shared between threads.
+ *
+ * <p>Like {@link StringPool}, this pool is intended only to save allocations
+ * and provides no guarantee of reference equality. Unlike {@link StringPool},
+ * colliding strings are chained within a bucket rather than evicting each
+ * other, so a working set of names that fits in the pool is retained. Each
+ * bucket holds at most {@code maxChainLength} strings; when a bucket is full
+ * the least recently inserted string is dropped.
+ *
+ * <p>Lookups never block. Buckets are immutable linked chains published with
+ * a compare-and-set, so a lookup that races with an insert may allocate a
+ * duplicate string but will always return a string with the requested
+ * content.
+ *
+ * @hide
+ */
+public final class ConcurrentStringPool {
+
+    private static final int DEFAULT_BUCKET_COUNT = 1024;
+    private static final int DEFAULT_MAX_CHAIN_LENGTH = 4;
+
+    private static final class Node {
+        final int hash;
+        final String value;
+        final Node next;
+
+        Node(int hash, String value, Node next) {
+            this.hash = hash;
+            this.value = value;
+            this.next = next;
+        }
+    }
+
+    private final AtomicReferenceArray<Node> buckets;
+    private final int mask;
+    private final int maxChainLength;
+
+    public ConcurrentStringPool() {
+        this(DEFAULT_BUCKET_COUNT, DEFAULT_MAX_CHAIN_LENGTH);
+    }
+
+    /**
+     * Creates a pool that retains at most {@code bucketCount * maxChainLength}
+     * strings.
+     *
+     * @param bucketCount the number of hash buckets. This is rounded up to a
+     *     power of two.
+     * @param maxChainLength the maximum number of strings held per bucket.
+     */
+    public ConcurrentStringPool(int bucketCount, int maxChainLength) {
+        if (bucketCount <= 0 || bucketCount > (1 << 30)) {
+            throw new IllegalArgumentException("bucketCount out of range: " + bucketCount);
+        }
+        if (maxChainLength <= 0) {
+            throw new IllegalArgumentException("maxChainLength <= 0: " + maxChainLength);
+        }
+        int size = Integer.highestOneBit(bucketCount);
+        if (size < bucketCount) {
+            size <<= 1;
+        }
+        this.buckets = new AtomicReferenceArray<>(size);
+        this.mask = size - 1;
+        this.maxChainLength = maxChainLength;
+    }
+
+    private static boolean contentEquals(String s, char[] chars, int start, int length) {
+        if (s.length() != length) {
+            return false;
+        }
+        for (int i = 0; i < length; i++) {
+            if (chars[start + i] != s.charAt(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Returns a string equal to {@code new String(array, start, length)}.
+     */
+    public String get(char[] array, int start, int length) {
+        // Same hash as String.hashCode() so that a pooled string's cached
+        // hash agrees with the bucket it lives in.
+        int hash = 0;
+        for (int i = start; i < start + length; i++) {
+            hash = (hash * 31) + array[i];
+        }
+
+        // Doug Lea's supplemental secondaryHash function (from HashMap)
+        int spread = hash ^ (hash >>> 20) ^ (hash >>> 12);
+        spread ^= (spread >>> 7) ^ (spread >>> 4);
+        int index = spread & mask;
+
+        Node head = buckets.get(index);
+        for (Node node = head; node != null; node = node.next) {
+            if (node.hash == hash && contentEquals(node.value, array, start, length)) {
+                return node.value;
+            }
+        }
+
+        String result = new String(array, start, length);
+        // Publish the new string at the head of the chain. If another thread
+        // changed the bucket concurrently we simply retry against its chain;
+        // giving up after a lost race would be equally correct.
+        while (true) {
+            Node newHead = new Node(hash, result, truncate(head, maxChainLength - 1));
+            if (buckets.compareAndSet(index, head, newHead)) {
+                return result;
+            }
+            head = buckets.get(index);
+            for (Node node = head; node != null; node = node.next) {
+                if (node.hash == hash && contentEquals(node.value, array, start, length)) {
+                    return node.value;
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns a chain holding the first {@code limit} nodes of {@code head},
+     * sharing the original nodes when no truncation is necessary.
+     */
+    private static Node truncate(Node head, int limit) {
+        int length = 0;
+        for (Node node = head; node != null; node = node.next) {
+            if (++length > limit) {
+                return copyPrefix(head, limit);
+            }
+        }
+        return head;
+    }
+
+    private static Node copyPrefix(Node node, int count) {
+        if (count == 0 || node == null) {
+            return null;
+        }
+        return new Node(node.hash, node.value, copyPrefix(node.next, count - 1));
+    }
+}
@@ -26,6 +26,7 @@ import java.net.MalformedURLException;
 import java.net.URL;
 import java.net.URLConnection;
 import java.net.URLStreamHandler;
+import java.util.Enumeration;
 import java.util.jar.JarFile;
 import java.util.zip.ZipEntry;
 import sun.net.www.ParseUtil;
@@ -78,6 +79,14 @@ public class ClassPathURLStreamHandler extends Handler {
     return entry != null && entry.getMethod() == ZipEntry.STORED;
   }
 
+  /**
+   * Returns the entries of the underlying jar file. This is intended for callers that index the
+   * contents of the jar up front rather than probing it for each name.
+   */
+  public Enumeration<? extends ZipEntry> entries() {
+    return jarFile.entries();
+  }
+
   @Override
   protected URLConnection openConnection(URL url) throws IOException {
     return new ClassPathURLConnection(url);
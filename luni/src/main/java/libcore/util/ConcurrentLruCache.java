@@ -0,0 +1,372 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.util;
+
+import java.util.ArrayDeque;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * A bounded cache for libcore that may be read concurrently without locking.
+ * It has the same API as {@link BasicLruCache}, which it can replace where
+ * reads are contended.
+ *
+ * <p>Eviction uses the CLOCK approximation of least-recently-used: a read
+ * only marks an entry as referenced, and when the cache is over its size a
+ * referenced entry is given a second chance before it is evicted. Entries
+ * that are never read after being added are evicted in insertion order, but
+ * an entry is never evicted to make room for itself unless it alone exceeds
+ * the maximum size.
+ *
+ * <p>Writes (puts, creation of missing values and evictions) are serialized
+ * by a lock on the cache. Concurrent {@link #get} calls that miss on the same
+ * key call {@link #create} only once; the other callers wait for its result.
+ *
+ * <p>By default every entry has a size of one, so {@code maxSize} is the
+ * maximum number of entries. Override {@link #sizeOf} to bound the cache by
+ * another measure.
+ *
+ * @hide
+ */
+public class ConcurrentLruCache<K, V> {
+
+    private static final class Node<K, V> {
+        final K key;
+        final V value;
+        final int size;
+        /** Set on reads; cleared when the clock hand passes over this node. */
+        volatile boolean referenced;
+        /** Whether this node has been replaced or evicted. Guarded by the cache. */
+        boolean removed;
+
+        Node(K key, V value, int size) {
+            this.key = key;
+            this.value = value;
+            this.size = size;
+        }
+    }
+
+    /** A value being created by {@link #create}, awaited by other readers of its key. */
+    private static final class Creation<V> {
+        private boolean done;
+        private V value;
+        private Throwable failure;
+
+        synchronized void complete(V value, Throwable failure) {
+            this.value = value;
+            this.failure = failure;
+            this.done = true;
+            notifyAll();
+        }
+
+        synchronized V await() {
+            boolean interrupted = false;
+            while (!done) {
+                try {
+                    wait();
+                } catch (InterruptedException e) {
+                    interrupted = true;
+                }
+            }
+            if (interrupted) {
+                Thread.currentThread().interrupt();
+            }
+            if (failure instanceof RuntimeException) {
+                throw (RuntimeException) failure;
+            } else if (failure instanceof Error) {
+                throw (Error) failure;
+            }
+            return value;
+        }
+    }
+
+    private final ConcurrentHashMap<K, Node<K, V>> map = new ConcurrentHashMap<>();
+    private final ConcurrentHashMap<K, Creation<V>> creations = new ConcurrentHashMap<>();
+    private final int maxSize;
+
+    /** Nodes in clock order, oldest first. May hold removed nodes. Guarded by this. */
+    private final ArrayDeque<Node<K, V>> clock = new ArrayDeque<>();
+    /** The number of removed nodes in {@link #clock}. Guarded by this. */
+    private int removedInClock;
+    /** The sum of the sizes of cached entries. Guarded by this. */
+    private int size;
+
+    /** Statistics counters, or null if statistics are not recorded. */
+    private final LongAdder hitCount;
+    private final LongAdder missCount;
+    private final LongAdder evictionCount;
+
+    public ConcurrentLruCache(int maxSize) {
+        this(maxSize, false);
+    }
+
+    /**
+     * @param maxSize the maximum sum of the sizes of cached entries.
+     * @param recordStats whether to count hits, misses and evictions. Counting
+     *     adds a small cost to every call to {@link #get}.
+     */
+    public ConcurrentLruCache(int maxSize, boolean recordStats) {
+        if (maxSize <= 0) {
+            throw new IllegalArgumentException("maxSize <= 0");
+        }
+        this.maxSize = maxSize;
+        if (recordStats) {
+            hitCount = new LongAdder();
+            missCount = new LongAdder();
+            evictionCount = new LongAdder();
+        } else {
+            hitCount = null;
+            missCount = null;
+            evictionCount = null;
+        }
+    }
+
+    /**
+     * Returns the value for {@code key} if it exists in the cache or can be
+     * created by {@code #create}. If a value was returned, it is marked as
+     * recently used. This returns null if a value is not cached and cannot be
+     * created.
+     */
+    public final V get(K key) {
+        if (key == null) {
+            throw new NullPointerException("key == null");
+        }
+
+        Node<K, V> node = map.get(key);
+        if (node != null) {
+            // Avoid writing to the node, and so invalidating it in other CPUs'
+            // caches, when it is already marked.
+            if (!node.referenced) {
+                node.referenced = true;
+            }
+            if (hitCount != null) {
+                hitCount.increment();
+            }
+            return node.value;
+        }
+        if (missCount != null) {
+            missCount.increment();
+        }
+
+        Creation<V> creation = creations.get(key);
+        if (creation == null) {
+            Creation<V> newCreation = new Creation<>();
+            creation = creations.putIfAbsent(key, newCreation);
+            if (creation == null) {
+                return createAndInsert(key, newCreation);
+            }
+        }
+        return creation.await();
+    }
+
+    private V createAndInsert(K key, Creation<V> creation) {
+        V result = null;
+        Throwable failure = null;
+        try {
+            // Don't hold any locks while calling create.
+            result = create(key);
+            if (result != null) {
+                synchronized (this) {
+                    // NOTE: Another thread might have put a value for |key| while
+                    // this one was being created. As with BasicLruCache, the
+                    // created value replaces it.
+                    insert(key, result);
+                    trimToSize(maxSize, true, clock.peekLast());
+                }
+            }
+            return result;
+        } catch (RuntimeException | Error e) {
+            failure = e;
+            throw e;
+        } finally {
+            creations.remove(key, creation);
+            creation.complete(result, failure);
+        }
+    }
+
+    /**
+     * Caches {@code value} for {@code key}. The value is moved to the head of
+     * the queue.
+     *
+     * @return the previous value mapped by {@code key}. Although that entry is
+     *     no longer cached, it has not been passed to {@link #entryEvicted}.
+     */
+    public synchronized final V put(K key, V value) {
+        if (key == null) {
+            throw new NullPointerException("key == null");
+        } else if (value == null) {
+            throw new NullPointerException("value == null");
+        }
+
+        V previous = insert(key, value);
+        trimToSize(maxSize, true, clock.peekLast());
+        return previous;
+    }
+
+    /** Adds an entry to the map and the clock. Must be called holding this. */
+    private V insert(K key, V value) {
+        int entrySize = sizeOf(key, value);
+        if (entrySize < 0) {
+            throw new IllegalStateException("Negative size: " + key + "=" + value);
+        }
+        Node<K, V> node = new Node<>(key, value, entrySize);
+        Node<K, V> previous = map.put(key, node);
+        clock.addLast(node);
+        size += entrySize;
+        if (previous == null) {
+            return null;
+        }
+        previous.removed = true;
+        size -= previous.size;
+        if (++removedInClock > clock.size() / 2) {
+            compactClock();
+        }
+        return previous.value;
+    }
+
+    /** Drops removed nodes from the clock. Must be called holding this. */
+    private void compactClock() {
+        int count = clock.size();
+        for (int i = 0; i < count; i++) {
+            Node<K, V> node = clock.pollFirst();
+            if (!node.removed) {
+                clock.addLast(node);
+            }
+        }
+        removedInClock = 0;
+    }
+
+    /**
+     * Evicts entries until the total size is at most {@code maxSize}. If
+     * {@code secondChance} is true, referenced entries are skipped once. The
+     * entry {@code newest}, if not null, is evicted only if it alone is too
+     * large. Must be called holding this.
+     */
+    private void trimToSize(int maxSize, boolean secondChance, Node<K, V> newest) {
+        while (size > maxSize) {
+            Node<K, V> node = clock.pollFirst();
+            if (node == null) {
+                break;
+            }
+            if (node.removed) {
+                removedInClock--;
+                continue;
+            }
+            if ((secondChance && node.referenced) || (node == newest && !clock.isEmpty())) {
+                node.referenced = false;
+                clock.addLast(node);
+                continue;
+            }
+            map.remove(node.key, node);
+            node.removed = true;
+            size -= node.size;
+            if (evictionCount != null) {
+                evictionCount.increment();
+            }
+            entryEvicted(node.key, node.value);
+        }
+    }
+
+    /**
+     * Called for entries that have been chosen for eviction and are removed.
+     * The default implementation does nothing. This is called while holding
+     * the cache's lock.
+     */
+    protected void entryEvicted(K key, V value) {}
+
+    /**
+     * Called after a cache miss to compute a value for the corresponding key.
+     * Returns the computed value or null if no value can be computed. The
+     * default implementation returns null.
+     *
+     * <p>Concurrent misses on the same key wait for a single call to this
+     * method, so it must not call {@link #get} with the same key.
+     */
+    protected V create(K key) {
+        return null;
+    }
+
+    /**
+     * Returns the size of the entry for {@code key} and {@code value}, which
+     * must not change while the entry is cached. The default implementation
+     * returns 1.
+     */
+    protected int sizeOf(K key, V value) {
+        return 1;
+    }
+
+    /**
+     * Returns the sum of the sizes of the cached entries.
+     */
+    public synchronized final int size() {
+        return size;
+    }
+
+    public final int maxSize() {
+        return maxSize;
+    }
+
+    /**
+     * Returns the number of calls to {@link #get} that returned a cached value,
+     * or 0 if statistics are not recorded.
+     */
+    public final long hitCount() {
+        return (hitCount != null) ? hitCount.sum() : 0;
+    }
+
+    /**
+     * Returns the number of calls to {@link #get} that found no cached value,
+     * or 0 if statistics are not recorded.
+     */
+    public final long missCount() {
+        return (missCount != null) ? missCount.sum() : 0;
+    }
+
+    /**
+     * Returns the number of entries evicted to keep the cache within its
+     * maximum size or by {@link #evictAll}, or 0 if statistics are not
+     * recorded.
+     */
+    public final long evictionCount() {
+        return (evictionCount != null) ? evictionCount.sum() : 0;
+    }
+
+    /**
+     * Returns a copy of the current contents of the cache, ordered from the
+     * next entry to be considered for eviction to the last.
+     */
+    public synchronized final Map<K, V> snapshot() {
+        Map<K, V> result = new LinkedHashMap<K, V>();
+        for (Node<K, V> node : clock) {
+            if (!node.removed) {
+                result.put(node.key, node.value);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Clear the cache, calling {@link #entryEvicted} on each removed entry.
+     */
+    public synchronized final void evictAll() {
+        trimToSize(-1, false, null);
+        clock.clear();
+        removedInClock = 0;
+    }
+}
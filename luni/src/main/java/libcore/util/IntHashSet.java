@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.util;
+
+import java.util.Arrays;
+import java.util.function.IntConsumer;
+
+/**
+ * A set of {@code int} values that does not box them. Use it in place of a
+ * {@code HashSet<Integer>} on paths where the cost of boxing and of calling
+ * {@code hashCode} and {@code equals} matters.
+ *
+ * <p>Values are kept in an open-addressing table with linear probing, as in
+ * {@link IntHashMap}.
+ *
+ * <p>This class is not thread-safe. The result of modifying the set from
+ * the action passed to {@link #forEach} is undefined.
+ *
+ * @hide
+ */
+public final class IntHashSet {
+    private static final int MIN_CAPACITY = 8;
+    private static final int MAX_CAPACITY = 1 << 30;
+
+    /** The elements, or 0 for empty slots. */
+    private int[] elements;
+    /** The number of elements in the table. */
+    private int tableSize;
+    /** The largest tableSize before the table grows. */
+    private int threshold;
+
+    // 0 marks empty slots, so whether the set holds 0 is kept apart.
+    private boolean hasZero;
+
+    public IntHashSet() {
+        this(0);
+    }
+
+    /**
+     * @param expectedSize the number of elements the set can hold without
+     *     growing.
+     */
+    public IntHashSet(int expectedSize) {
+        if (expectedSize < 0) {
+            throw new IllegalArgumentException("expectedSize < 0");
+        }
+        allocate(capacityFor(expectedSize));
+    }
+
+    /** Returns a table capacity that keeps the table at most 3/4 full. */
+    private static int capacityFor(int expectedSize) {
+        long needed = ((long) expectedSize * 4 + 2) / 3;
+        int capacity = MIN_CAPACITY;
+        while (capacity < needed && capacity < MAX_CAPACITY) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    /** Spreads all bits of the key over the low bits used as an index. */
+    private static int hash(int key) {
+        // The MurmurHash3 finalizer.
+        int h = key;
+        h ^= h >>> 16;
+        h *= 0x85ebca6b;
+        h ^= h >>> 13;
+        h *= 0xc2b2ae35;
+        return h ^ (h >>> 16);
+    }
+
+    private void allocate(int capacity) {
+        elements = new int[capacity];
+        threshold = capacity / 4 * 3;
+    }
+
+    /** Returns the slot holding {@code key}, which must not be 0, or -1. */
+    private int slotOf(int key) {
+        int[] elements = this.elements;
+        int mask = elements.length - 1;
+        for (int i = hash(key) & mask; ; i = (i + 1) & mask) {
+            int k = elements[i];
+            if (k == key) {
+                return i;
+            } else if (k == 0) {
+                return -1;
+            }
+        }
+    }
+
+    public int size() {
+        return hasZero ? tableSize + 1 : tableSize;
+    }
+
+    public boolean isEmpty() {
+        return size() == 0;
+    }
+
+    public boolean contains(int value) {
+        return (value == 0) ? hasZero : slotOf(value) >= 0;
+    }
+
+    /**
+     * Adds {@code value} to the set.
+     *
+     * @return true if the set did not already contain {@code value}.
+     */
+    public boolean add(int value) {
+        if (value == 0) {
+            boolean added = !hasZero;
+            hasZero = true;
+            return added;
+        }
+        int[] elements = this.elements;
+        int mask = elements.length - 1;
+        int i = hash(value) & mask;
+        for (int k; (k = elements[i]) != 0; i = (i + 1) & mask) {
+            if (k == value) {
+                return false;
+            }
+        }
+        if (tableSize == threshold) {
+            grow();
+            elements = this.elements;
+            i = freeSlot(elements, value);
+        }
+        elements[i] = value;
+        tableSize++;
+        return true;
+    }
+
+    /**
+     * Removes {@code value} from the set.
+     *
+     * @return true if the set contained {@code value}.
+     */
+    public boolean remove(int value) {
+        if (value == 0) {
+            boolean removed = hasZero;
+            hasZero = false;
+            return removed;
+        }
+        int i = slotOf(value);
+        if (i < 0) {
+            return false;
+        }
+        removeSlot(i);
+        return true;
+    }
+
+    /**
+     * Empties slot {@code gap}, then moves later elements of its probe
+     * sequence back so that lookups still find them without tombstones.
+     */
+    private void removeSlot(int gap) {
+        int[] elements = this.elements;
+        int mask = elements.length - 1;
+        for (int j = (gap + 1) & mask, k; (k = elements[j]) != 0; j = (j + 1) & mask) {
+            // The element at j may fill the gap if the gap lies on its
+            // probe sequence, between its home slot and j.
+            int home = hash(k) & mask;
+            if (((j - home) & mask) >= ((j - gap) & mask)) {
+                elements[gap] = k;
+                gap = j;
+            }
+        }
+        elements[gap] = 0;
+        tableSize--;
+    }
+
+    private void grow() {
+        int[] oldElements = elements;
+        if (oldElements.length == MAX_CAPACITY) {
+            throw new IllegalStateException("IntHashSet is full");
+        }
+        allocate(oldElements.length * 2);
+        int[] elements = this.elements;
+        for (int k : oldElements) {
+            if (k != 0) {
+                elements[freeSlot(elements, k)] = k;
+            }
+        }
+    }
+
+    /** Returns the first empty slot in the probe sequence of {@code key}. */
+    private static int freeSlot(int[] elements, int key) {
+        int mask = elements.length - 1;
+        int i = hash(key) & mask;
+        while (elements[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    public void clear() {
+        Arrays.fill(elements, 0);
+        tableSize = 0;
+        hasZero = false;
+    }
+
+    /** Returns the elements of the set, in no particular order. */
+    public int[] toArray() {
+        int[] result = new int[size()];
+        int n = 0;
+        if (hasZero) {
+            result[n++] = 0;
+        }
+        for (int k : elements) {
+            if (k != 0) {
+                result[n++] = k;
+            }
+        }
+        return result;
+    }
+
+    /** Calls {@code action} with each element, in no particular order. */
+    public void forEach(IntConsumer action) {
+        if (hasZero) {
+            action.accept(0);
+        }
+        for (int k : elements) {
+            if (k != 0) {
+                action.accept(k);
+            }
+        }
+    }
+}
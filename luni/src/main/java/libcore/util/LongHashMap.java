@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.util;
+
+import java.util.Arrays;
+import java.util.function.ObjLongConsumer;
+
+/**
+ * A map from {@code long} keys to values that does not box its keys. Use it
+ * in place of a {@code HashMap<Long, V>} on paths where the cost of
+ * boxing and of calling {@code hashCode} and {@code equals} matters.
+ *
+ * <p>Keys are kept in an open-addressing table with linear probing, so a
+ * lookup reads a few adjacent array elements and an insertion allocates
+ * nothing unless the table grows. Values may be null; use
+ * {@link #containsKey} to tell a null value from a missing key.
+ *
+ * <p>This class is not thread-safe. The result of modifying the map from
+ * the action passed to {@link #forEach} is undefined.
+ *
+ * @hide
+ */
+public final class LongHashMap<V> {
+    private static final int MIN_CAPACITY = 8;
+    private static final int MAX_CAPACITY = 1 << 30;
+
+    /** Keys of the entries, or 0 for empty slots. */
+    private long[] keys;
+    private Object[] values;
+    /** The number of entries in the table. */
+    private int tableSize;
+    /** The largest tableSize before the table grows. */
+    private int threshold;
+
+    // 0 marks empty slots, so an entry for key 0 is kept outside the table.
+    private boolean hasZeroKey;
+    private V zeroValue;
+
+    public LongHashMap() {
+        this(0);
+    }
+
+    /**
+     * @param expectedSize the number of entries the map can hold without
+     *     growing.
+     */
+    public LongHashMap(int expectedSize) {
+        if (expectedSize < 0) {
+            throw new IllegalArgumentException("expectedSize < 0");
+        }
+        allocate(capacityFor(expectedSize));
+    }
+
+    /** Returns a table capacity that keeps the table at most 3/4 full. */
+    private static int capacityFor(int expectedSize) {
+        long needed = ((long) expectedSize * 4 + 2) / 3;
+        int capacity = MIN_CAPACITY;
+        while (capacity < needed && capacity < MAX_CAPACITY) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    /** Spreads all bits of the key over the low bits used as an index. */
+    private static int hash(long key) {
+        // The MurmurHash3 finalizer.
+        long h = key;
+        h ^= h >>> 33;
+        h *= 0xff51afd7ed558ccdL;
+        h ^= h >>> 33;
+        h *= 0xc4ceb9fe1a85ec53L;
+        return (int) (h ^ (h >>> 33));
+    }
+
+    private void allocate(int capacity) {
+        keys = new long[capacity];
+        values = new Object[capacity];
+        threshold = capacity / 4 * 3;
+    }
+
+    /** Returns the slot holding {@code key}, which must not be 0, or -1. */
+    private int slotOf(long key) {
+        long[] keys = this.keys;
+        int mask = keys.length - 1;
+        for (int i = hash(key) & mask; ; i = (i + 1) & mask) {
+            long k = keys[i];
+            if (k == key) {
+                return i;
+            } else if (k == 0) {
+                return -1;
+            }
+        }
+    }
+
+    public int size() {
+        return hasZeroKey ? tableSize + 1 : tableSize;
+    }
+
+    public boolean isEmpty() {
+        return size() == 0;
+    }
+
+    public boolean containsKey(long key) {
+        return (key == 0) ? hasZeroKey : slotOf(key) >= 0;
+    }
+
+    /**
+     * Returns the value for {@code key}, or null if the map has no entry
+     * for it.
+     */
+    @SuppressWarnings("unchecked")
+    public V get(long key) {
+        if (key == 0) {
+            return zeroValue;
+        }
+        int i = slotOf(key);
+        return (i >= 0) ? (V) values[i] : null;
+    }
+
+    /**
+     * Maps {@code key} to {@code value}.
+     *
+     * @return the previous value for {@code key}, or null if there was none.
+     */
+    @SuppressWarnings("unchecked")
+    public V put(long key, V value) {
+        if (key == 0) {
+            V previous = zeroValue;
+            hasZeroKey = true;
+            zeroValue = value;
+            return previous;
+        }
+        long[] keys = this.keys;
+        int mask = keys.length - 1;
+        int i = hash(key) & mask;
+        for (long k; (k = keys[i]) != 0; i = (i + 1) & mask) {
+            if (k == key) {
+                V previous = (V) values[i];
+                values[i] = value;
+                return previous;
+            }
+        }
+        if (tableSize == threshold) {
+            grow();
+            keys = this.keys;
+            i = freeSlot(keys, key);
+        }
+        keys[i] = key;
+        values[i] = value;
+        tableSize++;
+        return null;
+    }
+
+    /**
+     * Removes the entry for {@code key}, if any.
+     *
+     * @return the removed value, or null if there was none.
+     */
+    @SuppressWarnings("unchecked")
+    public V remove(long key) {
+        if (key == 0) {
+            V previous = zeroValue;
+            hasZeroKey = false;
+            zeroValue = null;
+            return previous;
+        }
+        int i = slotOf(key);
+        if (i < 0) {
+            return null;
+        }
+        V previous = (V) values[i];
+        removeSlot(i);
+        return previous;
+    }
+
+    /**
+     * Empties slot {@code gap}, then moves later entries of its probe
+     * sequence back so that lookups still find them without tombstones.
+     */
+    private void removeSlot(int gap) {
+        long[] keys = this.keys;
+        Object[] values = this.values;
+        int mask = keys.length - 1;
+        for (int j = (gap + 1) & mask; keys[j] != 0; j = (j + 1) & mask) {
+            long k = keys[j];
+            // The entry at j may fill the gap if the gap lies on its probe
+            // sequence, between its home slot and j.
+            int home = hash(k) & mask;
+            if (((j - home) & mask) >= ((j - gap) & mask)) {
+                keys[gap] = k;
+                values[gap] = values[j];
+                gap = j;
+            }
+        }
+        keys[gap] = 0;
+        values[gap] = null;
+        tableSize--;
+    }
+
+    private void grow() {
+        long[] oldKeys = keys;
+        Object[] oldValues = values;
+        if (oldKeys.length == MAX_CAPACITY) {
+            throw new IllegalStateException("LongHashMap is full");
+        }
+        allocate(oldKeys.length * 2);
+        long[] keys = this.keys;
+        Object[] values = this.values;
+        for (int j = 0; j < oldKeys.length; j++) {
+            long k = oldKeys[j];
+            if (k != 0) {
+                int i = freeSlot(keys, k);
+                keys[i] = k;
+                values[i] = oldValues[j];
+            }
+        }
+    }
+
+    /** Returns the first empty slot in the probe sequence of {@code key}. */
+    private static int freeSlot(long[] keys, long key) {
+        int mask = keys.length - 1;
+        int i = hash(key) & mask;
+        while (keys[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    public void clear() {
+        Arrays.fill(keys, 0);
+        Arrays.fill(values, null);
+        tableSize = 0;
+        hasZeroKey = false;
+        zeroValue = null;
+    }
+
+    /** Returns the keys of the map, in no particular order. */
+    public long[] keys() {
+        long[] result = new long[size()];
+        int n = 0;
+        if (hasZeroKey) {
+            result[n++] = 0;
+        }
+        for (long k : keys) {
+            if (k != 0) {
+                result[n++] = k;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Calls {@code action} with the value and key of each entry, in no
+     * particular order.
+     */
+    @SuppressWarnings("unchecked")
+    public void forEach(ObjLongConsumer<? super V> action) {
+        if (hasZeroKey) {
+            action.accept(zeroValue, 0);
+        }
+        long[] keys = this.keys;
+        Object[] values = this.values;
+        for (int i = 0; i < keys.length; i++) {
+            if (keys[i] != 0) {
+                action.accept((V) values[i], keys[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.util;
+
+import java.util.Arrays;
+import java.util.function.LongConsumer;
+
+/**
+ * A set of {@code long} values that does not box them. Use it in place of a
+ * {@code HashSet<Long>} on paths where the cost of boxing and of calling
+ * {@code hashCode} and {@code equals} matters.
+ *
+ * <p>Values are kept in an open-addressing table with linear probing, as in
+ * {@link LongHashMap}.
+ *
+ * <p>This class is not thread-safe. The result of modifying the set from
+ * the action passed to {@link #forEach} is undefined.
+ *
+ * @hide
+ */
+public final class LongHashSet {
+    private static final int MIN_CAPACITY = 8;
+    private static final int MAX_CAPACITY = 1 << 30;
+
+    /** The elements, or 0 for empty slots. */
+    private long[] elements;
+    /** The number of elements in the table. */
+    private int tableSize;
+    /** The largest tableSize before the table grows. */
+    private int threshold;
+
+    // 0 marks empty slots, so whether the set holds 0 is kept apart.
+    private boolean hasZero;
+
+    public LongHashSet() {
+        this(0);
+    }
+
+    /**
+     * @param expectedSize the number of elements the set can hold without
+     *     growing.
+     */
+    public LongHashSet(int expectedSize) {
+        if (expectedSize < 0) {
+            throw new IllegalArgumentException("expectedSize < 0");
+        }
+        allocate(capacityFor(expectedSize));
+    }
+
+    /** Returns a table capacity that keeps the table at most 3/4 full. */
+    private static int capacityFor(int expectedSize) {
+        long needed = ((long) expectedSize * 4 + 2) / 3;
+        int capacity = MIN_CAPACITY;
+        while (capacity < needed && capacity < MAX_CAPACITY) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    /** Spreads all bits of the key over the low bits used as an index. */
+    private static int hash(long key) {
+        // The MurmurHash3 finalizer.
+        long h = key;
+        h ^= h >>> 33;
+        h *= 0xff51afd7ed558ccdL;
+        h ^= h >>> 33;
+        h *= 0xc4ceb9fe1a85ec53L;
+        return (int) (h ^ (h >>> 33));
+    }
+
+    private void allocate(int capacity) {
+        elements = new long[capacity];
+        threshold = capacity / 4 * 3;
+    }
+
+    /** Returns the slot holding {@code key}, which must not be 0, or -1. */
+    private int slotOf(long key) {
+        long[] elements = this.elements;
+        int mask = elements.length - 1;
+        for (int i = hash(key) & mask; ; i = (i + 1) & mask) {
+            long k = elements[i];
+            if (k == key) {
+                return i;
+            } else if (k == 0) {
+                return -1;
+            }
+        }
+    }
+
+    public int size() {
+        return hasZero ? tableSize + 1 : tableSize;
+    }
+
+    public boolean isEmpty() {
+        return size() == 0;
+    }
+
+    public boolean contains(long value) {
+        return (value == 0) ? hasZero : slotOf(value) >= 0;
+    }
+
+    /**
+     * Adds {@code value} to the set.
+     *
+     * @return true if the set did not already contain {@code value}.
+     */
+    public boolean add(long value) {
+        if (value == 0) {
+            boolean added = !hasZero;
+            hasZero = true;
+            return added;
+        }
+        long[] elements = this.elements;
+        int mask = elements.length - 1;
+        int i = hash(value) & mask;
+        for (long k; (k = elements[i]) != 0; i = (i + 1) & mask) {
+            if (k == value) {
+                return false;
+            }
+        }
+        if (tableSize == threshold) {
+            grow();
+            elements = this.elements;
+            i = freeSlot(elements, value);
+        }
+        elements[i] = value;
+        tableSize++;
+        return true;
+    }
+
+    /**
+     * Removes {@code value} from the set.
+     *
+     * @return true if the set contained {@code value}.
+     */
+    public boolean remove(long value) {
+        if (value == 0) {
+            boolean removed = hasZero;
+            hasZero = false;
+            return removed;
+        }
+        int i = slotOf(value);
+        if (i < 0) {
+            return false;
+        }
+        removeSlot(i);
+        return true;
+    }
+
+    /**
+     * Empties slot {@code gap}, then moves later elements of its probe
+     * sequence back so that lookups still find them without tombstones.
+     */
+    private void removeSlot(int gap) {
+        long[] elements = this.elements;
+        int mask = elements.length - 1;
+        for (int j = (gap + 1) & mask; elements[j] != 0; j = (j + 1) & mask) {
+            long k = elements[j];
+            // The element at j may fill the gap if the gap lies on its
+            // probe sequence, between its home slot and j.
+            int home = hash(k) & mask;
+            if (((j - home) & mask) >= ((j - gap) & mask)) {
+                elements[gap] = k;
+                gap = j;
+            }
+        }
+        elements[gap] = 0;
+        tableSize--;
+    }
+
+    private void grow() {
+        long[] oldElements = elements;
+        if (oldElements.length == MAX_CAPACITY) {
+            throw new IllegalStateException("LongHashSet is full");
+        }
+        allocate(oldElements.length * 2);
+        long[] elements = this.elements;
+        for (long k : oldElements) {
+            if (k != 0) {
+                elements[freeSlot(elements, k)] = k;
+            }
+        }
+    }
+
+    /** Returns the first empty slot in the probe sequence of {@code key}. */
+    private static int freeSlot(long[] elements, long key) {
+        int mask = elements.length - 1;
+        int i = hash(key) & mask;
+        while (elements[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    public void clear() {
+        Arrays.fill(elements, 0);
+        tableSize = 0;
+        hasZero = false;
+    }
+
+    /** Returns the elements of the set, in no particular order. */
+    public long[] toArray() {
+        long[] result = new long[size()];
+        int n = 0;
+        if (hasZero) {
+            result[n++] = 0;
+        }
+        for (long k : elements) {
+            if (k != 0) {
+                result[n++] = k;
+            }
+        }
+        return result;
+    }
+
+    /** Calls {@code action} with each element, in no particular order. */
+    public void forEach(LongConsumer action) {
+        if (hasZero) {
+            action.accept(0);
+        }
+        for (long k : elements) {
+            if (k != 0) {
+                action.accept(k);
+            }
+        }
+    }
+}
@@ -29,7 +29,9 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <android-base/unique_fd.h>
@@ -768,6 +770,68 @@ static jobjectArray ICU_getAvailableCurrencyCodes(JNIEnv* env, jclass) {
   return fromStringEnumeration(env, status, "ucurr_openISOCurrencies", &e);
 }
 
+// Creating a DateTimePatternGenerator loads and processes a large part of the
+// locale's CLDR data, so generators are cached for the most recently used
+// locales. A generator is not thread-safe, so each one has its own lock.
+struct CachedPatternGenerator {
+  std::mutex mutex;
+  std::unique_ptr<icu::DateTimePatternGenerator> generator;
+};
+
+static constexpr size_t kMaxCachedPatternGenerators = 4;
+
+static std::mutex gPatternGeneratorsMutex;
+// Locale names and their generators, most recently used first. Evicted
+// generators are destroyed once the threads still using them are done.
+static std::vector<std::pair<std::string, std::shared_ptr<CachedPatternGenerator>>>
+    gPatternGenerators;
+
+static std::shared_ptr<CachedPatternGenerator> findPatternGenerator(const std::string& name) {
+  // Must be called holding gPatternGeneratorsMutex.
+  for (auto it = gPatternGenerators.begin(); it != gPatternGenerators.end(); ++it) {
+    if (it->first == name) {
+      std::rotate(gPatternGenerators.begin(), it, it + 1);
+      return gPatternGenerators.front().second;
+    }
+  }
+  return nullptr;
+}
+
+static std::shared_ptr<CachedPatternGenerator> getPatternGenerator(const icu::Locale& locale,
+                                                                   UErrorCode& status) {
+  std::string name(locale.getName());
+  {
+    std::lock_guard<std::mutex> lock(gPatternGeneratorsMutex);
+    std::shared_ptr<CachedPatternGenerator> cached = findPatternGenerator(name);
+    if (cached != nullptr) {
+      return cached;
+    }
+  }
+
+  // Don't hold the lock while creating the generator. If another thread
+  // creates one for the same locale meanwhile, the first one cached is used.
+  std::shared_ptr<CachedPatternGenerator> created = std::make_shared<CachedPatternGenerator>();
+  created->generator.reset(icu::DateTimePatternGenerator::createInstance(locale, status));
+  if (U_FAILURE(status)) {
+    return nullptr;
+  }
+  if (created->generator == nullptr) {
+    status = U_MEMORY_ALLOCATION_ERROR;
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(gPatternGeneratorsMutex);
+  std::shared_ptr<CachedPatternGenerator> cached = findPatternGenerator(name);
+  if (cached != nullptr) {
+    return cached;
+  }
+  gPatternGenerators.emplace(gPatternGenerators.begin(), name, created);
+  if (gPatternGenerators.size() > kMaxCachedPatternGenerators) {
+    gPatternGenerators.pop_back();
+  }
+  return created;
+}
+
 static jstring ICU_getBestDateTimePatternNative(JNIEnv* env, jclass, jstring javaSkeleton, jstring javaLanguageTag) {
   ScopedIcuLocale icuLocale(env, javaLanguageTag);
   if (!icuLocale.valid()) {
@@ -775,7 +839,7 @@ static jstring ICU_getBestDateTimePatternNative(JNIEnv* env, jclass, jstring jav
   }
 
   UErrorCode status = U_ZERO_ERROR;
-  std::unique_ptr<icu::DateTimePatternGenerator> generator(icu::DateTimePatternGenerator::createInstance(icuLocale.locale(), status));
+  std::shared_ptr<CachedPatternGenerator> cached(getPatternGenerator(icuLocale.locale(), status));
   if (maybeThrowIcuException(env, "DateTimePatternGenerator::createInstance", status)) {
     return NULL;
   }
@@ -784,7 +848,11 @@ static jstring ICU_getBestDateTimePatternNative(JNIEnv* env, jclass, jstring jav
   if (!skeletonHolder.valid()) {
     return NULL;
   }
-  icu::UnicodeString result(generator->getBestPattern(skeletonHolder.unicodeString(), status));
+  icu::UnicodeString result;
+  {
+    std::lock_guard<std::mutex> lock(cached->mutex);
+    result = cached->generator->getBestPattern(skeletonHolder.unicodeString(), status);
+  }
   if (maybeThrowIcuException(env, "DateTimePatternGenerator::getBestPattern", status)) {
     return NULL;
   }
@@ -792,7 +860,7 @@ static jstring ICU_getBestDateTimePatternNative(JNIEnv* env, jclass, jstring jav
   return jniCreateString(env, result.getBuffer(), result.length());
 }
 
-static void ICU_setDefaultLocale(JNIEnv* env, jclass, jstring javaLanguageTag) {
+static void ICU_setDefaultLocaleNative(JNIEnv* env, jclass, jstring javaLanguageTag) {
   ScopedIcuLocale icuLocale(env, javaLanguageTag);
   if (!icuLocale.valid()) {
     return;
@@ -800,7 +868,14 @@ static void ICU_setDefaultLocale(JNIEnv* env, jclass, jstring javaLanguageTag) {
 
   UErrorCode status = U_ZERO_ERROR;
   icu::Locale::setDefault(icuLocale.locale(), status);
-  maybeThrowIcuException(env, "Locale::setDefault", status);
+  if (maybeThrowIcuException(env, "Locale::setDefault", status)) {
+    return;
+  }
+
+  // A generator for a locale ICU has no data for is built from the default
+  // locale's data, so cached generators may be stale now.
+  std::lock_guard<std::mutex> lock(gPatternGeneratorsMutex);
+  gPatternGenerators.clear();
 }
 
 static jstring ICU_getDefaultLocale(JNIEnv* env, jclass) {
@@ -837,7 +912,7 @@ static JNINativeMethod gMethods[] = {
     NATIVE_METHOD(ICU, getTZDataVersion, "()Ljava/lang/String;"),
     NATIVE_METHOD(ICU, getUnicodeVersion, "()Ljava/lang/String;"),
     NATIVE_METHOD(ICU, initLocaleDataNative, "(Ljava/lang/String;Llibcore/icu/LocaleData;)Z"),
-    NATIVE_METHOD(ICU, setDefaultLocale, "(Ljava/lang/String;)V"),
+    NATIVE_METHOD(ICU, setDefaultLocaleNative, "(Ljava/lang/String;)V"),
     NATIVE_METHOD(ICU, toLowerCase, "(Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;"),
     NATIVE_METHOD(ICU, toUpperCase, "(Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;"),
 };
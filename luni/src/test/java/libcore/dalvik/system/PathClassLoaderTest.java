@@ -23,12 +23,17 @@ import java.io.File;
 import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.net.URL;
 import java.security.CodeSigner;
 import java.security.cert.Certificate;
+import java.util.Collections;
 import java.util.Enumeration;
+import java.util.List;
 import java.util.jar.JarEntry;
 import java.util.jar.JarFile;
+import java.util.zip.ZipEntry;
 import java.util.zip.ZipFile;
+import java.util.zip.ZipOutputStream;
 
 import libcore.io.Streams;
 import tests.support.resource.Support_Resources;
@@ -56,6 +61,74 @@ public final class PathClassLoaderTest extends TestCase {
         assertEquals(applicationLib.toString(), path);
     }
 
+    public void testFindLibrary_libraryAddedAfterLookup() throws IOException {
+        File tmp = new File(System.getProperty("java.io.tmpdir"));
+        File applicationLibPath = new File(tmp, "lateLibPath");
+        applicationLibPath.mkdirs();
+        new File(applicationLibPath, "liblate.so").delete();
+
+        PathClassLoader pathClassLoader = new PathClassLoader(applicationLibPath.toString(),
+                applicationLibPath.toString(), getClass().getClassLoader());
+        assertNull(pathClassLoader.findLibrary("late"));
+
+        File lateLib = makeTempFile(applicationLibPath, "liblate.so");
+        assertEquals(lateLib.toString(), pathClassLoader.findLibrary("late"));
+        assertNull(pathClassLoader.findLibrary("missing"));
+    }
+
+    public void testFindLibrary_unlistableDirectory() throws IOException {
+        File tmp = new File(System.getProperty("java.io.tmpdir"));
+        File applicationLibPath = new File(tmp, "unlistableLibPath");
+        File applicationLib = makeTempFile(applicationLibPath, "libunlistable.so");
+        // Searchable but not readable, like a directory with mode 0311.
+        assertTrue(applicationLibPath.setReadable(false, false));
+        try {
+            PathClassLoader pathClassLoader = new PathClassLoader(applicationLibPath.toString(),
+                    applicationLibPath.toString(), getClass().getClassLoader());
+            assertEquals(applicationLib.toString(), pathClassLoader.findLibrary("unlistable"));
+            assertNull(pathClassLoader.findLibrary("missing"));
+        } finally {
+            applicationLibPath.setReadable(true, false);
+        }
+    }
+
+    public void testGetResources_searchOrder() throws Exception {
+        File resources = Support_Resources.createTempFolder();
+        File directory = new File(resources, "resourceDir");
+        makeTempFile(new File(directory, "a"), "shared.txt");
+        File firstJar = makeResourceJar(new File(resources, "first.jar"), "a/shared.txt", "a/");
+        File secondJar = makeResourceJar(new File(resources, "second.jar"), "a/shared.txt",
+                "a/only-in-second.txt");
+
+        PathClassLoader pcl = new PathClassLoader(
+                firstJar + File.pathSeparator + directory + File.pathSeparator + secondJar,
+                Object.class.getClassLoader());
+
+        List<URL> urls = Collections.list(pcl.getResources("a/shared.txt"));
+        assertEquals(3, urls.size());
+        assertTrue(urls.get(0).toString(), urls.get(0).toString().contains("first.jar"));
+        assertEquals("file", urls.get(1).getProtocol());
+        assertTrue(urls.get(2).toString(), urls.get(2).toString().contains("second.jar"));
+
+        URL onlyInSecond = pcl.getResource("a/only-in-second.txt");
+        assertNotNull(onlyInSecond);
+        assertTrue(onlyInSecond.toString(), onlyInSecond.toString().contains("second.jar"));
+        // A directory entry is found with or without its trailing slash.
+        assertNotNull(pcl.getResource("a"));
+        assertNull(pcl.getResource("missing.txt"));
+        assertFalse(pcl.getResources("missing.txt").hasMoreElements());
+    }
+
+    private static File makeResourceJar(File jar, String... entryNames) throws IOException {
+        try (ZipOutputStream out = new ZipOutputStream(new FileOutputStream(jar))) {
+            for (String entryName : entryNames) {
+                out.putNextEntry(new ZipEntry(entryName));
+                out.closeEntry();
+            }
+        }
+        return jar;
+    }
+
     private File makeTempFile(File directory, String name) throws IOException {
         directory.mkdirs();
         File result = new File(directory, name);
@@ -32,6 +32,8 @@ import org.junit.runner.RunWith;
 import org.junit.runners.MethodSorters;
 
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
 import static org.junit.Assert.fail;
 
 @RunWith(JUnitParamsRunner.class)
@@ -120,6 +122,44 @@ public class ObjectStreamClassTest {
     checkSerialVersionUID(suid23, clazz, expectedWarning);
   }
 
+  private static class Looked implements Serializable {
+  }
+
+  private static class NotSerializable {
+  }
+
+  @Test
+  public void lookup_returnsCachedDescriptor() {
+    ObjectStreamClass desc = ObjectStreamClass.lookup(Looked.class);
+    for (int i = 0; i < 10; i++) {
+      assertSame(desc, ObjectStreamClass.lookup(Looked.class));
+      assertSame(desc, ObjectStreamClass.lookupAny(Looked.class));
+    }
+  }
+
+  @Test
+  public void lookup_notSerializableAfterLookupAny() {
+    ObjectStreamClass desc = ObjectStreamClass.lookupAny(NotSerializable.class);
+    assertSame(desc, ObjectStreamClass.lookupAny(NotSerializable.class));
+    assertNull(ObjectStreamClass.lookup(NotSerializable.class));
+  }
+
+  private static class WithPrecomputedSUID implements Serializable {
+    int i;
+  }
+
+  private static class WithDeclaredSUID implements Serializable {
+    private static final long serialVersionUID = 42L;
+  }
+
+  @Test
+  public void putDefaultSerialVersionUID() {
+    ObjectStreamClass.putDefaultSerialVersionUID(WithPrecomputedSUID.class, 1234L);
+    ObjectStreamClass.putDefaultSerialVersionUID(WithDeclaredSUID.class, 1234L);
+    assertEquals(1234L, ObjectStreamClass.lookup(WithPrecomputedSUID.class).getSerialVersionUID());
+    assertEquals(42L, ObjectStreamClass.lookup(WithDeclaredSUID.class).getSerialVersionUID());
+  }
+
   private static void checkSerialVersionUID(
       long expectedSUID, Class<?> clazz, boolean expectedWarning) {
     // Use reflection to call the private static computeDefaultSUID method directly to avoid the
@@ -18,14 +18,19 @@ package libcore.java.io;
 
 import junit.framework.TestCase;
 
+import java.io.IOException;
 import java.io.InvalidClassException;
 import java.io.InvalidObjectException;
 import java.io.NotSerializableException;
+import java.io.ObjectInputStream;
+import java.io.ObjectOutputStream;
 import java.io.ObjectStreamClass;
 import java.io.ObjectStreamField;
 import java.io.Serializable;
 import java.lang.reflect.InvocationHandler;
 import java.lang.reflect.Method;
+import java.util.Arrays;
+import java.util.Random;
 import libcore.libcore.util.SerializationTester;
 
 public final class SerializationTest extends TestCase {
@@ -458,4 +463,93 @@ public final class SerializationTest extends TestCase {
         } catch (InvalidClassException expected) {
         }
     }
+
+    public void testPrimitiveArraysRoundTrip() throws Exception {
+        Random random = new Random(0);
+        // Sizes below, at and above the internal buffer and bulk conversion thresholds.
+        for (int size : new int[] { 0, 1, 15, 16, 17, 255, 1023, 1024, 1025, 10000 }) {
+            char[] chars = new char[size];
+            short[] shorts = new short[size];
+            int[] ints = new int[size];
+            long[] longs = new long[size];
+            float[] floats = new float[size];
+            double[] doubles = new double[size];
+            byte[] bytes = new byte[size];
+            random.nextBytes(bytes);
+            for (int i = 0; i < size; i++) {
+                chars[i] = (char) random.nextInt();
+                shorts[i] = (short) random.nextInt();
+                ints[i] = random.nextInt();
+                longs[i] = random.nextLong();
+                floats[i] = random.nextFloat();
+                doubles[i] = random.nextDouble();
+            }
+            assertTrue(Arrays.equals(chars, (char[]) SerializationTester.reserialize(chars)));
+            assertTrue(Arrays.equals(shorts, (short[]) SerializationTester.reserialize(shorts)));
+            assertTrue(Arrays.equals(ints, (int[]) SerializationTester.reserialize(ints)));
+            assertTrue(Arrays.equals(longs, (long[]) SerializationTester.reserialize(longs)));
+            assertTrue(Arrays.equals(floats, (float[]) SerializationTester.reserialize(floats)));
+            assertTrue(Arrays.equals(doubles, (double[]) SerializationTester.reserialize(doubles)));
+            assertTrue(Arrays.equals(bytes, (byte[]) SerializationTester.reserialize(bytes)));
+        }
+    }
+
+    public void testStringsRoundTrip() throws Exception {
+        StringBuilder ascii = new StringBuilder();
+        StringBuilder mixed = new StringBuilder();
+        for (int i = 0; i < 70000; i++) {
+            ascii.append((char) ('a' + i % 26));
+            mixed.append(i % 100 == 99 ? (char) (0x80 + i % 0x3000) : (char) ('a' + i % 26));
+        }
+        for (int length : new int[] { 0, 1, 4095, 4096, 4097, 65535, 70000 }) {
+            String a = ascii.substring(0, length);
+            String m = mixed.substring(0, length);
+            assertEquals(a, SerializationTester.reserialize(a));
+            assertEquals(m, SerializationTester.reserialize(m));
+            BlockData blockData = (BlockData) SerializationTester.reserialize(new BlockData(a, m));
+            assertEquals(a, blockData.ascii);
+            assertEquals(m, blockData.mixed);
+        }
+        assertEquals("\u0000\uffff", SerializationTester.reserialize("\u0000\uffff"));
+    }
+
+    public void testBlockDataRoundTrip() throws Exception {
+        BlockData blockData = (BlockData) SerializationTester.reserialize(new BlockData("a", "b"));
+        assertTrue(Arrays.equals(BlockData.BYTES, blockData.bytes));
+    }
+
+    static class BlockData implements Serializable {
+        private static final long serialVersionUID = 0L;
+        static final byte[] BYTES = new byte[10000];
+        static {
+            new Random(0).nextBytes(BYTES);
+        }
+
+        transient String ascii;
+        transient String mixed;
+        transient byte[] bytes;
+
+        BlockData(String ascii, String mixed) {
+            this.ascii = ascii;
+            this.mixed = mixed;
+        }
+
+        private void writeObject(ObjectOutputStream out) throws IOException {
+            out.writeUTF(ascii.length() <= 65535 ? ascii : "");
+            out.writeObject(mixed);
+            out.writeInt(7);
+            out.write(BYTES);
+            out.writeObject(ascii);
+        }
+
+        private void readObject(ObjectInputStream in) throws IOException, ClassNotFoundException {
+            String utf = in.readUTF();
+            mixed = (String) in.readObject();
+            assertEquals(7, in.readInt());
+            bytes = new byte[BYTES.length];
+            in.readFully(bytes);
+            ascii = (String) in.readObject();
+            assertTrue(utf.isEmpty() || utf.equals(ascii));
+        }
+    }
 }
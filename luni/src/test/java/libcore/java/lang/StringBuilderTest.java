@@ -16,6 +16,7 @@
 
 package libcore.java.lang;
 
+import java.nio.CharBuffer;
 import java.util.Arrays;
 
 public class StringBuilderTest extends junit.framework.TestCase {
@@ -161,4 +162,54 @@ public class StringBuilderTest extends junit.framework.TestCase {
         assertEquals((int) low, surrogateCP.codePoints().toArray()[1]); // Unmatched surrogate.
         assertEquals((int) '0', surrogateCP.codePoints().toArray()[2]);
     }
+
+    public void testAppendCharSequenceRange() {
+        StringBuilder sb = new StringBuilder("x");
+        sb.append("abcdef", 1, 4);
+        sb.append(new StringBuilder("ghijk"), 0, 2);
+        sb.append(new StringBuffer("lmn"), 2, 3);
+        sb.append(CharBuffer.wrap("opq"), 1, 3);
+        sb.append((CharSequence) null, 1, 3);
+        sb.append(sb, 0, 3);
+        assertEquals("xbcdghnpqulxbc", sb.toString());
+        try {
+            sb.append("abc", 2, 4);
+            fail();
+        } catch (IndexOutOfBoundsException expected) {
+        }
+    }
+
+    public void testInsertCharSequenceRange() {
+        StringBuilder sb = new StringBuilder("ab");
+        sb.insert(1, "0123", 1, 3);
+        sb.insert(0, new StringBuilder("xyz"), 1, 3);
+        sb.insert(sb.length(), CharBuffer.wrap("!?"), 0, 1);
+        assertEquals("yza12b!", sb.toString());
+    }
+
+    public void testAppendFloatingPoint() {
+        double[] doubles = { 0.0, -0.0, 1.0, -1.0, 9999999.0, -9999999.0, 1.0E7, -1.0E7, 0.5,
+                123456.0, Double.NaN, Double.POSITIVE_INFINITY, Double.MIN_VALUE, 1.0E-3,
+                (double) Integer.MAX_VALUE, (double) Integer.MIN_VALUE, 1.0E20 };
+        for (double d : doubles) {
+            assertEquals(Double.toString(d), new StringBuilder().append(d).toString());
+            assertEquals("x" + Double.toString(d), new StringBuffer("x").append(d).toString());
+            float f = (float) d;
+            assertEquals(Float.toString(f), new StringBuilder().append(f).toString());
+            assertEquals("x" + Float.toString(f), new StringBuffer("x").append(f).toString());
+        }
+    }
+
+    public void testGrowthKeepsContents() {
+        StringBuilder sb = new StringBuilder(1);
+        StringBuilder expected = new StringBuilder(100000);
+        for (int i = 0; i < 10000; i++) {
+            sb.append(i).append(',');
+            expected.append(Integer.toString(i)).append(",");
+        }
+        assertEquals(expected.toString(), sb.toString());
+        sb.setLength(sb.length() + 3);
+        assertEquals(expected.length() + 3, sb.length());
+        assertEquals('\0', sb.charAt(sb.length() - 1));
+    }
 }
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.java.lang;
+
+import java.lang.ref.WeakReference;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReference;
+
+import junit.framework.TestCase;
+
+import libcore.java.lang.ref.FinalizationTester;
+
+/**
+ * Tests ThreadLocals in indexed mode.
+ */
+public class ThreadLocalTest extends TestCase {
+
+    public void testIndexed_getSetRemove() {
+        final AtomicInteger initialCalls = new AtomicInteger();
+        ThreadLocal<String> local = ThreadLocal.withInitialIndexed(() -> {
+            initialCalls.incrementAndGet();
+            return "initial";
+        });
+        assertEquals("initial", local.get());
+        assertEquals("initial", local.get());
+        assertEquals(1, initialCalls.get());
+
+        local.set("a");
+        assertEquals("a", local.get());
+        local.set(null);
+        assertNull(local.get());
+        assertEquals(1, initialCalls.get());
+
+        local.remove();
+        assertEquals("initial", local.get());
+        assertEquals(2, initialCalls.get());
+    }
+
+    public void testIndexed_subclass() {
+        ThreadLocal<Integer> local = new ThreadLocal<Integer>(true) {
+            @Override
+            protected Integer initialValue() {
+                return 42;
+            }
+        };
+        assertEquals(Integer.valueOf(42), local.get());
+    }
+
+    public void testIndexed_valuesArePerThread() throws Exception {
+        final ThreadLocal<String> local = ThreadLocal.withInitialIndexed(() -> "initial");
+        local.set("main");
+        final AtomicReference<String> seen = new AtomicReference<>();
+        Thread thread = new Thread(() -> {
+            seen.set(local.get());
+            local.set("other");
+        });
+        thread.start();
+        thread.join();
+        assertEquals("initial", seen.get());
+        assertEquals("main", local.get());
+    }
+
+    public void testIndexed_manyLocals() {
+        ThreadLocal<?>[] locals = new ThreadLocal<?>[200];
+        for (int i = 0; i < locals.length; i++) {
+            final int value = i;
+            locals[i] = ThreadLocal.withInitialIndexed(() -> value);
+        }
+        for (int i = 0; i < locals.length; i++) {
+            assertEquals(i, locals[i].get());
+        }
+        for (int i = locals.length - 1; i >= 0; i--) {
+            assertEquals(i, locals[i].get());
+        }
+    }
+
+    public void testIndexed_collectedLocalsDoNotLeakValues() throws Exception {
+        for (int round = 0; round < 5; round++) {
+            for (int i = 0; i < 50; i++) {
+                ThreadLocal<String> local = ThreadLocal.withInitialIndexed(() -> null);
+                assertNull(local.get());
+                local.set("stale");
+            }
+            // Let the Cleaners free the indices of the locals above, so
+            // that the next round reuses them.
+            FinalizationTester.induceFinalization();
+        }
+    }
+
+    public void testIndexed_valuesOfCollectedLocalsAreReleased() throws Exception {
+        ThreadLocal<String> live = ThreadLocal.withInitialIndexed(() -> null);
+        live.set("live");
+        WeakReference<Object> value = setValueOfUnreachableLocal();
+        // Setting any indexed local drops the values of collected ones once
+        // their Cleaners have run.
+        for (int i = 0; i < 10 && value.get() != null; i++) {
+            FinalizationTester.induceFinalization();
+            live.set("live" + i);
+        }
+        FinalizationTester.induceFinalization();
+        assertNull(value.get());
+        // The live local's value is kept.
+        assertTrue(live.get(), live.get().startsWith("live"));
+    }
+
+    private static WeakReference<Object> setValueOfUnreachableLocal() {
+        Object value = new Object();
+        ThreadLocal<Object> local = ThreadLocal.withInitialIndexed(() -> null);
+        local.set(value);
+        return new WeakReference<>(value);
+    }
+
+    public void testInheritableThreadLocalIsNotIndexed() throws Exception {
+        final InheritableThreadLocal<String> local = new InheritableThreadLocal<String>();
+        local.set("parent");
+        final AtomicReference<String> seen = new AtomicReference<>();
+        Thread thread = new Thread(() -> seen.set(local.get()));
+        thread.start();
+        thread.join();
+        assertEquals("parent", seen.get());
+    }
+}
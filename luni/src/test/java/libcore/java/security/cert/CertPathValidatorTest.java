@@ -23,6 +23,7 @@ import java.security.cert.CertPathValidator;
 import java.security.cert.CertPathValidatorException;
 import java.security.cert.CertificateFactory;
 import java.security.cert.PKIXCertPathChecker;
+import java.security.cert.PKIXCertPathValidatorResult;
 import java.security.cert.PKIXParameters;
 import java.security.cert.PKIXRevocationChecker;
 import java.security.cert.TrustAnchor;
@@ -142,4 +143,54 @@ public class CertPathValidatorTest extends TestCase {
     public void test_OCSP_EndEntity_Good_Success() throws Exception {
         runOCSPStapledTest(CertificateStatus.GOOD, true);
     }
+
+    public void test_resultCache() throws Exception {
+        PrivateKeyEntry serverEntry = TestKeyStore.getServer().getPrivateKey("RSA", "RSA");
+        PrivateKeyEntry caEntry = TestKeyStore.getIntermediateCa().getPrivateKey("RSA", "RSA");
+        PrivateKeyEntry rootCaEntry = TestKeyStore.getRootCa().getPrivateKey("RSA", "RSA");
+
+        ArrayList<X509Certificate> chain = new ArrayList<>();
+        chain.add((X509Certificate) serverEntry.getCertificate());
+        chain.add((X509Certificate) caEntry.getCertificate());
+        CertPath certPath = CertificateFactory.getInstance("X.509").generateCertPath(chain);
+
+        PKIXParameters params = new PKIXParameters(Collections
+                .singleton(new TrustAnchor((X509Certificate) rootCaEntry.getCertificate(), null)));
+        params.setRevocationEnabled(false);
+        CertPathValidator cpv = CertPathValidator.getInstance("PKIX");
+
+        params.setResultCacheEnabled(true);
+        PKIXCertPathValidatorResult first =
+                (PKIXCertPathValidatorResult) cpv.validate(certPath, params);
+        PKIXCertPathValidatorResult second =
+                (PKIXCertPathValidatorResult) cpv.validate(certPath, params);
+        assertNotSame(first, second);
+        assertEquals(first.getTrustAnchor(), second.getTrustAnchor());
+        assertEquals(first.getPublicKey(), second.getPublicKey());
+
+        // Anchors are matched by content, not identity.
+        PKIXParameters sameAnchors = new PKIXParameters(Collections
+                .singleton(new TrustAnchor((X509Certificate) rootCaEntry.getCertificate(), null)));
+        sameAnchors.setRevocationEnabled(false);
+        sameAnchors.setResultCacheEnabled(true);
+        cpv.validate(certPath, sameAnchors);
+
+        // A cached result is not used outside the certificates' validity.
+        params.setDate(new Date(chain.get(0).getNotAfter().getTime() + 1));
+        try {
+            cpv.validate(certPath, params);
+            fail();
+        } catch (CertPathValidatorException expected) {
+        }
+
+        // Nor after the trust anchors change.
+        params.setDate(null);
+        params.setTrustAnchors(Collections.singleton(
+                new TrustAnchor((X509Certificate) serverEntry.getCertificate(), null)));
+        try {
+            cpv.validate(certPath, params);
+            fail();
+        } catch (CertPathValidatorException expected) {
+        }
+    }
 }
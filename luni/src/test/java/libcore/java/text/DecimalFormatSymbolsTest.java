@@ -208,4 +208,19 @@ public class DecimalFormatSymbolsTest extends junit.framework.TestCase {
         assertEquals('X', DecimalFormatSymbols.maybeStripMarkers(alm + "X", fallback));
         assertEquals('X', DecimalFormatSymbols.maybeStripMarkers(alm + "X" + rtl, fallback));
     }
+
+    public void test_getInstance_returnsIndependentCopies() throws Exception {
+        DecimalFormatSymbols first = DecimalFormatSymbols.getInstance(Locale.US);
+        DecimalFormatSymbols second = DecimalFormatSymbols.getInstance(Locale.US);
+        assertNotSame(first, second);
+        assertEquals(first, second);
+
+        first.setDecimalSeparator(',');
+        first.setMinusSign('~');
+        DecimalFormatSymbols third = DecimalFormatSymbols.getInstance(Locale.US);
+        assertEquals('.', second.getDecimalSeparator());
+        assertEquals('.', third.getDecimalSeparator());
+        assertEquals('-', third.getMinusSign());
+        assertEquals(new DecimalFormatSymbols(Locale.US), third);
+    }
 }
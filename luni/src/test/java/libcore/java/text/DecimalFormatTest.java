@@ -707,4 +707,35 @@ public class DecimalFormatTest extends junit.framework.TestCase {
         return String.format("%s, index=%d, errorIndex=%d",
                 result, pos.getIndex(), pos.getErrorIndex());
     }
+
+    public void testInstancesWithSamePatternAreIndependent() {
+        DecimalFormatSymbols symbols = DecimalFormatSymbols.getInstance(Locale.US);
+        DecimalFormat first = new DecimalFormat("#,##0.00", symbols);
+        DecimalFormat second = new DecimalFormat("#,##0.00", symbols);
+        first.setMaximumFractionDigits(0);
+        first.setPositivePrefix("+");
+        first.setGroupingUsed(false);
+        assertEquals("+1235", first.format(1234.5));
+        assertEquals("1,234.50", second.format(1234.5));
+        assertEquals("1,234.50", new DecimalFormat("#,##0.00", symbols).format(1234.5));
+
+        DecimalFormatSymbols french = DecimalFormatSymbols.getInstance(Locale.FRANCE);
+        DecimalFormat third = new DecimalFormat("#,##0.00", french);
+        assertEquals(french.getDecimalSeparator(), third.format(1.5).charAt(1));
+
+        second.setDecimalFormatSymbols(french);
+        assertEquals(french.getDecimalSeparator(), second.format(1.5).charAt(1));
+        assertEquals("1.50", new DecimalFormat("#,##0.00", symbols).format(1.5));
+    }
+
+    public void testInvalidPatternStillThrows() {
+        DecimalFormatSymbols symbols = DecimalFormatSymbols.getInstance(Locale.US);
+        for (int i = 0; i < 2; i++) {
+            try {
+                new DecimalFormat("0.0.0", symbols);
+                fail();
+            } catch (IllegalArgumentException expected) {
+            }
+        }
+    }
 }
@@ -18,6 +18,8 @@ package libcore.java.text;
 
 import java.text.DateFormat;
 import java.text.DateFormatSymbols;
+import java.text.DecimalFormatSymbols;
+import java.text.NumberFormat;
 import java.text.ParseException;
 import java.text.ParsePosition;
 import java.text.SimpleDateFormat;
@@ -866,4 +868,47 @@ public class SimpleDateFormatTest extends junit.framework.TestCase {
         }
     }
 
+    public void testFormatNumericFields() {
+        SimpleDateFormat sdf = new SimpleDateFormat("yyyyy y SSS S SSSSS HH:mm", Locale.US);
+        sdf.setTimeZone(UTC);
+        assertEquals("01970 1970 007 7 00007 00:00", sdf.format(new Date(7)));
+        assertEquals("01970 1970 123 123 00123 00:00", sdf.format(new Date(123)));
+
+        Locale arabic = Locale.forLanguageTag("ar-u-nu-arab");
+        char zero = DecimalFormatSymbols.getInstance(arabic).getZeroDigit();
+        SimpleDateFormat arabicSdf = new SimpleDateFormat("SSS", arabic);
+        arabicSdf.setTimeZone(UTC);
+        assertEquals(new String(new char[] { zero, (char) (zero + 4), (char) (zero + 2) }),
+                arabicSdf.format(new Date(42)));
+    }
+
+    public void testFormatNumericFields_customNumberFormat() {
+        SimpleDateFormat sdf = new SimpleDateFormat("yyyyy SSSSS", Locale.US);
+        sdf.setTimeZone(UTC);
+        sdf.setNumberFormat(NumberFormat.getIntegerInstance(Locale.US));
+        assertEquals("01,970 00,007", sdf.format(new Date(7)));
+
+        SimpleDateFormat grouping = new SimpleDateFormat("yyyyy", Locale.US);
+        grouping.setTimeZone(UTC);
+        grouping.getNumberFormat().setGroupingUsed(true);
+        assertEquals("01,970", grouping.format(new Date(7)));
+        assertEquals("01,970", ((SimpleDateFormat) grouping.clone()).format(new Date(7)));
+    }
+
+    public void testInstancesWithSamePatternAreIndependent() {
+        SimpleDateFormat first = new SimpleDateFormat("yyyy-MM-dd", Locale.US);
+        SimpleDateFormat second = new SimpleDateFormat("yyyy-MM-dd", Locale.US);
+        first.setTimeZone(UTC);
+        second.setTimeZone(UTC);
+        first.applyPattern("dd/MM/yyyy");
+        assertEquals("01/01/1970", first.format(new Date(0)));
+        assertEquals("1970-01-01", second.format(new Date(0)));
+        assertEquals("yyyy-MM-dd", second.toPattern());
+
+        try {
+            new SimpleDateFormat("yyyy-MM-dd q", Locale.US);
+            fail();
+        } catch (IllegalArgumentException expected) {
+        }
+    }
 }
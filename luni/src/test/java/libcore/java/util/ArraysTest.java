@@ -541,4 +541,97 @@ public class ArraysTest extends junit.framework.TestCase {
             new Object[] { new Object[] { "Hello", "world" } },
             new Object[] { new String[] { "Hello", "world" } }));
     }
+
+    // Large, unstructured arrays are sorted with a radix sort; check it against the
+    // ordering of the boxed types, including the placement of NaN and -0.0.
+    private static final int LARGE_SORT_LENGTH = 100_000;
+
+    public void test_sort$I_large() {
+        Random random = new Random(0);
+        for (int bound : new int[] { 0, 10, 1 << 20 }) {
+            int[] a = new int[LARGE_SORT_LENGTH];
+            for (int i = 0; i < a.length; i++) {
+                a[i] = bound == 0 ? random.nextInt() : random.nextInt(bound) - bound / 2;
+            }
+            a[0] = Integer.MIN_VALUE;
+            a[1] = Integer.MAX_VALUE;
+            Integer[] expected = new Integer[a.length];
+            for (int i = 0; i < a.length; i++) {
+                expected[i] = a[i];
+            }
+            Arrays.sort(expected);
+            Arrays.sort(a, 1, a.length);
+            assertEquals(Integer.MIN_VALUE, a[0]);
+            Arrays.sort(a);
+            for (int i = 0; i < a.length; i++) {
+                assertEquals(expected[i].intValue(), a[i]);
+            }
+        }
+    }
+
+    public void test_sort$J_large() {
+        Random random = new Random(1);
+        long[] a = new long[LARGE_SORT_LENGTH];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = (i % 3 == 0) ? random.nextInt(100) : random.nextLong();
+        }
+        a[0] = Long.MIN_VALUE;
+        a[1] = Long.MAX_VALUE;
+        Long[] expected = new Long[a.length];
+        for (int i = 0; i < a.length; i++) {
+            expected[i] = a[i];
+        }
+        Arrays.sort(expected);
+        Arrays.sort(a);
+        for (int i = 0; i < a.length; i++) {
+            assertEquals(expected[i].longValue(), a[i]);
+        }
+    }
+
+    private static final float[] SPECIAL_FLOATS = { Float.NaN, -0.0f, 0.0f, Float.MIN_VALUE,
+            -Float.MIN_VALUE, Float.MAX_VALUE, -Float.MAX_VALUE, Float.POSITIVE_INFINITY,
+            Float.NEGATIVE_INFINITY, Float.intBitsToFloat(0x7fc00001) };
+
+    public void test_sort$F_large() {
+        Random random = new Random(2);
+        float[] a = new float[LARGE_SORT_LENGTH];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = (i % 10 == 0)
+                    ? SPECIAL_FLOATS[random.nextInt(SPECIAL_FLOATS.length)]
+                    : (random.nextFloat() - 0.5f) * random.nextInt(1000);
+        }
+        Float[] expected = new Float[a.length];
+        for (int i = 0; i < a.length; i++) {
+            expected[i] = a[i];
+        }
+        Arrays.sort(expected);
+        Arrays.sort(a);
+        for (int i = 0; i < a.length; i++) {
+            assertEquals(0, Float.compare(expected[i], a[i]));
+        }
+    }
+
+    private static final double[] SPECIAL_DOUBLES = { Double.NaN, -0.0d, 0.0d,
+            Double.MIN_VALUE, -Double.MIN_VALUE, Double.MAX_VALUE, -Double.MAX_VALUE,
+            Double.POSITIVE_INFINITY, Double.NEGATIVE_INFINITY,
+            Double.longBitsToDouble(0x7ff8000000000001L) };
+
+    public void test_sort$D_large() {
+        Random random = new Random(3);
+        double[] a = new double[LARGE_SORT_LENGTH];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = (i % 10 == 0)
+                    ? SPECIAL_DOUBLES[random.nextInt(SPECIAL_DOUBLES.length)]
+                    : random.nextGaussian() * 1e6;
+        }
+        Double[] expected = new Double[a.length];
+        for (int i = 0; i < a.length; i++) {
+            expected[i] = a[i];
+        }
+        Arrays.sort(expected);
+        Arrays.parallelSort(a);
+        for (int i = 0; i < a.length; i++) {
+            assertEquals(0, Double.compare(expected[i], a[i]));
+        }
+    }
 }
@@ -20,6 +20,7 @@ import junit.framework.TestCase;
 
 import java.io.ByteArrayInputStream;
 import java.io.ByteArrayOutputStream;
+import java.io.FilterInputStream;
 import java.io.IOException;
 import java.io.InputStream;
 import java.io.OutputStream;
@@ -707,6 +708,56 @@ public class Base64Test extends TestCase {
         assertEquals(expectedBytes.length, encodedBuffer.limit());
     }
 
+    public void testEncoder_encodeByteBuffer_directLargeInput() {
+        byte[] input = new byte[50000];
+        new Random(4242L).nextBytes(input);
+        Encoder[] encoders = {
+                Base64.getEncoder(),
+                Base64.getUrlEncoder(),
+                Base64.getMimeEncoder(),
+                Base64.getMimeEncoder(8, new byte[] { '\n' }),
+                Base64.getMimeEncoder().withoutPadding(),
+        };
+        for (Encoder encoder : encoders) {
+            // Lengths that do and do not end on a 3-byte group or a line.
+            for (int length : new int[] { 8207, 8208, 8209, input.length }) {
+                ByteBuffer inputBuffer = ByteBuffer.allocateDirect(length);
+                inputBuffer.put(input, 0, length);
+                inputBuffer.position(0);
+                ByteBuffer encoded = encoder.encode(inputBuffer);
+                byte[] actual = new byte[encoded.remaining()];
+                encoded.get(actual);
+                assertArrayEquals(encoder.encode(copyOfRange(input, 0, length)), actual);
+                assertEquals(length, inputBuffer.position());
+            }
+        }
+    }
+
+    public void testDecoder_illegalCharacterAfterWholeUnits() throws Exception {
+        String valid = "QUJDQUJDQUJD";
+        assertDecodeThrowsIAe(Base64.getDecoder(), valid + "Q*JD");
+        assertDecodeThrowsIAe(Base64.getDecoder(), valid + "Q=JD");
+        assertDecodeThrowsIAe(Base64.getUrlDecoder(), valid + "QU+D");
+        assertEquals("ABCABCABCABC", decodeToAscii(Base64.getMimeDecoder(), valid + "Q*UJD"));
+        assertEquals("ABCABCABCAB", decodeToAscii(Base64.getDecoder(), valid + "QUI="));
+    }
+
+    public void testDecoder_wrap_largeMimeInput() throws IOException {
+        byte[] plain = new byte[10000];
+        new Random(1234L).nextBytes(plain);
+        byte[] encoded = Base64.getMimeEncoder().encode(plain);
+        for (int readLength : new int[] { 1, 2, 3, 100, 4096 }) {
+            InputStream in = Base64.getMimeDecoder().wrap(new ByteArrayInputStream(encoded));
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            byte[] buffer = new byte[readLength];
+            int n;
+            while ((n = in.read(buffer)) != -1) {
+                out.write(buffer, 0, n);
+            }
+            assertArrayEquals(plain, out.toByteArray());
+        }
+    }
+
     /**
      * Checks that all encoders/decoders map {@code new byte[0]} to "" and vice versa.
      */
@@ -962,6 +1013,30 @@ public class Base64Test extends TestCase {
         assertEquals(-1, in.read());
     }
 
+    public void testDecoder_wrap_leavesBytesAfterPadding() throws IOException {
+        byte[] input = "AAECAwQF/v8=TRAILER".getBytes(US_ASCII);
+        for (boolean markSupported : new boolean[] { true, false }) {
+            InputStream underlying = new ByteArrayInputStream(input);
+            if (!markSupported) {
+                underlying = new FilterInputStream(underlying) {
+                    @Override
+                    public boolean markSupported() {
+                        return false;
+                    }
+                };
+            }
+            InputStream in = Base64.getDecoder().wrap(underlying);
+            byte[] decoded = new byte[64];
+            assertEquals(8, in.read(decoded, 0, decoded.length));
+            assertArrayEquals(new byte[] { 0, 1, 2, 3, 4, 5, -2, -1 }, copyOfRange(decoded, 0, 8));
+            assertEquals(-1, in.read(decoded, 0, decoded.length));
+
+            byte[] rest = new byte[64];
+            int n = underlying.read(rest);
+            assertEquals("TRAILER", new String(rest, 0, n, US_ASCII));
+        }
+    }
+
     public void testEncoder_withoutPadding() {
         byte[] bytes = new byte[] { (byte) 0xFE, (byte) 0xFF };
         assertEquals("/v8=", Base64.getEncoder().encodeToString(bytes));
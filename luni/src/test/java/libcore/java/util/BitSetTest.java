@@ -261,4 +261,117 @@ public class BitSetTest extends junit.framework.TestCase {
         assertEquals(bs.cardinality(), bs.stream().count());
         bs.stream().forEach(x -> assertTrue(bs.get(x)));
     }
+
+    private static BitSet randomBitSet(Random random, int nbits) {
+        BitSet bs = new BitSet();
+        for (int i = 0; i < nbits; i++) {
+            if (random.nextBoolean()) {
+                bs.set(i);
+            }
+        }
+        return bs;
+    }
+
+    public void test_rangeOperations() {
+        Random random = new Random(0);
+        int[][] ranges = { { 0, 0 }, { 0, 300 }, { 3, 7 }, { 5, 64 }, { 64, 128 }, { 63, 129 },
+                { 100, 250 }, { 200, 1000 }, { 500, 600 } };
+        for (int trial = 0; trial < 20; trial++) {
+            BitSet a = randomBitSet(random, random.nextInt(300));
+            BitSet b = randomBitSet(random, random.nextInt(300));
+            for (int[] range : ranges) {
+                int from = range[0];
+                int to = range[1];
+                for (int op = 0; op < 4; op++) {
+                    BitSet actual = (BitSet) a.clone();
+                    BitSet expected = (BitSet) a.clone();
+                    for (int i = from; i < to; i++) {
+                        boolean x = a.get(i);
+                        boolean y = b.get(i);
+                        boolean result = op == 0 ? (x & y) : op == 1 ? (x | y)
+                                : op == 2 ? (x ^ y) : (x & !y);
+                        expected.set(i, result);
+                    }
+                    switch (op) {
+                        case 0: actual.and(b, from, to); break;
+                        case 1: actual.or(b, from, to); break;
+                        case 2: actual.xor(b, from, to); break;
+                        default: actual.andNot(b, from, to); break;
+                    }
+                    assertEquals("op " + op + " on [" + from + ", " + to + ")", expected, actual);
+                    assertEquals(expected.length(), actual.length());
+                }
+            }
+        }
+    }
+
+    public void test_rangeOperations_self() {
+        BitSet bs = new BitSet();
+        bs.set(10, 200);
+        bs.and(bs, 0, 300);
+        bs.or(bs, 0, 300);
+        assertEquals(190, bs.cardinality());
+        bs.xor(bs, 50, 100);
+        assertEquals(140, bs.cardinality());
+        bs.andNot(bs, 150, 250);
+        assertEquals(90, bs.cardinality());
+        assertEquals(150, bs.length());
+    }
+
+    public void test_rangeOperations_badRange() {
+        BitSet bs = new BitSet();
+        try {
+            bs.and(new BitSet(), 5, 4);
+            fail();
+        } catch (IndexOutOfBoundsException expected) {
+        }
+        try {
+            bs.or(new BitSet(), -1, 4);
+            fail();
+        } catch (IndexOutOfBoundsException expected) {
+        }
+    }
+
+    public void test_forEachSetBit() {
+        BitSet bs = randomBitSet(new Random(1), 1000);
+        bs.set(4095);
+        final int[] expected = bs.stream().toArray();
+        final int[] count = new int[1];
+        bs.forEachSetBit(i -> assertEquals(expected[count[0]++], i));
+        assertEquals(expected.length, count[0]);
+    }
+
+    public void test_nextSetBits() {
+        BitSet bs = randomBitSet(new Random(2), 1000);
+        int[] expected = bs.stream().toArray();
+
+        int[] all = new int[expected.length + 2];
+        assertEquals(expected.length, bs.nextSetBits(0, all, 1, all.length - 1));
+        assertTrue(Arrays.equals(expected, Arrays.copyOfRange(all, 1, expected.length + 1)));
+
+        // Export in chunks.
+        int[] chunk = new int[7];
+        int[] actual = new int[expected.length];
+        int count = 0;
+        int n;
+        int from = 0;
+        while ((n = bs.nextSetBits(from, chunk, 0, chunk.length)) > 0) {
+            System.arraycopy(chunk, 0, actual, count, n);
+            count += n;
+            from = chunk[n - 1] + 1;
+            if (n < chunk.length) {
+                break;
+            }
+        }
+        assertEquals(expected.length, count);
+        assertTrue(Arrays.equals(expected, actual));
+
+        assertEquals(0, bs.nextSetBits(2000, chunk, 0, chunk.length));
+        assertEquals(0, bs.nextSetBits(0, chunk, 0, 0));
+        try {
+            bs.nextSetBits(0, chunk, 5, 3);
+            fail();
+        } catch (IndexOutOfBoundsException expectedException) {
+        }
+    }
 }
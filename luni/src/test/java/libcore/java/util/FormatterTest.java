@@ -23,8 +23,11 @@ import java.text.NumberFormat;
 import java.util.Calendar;
 import java.util.Formatter;
 import java.util.GregorianCalendar;
+import java.util.IllegalFormatConversionException;
 import java.util.Locale;
+import java.util.MissingFormatArgumentException;
 import java.util.TimeZone;
+import java.util.UnknownFormatConversionException;
 
 public class FormatterTest extends junit.framework.TestCase {
     public void test_numberLocalization() throws Exception {
@@ -207,4 +210,55 @@ public class FormatterTest extends junit.framework.TestCase {
         formatter.format("%,d", 123456789);
         // No exception expected
     }
+
+    // The same format string is compiled once and then reused by other formatters, which may use
+    // a different locale and destination.
+    public void testCompiledFormatReusedAcrossLocales() throws Exception {
+        String format = "%d|%,d|%.2f|%5d|%-5d|%s%n";
+        String ls = System.lineSeparator();
+        assertEquals("1234|1,234|3.14| 1234|1234 |x" + ls,
+                String.format(Locale.US, format, 1234, 1234, 3.14159, 1234, 1234, "x"));
+        assertEquals("1234|1.234|3,14| 1234|1234 |x" + ls,
+                String.format(Locale.GERMANY, format, 1234, 1234, 3.14159, 1234, 1234, "x"));
+        assertEquals("\u0661\u0662\u0663\u0664|\u0661\u066c\u0662\u0663\u0664"
+                + "|\u0663\u066b\u0661\u0664| \u0661\u0662\u0663\u0664"
+                + "|\u0661\u0662\u0663\u0664 |x" + ls,
+                String.format(new Locale("ar"), format, 1234, 1234, 3.14159, 1234, 1234, "x"));
+
+        // A Formatter whose destination is not a StringBuilder.
+        StringBuffer sb = new StringBuffer("prefix:");
+        new Formatter(sb, Locale.US).format(format, -1234, -1234, -3.14159, -1234, -1234, null);
+        assertEquals("prefix:-1234|-1,234|-3.14|-1234|-1234|null" + ls, sb.toString());
+    }
+
+    public void testIntegerAndFixedPointAppendToExistingContent() throws Exception {
+        StringBuilder sb = new StringBuilder("x=");
+        Formatter f = new Formatter(sb, Locale.US);
+        f.format("%d,%d,%d;", Long.MIN_VALUE, 0, Integer.MAX_VALUE);
+        f.format("%(d %+d % d;", -5, 5, 5);
+        f.format("%.3f %f %.0f %f %f", -0.0005, 1.5f, 2.5, Double.NaN, Double.NEGATIVE_INFINITY);
+        assertEquals("x=-9223372036854775808,0,2147483647;(5) +5  5;"
+                + "-0.001 1.500000 3 NaN -Infinity", sb.toString());
+        assertSame(sb, f.out());
+    }
+
+    public void testCompiledFormatErrorsAreRepeated() throws Exception {
+        for (int i = 0; i < 2; i++) {
+            try {
+                String.format("%q", 1);
+                fail();
+            } catch (UnknownFormatConversionException expected) {
+            }
+            try {
+                String.format("%d %d", 1);
+                fail();
+            } catch (MissingFormatArgumentException expected) {
+            }
+            try {
+                String.format("%d", "not a number");
+                fail();
+            } catch (IllegalFormatConversionException expected) {
+            }
+        }
+    }
 }
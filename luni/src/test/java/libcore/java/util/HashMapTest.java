@@ -248,4 +248,59 @@ public class HashMapTest extends junit.framework.TestCase {
             fail();
         } catch(NullPointerException expected) {}
     }
+
+    public void test_putAll_fromHashMap() {
+        HashMap<Object, Integer> source = new HashMap<>();
+        for (int i = 0; i < 1000; i++) {
+            source.put(i, i);
+            // Few distinct hash codes, so some bins are trees.
+            source.put(new CollidingKey(i), i);
+        }
+        source.put(null, -1);
+
+        HashMap<Object, Integer> copy = new HashMap<>(source);
+        assertEquals(source, copy);
+
+        // The copy's insertion order is the source's iteration order.
+        LinkedHashMap<Object, Integer> linked = new LinkedHashMap<>();
+        linked.putAll(source);
+        assertEquals(new ArrayList<>(source.keySet()), new ArrayList<>(linked.keySet()));
+    }
+
+    public void test_putAll_largeIntoNonEmpty() {
+        HashMap<Integer, Integer> map = new HashMap<>();
+        map.put(-1, -1);
+        map.put(0, 100);
+        Map<Integer, Integer> source = new TreeMap<>();
+        for (int i = 0; i < 10000; i++) {
+            source.put(i, i);
+        }
+        map.putAll(source);
+        assertEquals(10001, map.size());
+        assertEquals(Integer.valueOf(-1), map.get(-1));
+        for (int i = 0; i < 10000; i++) {
+            assertEquals(Integer.valueOf(i), map.get(i));
+        }
+    }
+
+    /** A key whose hash code collides with those of many other keys. */
+    private static final class CollidingKey implements Comparable<CollidingKey> {
+        private final int id;
+
+        CollidingKey(int id) {
+            this.id = id;
+        }
+
+        @Override public int hashCode() {
+            return id % 4;
+        }
+
+        @Override public boolean equals(Object o) {
+            return o instanceof CollidingKey && ((CollidingKey) o).id == id;
+        }
+
+        @Override public int compareTo(CollidingKey o) {
+            return Integer.compare(id, o.id);
+        }
+    }
 }
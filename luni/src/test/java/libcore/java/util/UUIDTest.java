@@ -16,7 +16,10 @@
 
 package libcore.java.util;
 
+import java.util.HashSet;
+import java.util.Set;
 import java.util.UUID;
+import java.util.concurrent.ConcurrentHashMap;
 import junit.framework.TestCase;
 
 // There are more tests in the harmony suite:
@@ -50,4 +53,49 @@ public class UUIDTest extends TestCase {
     } catch (IllegalArgumentException expected) { }
   }
 
+  public void testRandomUUID_versionAndVariant() {
+    // More than one block of buffered random bytes.
+    Set<UUID> seen = new HashSet<>();
+    for (int i = 0; i < 1000; i++) {
+      UUID uuid = UUID.randomUUID();
+      assertEquals(4, uuid.version());
+      assertEquals(2, uuid.variant());
+      assertTrue(seen.add(uuid));
+    }
+  }
+
+  public void testRandomUUID_distinctAcrossThreads() throws Exception {
+    final int threadCount = 8;
+    final int perThread = 500;
+    final Set<UUID> seen = ConcurrentHashMap.newKeySet();
+    Thread[] threads = new Thread[threadCount];
+    for (int t = 0; t < threadCount; t++) {
+      threads[t] = new Thread(() -> {
+        for (int i = 0; i < perThread; i++) {
+          seen.add(UUID.randomUUID());
+        }
+      });
+      threads[t].start();
+    }
+    for (Thread thread : threads) {
+      thread.join();
+    }
+    assertEquals(threadCount * perThread, seen.size());
+  }
+
+  public void testRandomUUIDs() {
+    assertEquals(0, UUID.randomUUIDs(0).length);
+    UUID[] uuids = UUID.randomUUIDs(1000);
+    assertEquals(1000, uuids.length);
+    Set<UUID> seen = new HashSet<>();
+    for (UUID uuid : uuids) {
+      assertEquals(4, uuid.version());
+      assertEquals(2, uuid.variant());
+      assertTrue(seen.add(uuid));
+    }
+    try {
+      UUID.randomUUIDs(-1);
+      fail();
+    } catch (IllegalArgumentException expected) { }
+  }
 }
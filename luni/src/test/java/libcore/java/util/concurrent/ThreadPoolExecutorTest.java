@@ -18,9 +18,18 @@ package libcore.java.util.concurrent;
 
 import junit.framework.TestCase;
 
+import java.util.ArrayList;
+import java.util.List;
 import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.Callable;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.Future;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.RejectedExecutionHandler;
 import java.util.concurrent.ThreadPoolExecutor;
 import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReference;
 
 public class ThreadPoolExecutorTest extends TestCase {
 
@@ -37,4 +46,169 @@ public class ThreadPoolExecutorTest extends TestCase {
         tp.setCorePoolSize(5);
         tp.setMaximumPoolSize(5);
     }
+
+    public void testExecuteAll() throws Exception {
+        ThreadPoolExecutor tp = new ThreadPoolExecutor(
+                4, 4, 0, TimeUnit.MILLISECONDS, new LinkedBlockingQueue<>());
+        try {
+            final CountDownLatch done = new CountDownLatch(1000);
+            List<Runnable> tasks = new ArrayList<>();
+            for (int i = 0; i < 1000; i++) {
+                tasks.add(done::countDown);
+            }
+            tp.executeAll(tasks);
+            assertTrue(done.await(10, TimeUnit.SECONDS));
+            assertEquals(4, tp.getPoolSize());
+        } finally {
+            tp.shutdown();
+        }
+    }
+
+    public void testExecuteAll_rejectsWhenQueueIsFull() throws Exception {
+        final AtomicInteger rejected = new AtomicInteger();
+        RejectedExecutionHandler handler = (r, executor) -> rejected.incrementAndGet();
+        ThreadPoolExecutor tp = new ThreadPoolExecutor(
+                1, 1, 0, TimeUnit.MILLISECONDS, new LinkedBlockingQueue<>(2), handler);
+        final CountDownLatch release = new CountDownLatch(1);
+        try {
+            List<Runnable> tasks = new ArrayList<>();
+            tasks.add(() -> {
+                try {
+                    release.await();
+                } catch (InterruptedException ignored) {
+                }
+            });
+            for (int i = 0; i < 4; i++) {
+                tasks.add(() -> {});
+            }
+            tp.executeAll(tasks);
+            // The first task starts the only worker, two are queued.
+            assertEquals(2, tp.getQueue().size());
+            assertEquals(2, rejected.get());
+        } finally {
+            release.countDown();
+            tp.shutdown();
+        }
+    }
+
+    public void testExecuteAll_null() {
+        ThreadPoolExecutor tp = new ThreadPoolExecutor(
+                1, 1, 0, TimeUnit.MILLISECONDS, new LinkedBlockingQueue<>());
+        List<Runnable> tasks = new ArrayList<>();
+        tasks.add(() -> {});
+        tasks.add(null);
+        try {
+            tp.executeAll(tasks);
+            fail();
+        } catch (NullPointerException expected) {
+        } finally {
+            tp.shutdown();
+        }
+        assertEquals(0, tp.getPoolSize());
+    }
+
+    public void testInvokeAllBatched() throws Exception {
+        ThreadPoolExecutor tp = new ThreadPoolExecutor(
+                2, 2, 0, TimeUnit.MILLISECONDS, new LinkedBlockingQueue<>());
+        try {
+            List<Callable<Integer>> tasks = new ArrayList<>();
+            for (int i = 0; i < 100; i++) {
+                final int value = i;
+                tasks.add(() -> value * value);
+            }
+            List<Future<Integer>> futures = tp.invokeAllBatched(tasks);
+            assertEquals(100, futures.size());
+            for (int i = 0; i < 100; i++) {
+                assertTrue(futures.get(i).isDone());
+                assertEquals(i * i, (int) futures.get(i).get());
+            }
+        } finally {
+            tp.shutdown();
+        }
+    }
+
+    public void testLocalQueues_selfSpawningTasks() throws Exception {
+        ThreadPoolExecutor tp = new ThreadPoolExecutor(
+                4, 4, 0, TimeUnit.MILLISECONDS, new LinkedBlockingQueue<>());
+        tp.allowLocalQueues(true);
+        assertTrue(tp.allowsLocalQueues());
+        try {
+            // A binary tree of tasks of depth 12 has 2^13 - 1 nodes.
+            CountDownLatch done = new CountDownLatch((1 << 13) - 1);
+            tp.execute(new SpawningTask(tp, done, 12));
+            assertTrue(done.await(10, TimeUnit.SECONDS));
+        } finally {
+            tp.shutdown();
+        }
+        assertTrue(tp.awaitTermination(10, TimeUnit.SECONDS));
+        assertEquals((1 << 13) - 1, tp.getCompletedTaskCount());
+    }
+
+    public void testLocalQueues_shutdownNowReturnsLocalTasks() throws Exception {
+        final ThreadPoolExecutor tp = new ThreadPoolExecutor(
+                1, 1, 0, TimeUnit.MILLISECONDS, new LinkedBlockingQueue<>());
+        tp.allowLocalQueues(true);
+        final AtomicReference<List<Runnable>> notRun = new AtomicReference<>();
+        final AtomicInteger queueSize = new AtomicInteger(-1);
+        final AtomicInteger ran = new AtomicInteger();
+        tp.execute(() -> {
+            // The only worker is busy, so these are queued locally.
+            for (int i = 0; i < 3; i++) {
+                tp.execute(ran::incrementAndGet);
+            }
+            queueSize.set(tp.getQueue().size());
+            notRun.set(tp.shutdownNow());
+        });
+        assertTrue(tp.awaitTermination(10, TimeUnit.SECONDS));
+        assertEquals(0, queueSize.get());
+        assertEquals(3, notRun.get().size());
+        assertEquals(0, ran.get());
+    }
+
+    public void testLocalQueues_sharedTasksAreNotStarved() throws Exception {
+        final ThreadPoolExecutor tp = new ThreadPoolExecutor(
+                1, 1, 0, TimeUnit.MILLISECONDS, new LinkedBlockingQueue<>());
+        tp.allowLocalQueues(true);
+        final CountDownLatch started = new CountDownLatch(1);
+        final CountDownLatch sharedRan = new CountDownLatch(1);
+        try {
+            // A task that keeps resubmitting itself to the local queue of
+            // the only worker until the shared task has run.
+            tp.execute(new Runnable() {
+                @Override public void run() {
+                    started.countDown();
+                    if (sharedRan.getCount() != 0) {
+                        tp.execute(this);
+                    }
+                }
+            });
+            assertTrue(started.await(10, TimeUnit.SECONDS));
+            tp.execute(sharedRan::countDown);
+            assertTrue(sharedRan.await(10, TimeUnit.SECONDS));
+        } finally {
+            tp.shutdown();
+        }
+        assertTrue(tp.awaitTermination(10, TimeUnit.SECONDS));
+    }
+
+    /** Counts down, then submits two children until the depth is exhausted. */
+    private static class SpawningTask implements Runnable {
+        private final ThreadPoolExecutor tp;
+        private final CountDownLatch done;
+        private final int depth;
+
+        SpawningTask(ThreadPoolExecutor tp, CountDownLatch done, int depth) {
+            this.tp = tp;
+            this.done = done;
+            this.depth = depth;
+        }
+
+        @Override public void run() {
+            if (depth > 0) {
+                tp.execute(new SpawningTask(tp, done, depth - 1));
+                tp.execute(new SpawningTask(tp, done, depth - 1));
+            }
+            done.countDown();
+        }
+    }
 }
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License
+ */
+
+package libcore.java.util.concurrent;
+
+import junit.framework.TestCase;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledFuture;
+import java.util.concurrent.ScheduledThreadPoolExecutor;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Tests ScheduledThreadPoolExecutor with its timing wheel work queue.
+ */
+public class TimingWheelScheduledThreadPoolExecutorTest extends TestCase {
+
+    private ScheduledThreadPoolExecutor executor;
+
+    @Override
+    protected void setUp() {
+        executor = new ScheduledThreadPoolExecutor(1, Executors.defaultThreadFactory(),
+                new ThreadPoolExecutor.AbortPolicy(), 1, TimeUnit.MILLISECONDS);
+    }
+
+    @Override
+    protected void tearDown() throws Exception {
+        executor.shutdownNow();
+        assertTrue(executor.awaitTermination(10, TimeUnit.SECONDS));
+    }
+
+    public void testRunsInDelayOrderAndNotEarly() throws Exception {
+        final int count = 20;
+        final List<Integer> order = Collections.synchronizedList(new ArrayList<Integer>());
+        final CountDownLatch done = new CountDownLatch(count);
+        final AtomicInteger early = new AtomicInteger();
+        // Schedule in reverse order, 10ms apart.
+        for (int i = count - 1; i >= 0; i--) {
+            final int index = i;
+            final long delayMillis = 10 * i;
+            final long scheduled = System.nanoTime();
+            executor.schedule(new Runnable() {
+                @Override
+                public void run() {
+                    if (System.nanoTime() - scheduled < TimeUnit.MILLISECONDS.toNanos(delayMillis)) {
+                        early.incrementAndGet();
+                    }
+                    order.add(index);
+                    done.countDown();
+                }
+            }, delayMillis, TimeUnit.MILLISECONDS);
+        }
+        assertTrue(done.await(10, TimeUnit.SECONDS));
+        assertEquals(0, early.get());
+        for (int i = 0; i < count; i++) {
+            assertEquals(Integer.valueOf(i), order.get(i));
+        }
+    }
+
+    public void testCancelRemovesFromQueue() throws Exception {
+        executor.setRemoveOnCancelPolicy(true);
+        List<ScheduledFuture<?>> futures = new ArrayList<>();
+        for (int i = 0; i < 10000; i++) {
+            futures.add(executor.schedule(new Runnable() {
+                @Override
+                public void run() {
+                    fail();
+                }
+            }, 1 + (i % 3600), TimeUnit.SECONDS));
+        }
+        assertEquals(10000, executor.getQueue().size());
+        for (ScheduledFuture<?> future : futures) {
+            assertTrue(future.cancel(false));
+        }
+        assertEquals(0, executor.getQueue().size());
+        assertTrue(executor.getQueue().isEmpty());
+    }
+
+    public void testRemoveAndContains() throws Exception {
+        ScheduledFuture<?> future = executor.schedule(new Runnable() {
+            @Override
+            public void run() {}
+        }, 1, TimeUnit.HOURS);
+        assertTrue(executor.getQueue().contains(future));
+        assertTrue(executor.remove((Runnable) future));
+        assertFalse(executor.getQueue().contains(future));
+        assertFalse(executor.remove((Runnable) future));
+    }
+
+    public void testPeriodic() throws Exception {
+        final CountDownLatch ran = new CountDownLatch(5);
+        ScheduledFuture<?> future = executor.scheduleAtFixedRate(new Runnable() {
+            @Override
+            public void run() {
+                ran.countDown();
+            }
+        }, 0, 5, TimeUnit.MILLISECONDS);
+        assertTrue(ran.await(10, TimeUnit.SECONDS));
+        future.cancel(false);
+    }
+
+    public void testVeryLongDelays() throws Exception {
+        executor.schedule(new Runnable() {
+            @Override
+            public void run() {}
+        }, Long.MAX_VALUE, TimeUnit.NANOSECONDS);
+        executor.schedule(new Runnable() {
+            @Override
+            public void run() {}
+        }, 1000, TimeUnit.DAYS);
+        final CountDownLatch ran = new CountDownLatch(1);
+        executor.schedule(new Runnable() {
+            @Override
+            public void run() {
+                ran.countDown();
+            }
+        }, 1, TimeUnit.MILLISECONDS);
+        assertTrue(ran.await(10, TimeUnit.SECONDS));
+        assertEquals(2, executor.getQueue().size());
+        assertEquals(2, executor.shutdownNow().size());
+    }
+
+    public void testConcurrentScheduling() throws Exception {
+        final int threadCount = 8;
+        final int perThread = 500;
+        final CountDownLatch done = new CountDownLatch(threadCount * perThread);
+        Thread[] threads = new Thread[threadCount];
+        for (int t = 0; t < threadCount; t++) {
+            threads[t] = new Thread(new Runnable() {
+                @Override
+                public void run() {
+                    for (int i = 0; i < perThread; i++) {
+                        executor.schedule(new Runnable() {
+                            @Override
+                            public void run() {
+                                done.countDown();
+                            }
+                        }, i % 20, TimeUnit.MILLISECONDS);
+                    }
+                }
+            });
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+        assertTrue(done.await(10, TimeUnit.SECONDS));
+    }
+
+    public void testInvalidTick() {
+        try {
+            new ScheduledThreadPoolExecutor(1, Executors.defaultThreadFactory(),
+                    new ThreadPoolExecutor.AbortPolicy(), 0, TimeUnit.MILLISECONDS);
+            fail();
+        } catch (IllegalArgumentException expected) {
+        }
+    }
+}
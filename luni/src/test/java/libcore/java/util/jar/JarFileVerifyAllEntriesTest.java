@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.java.util.jar;
+
+import java.io.File;
+import java.io.InputStream;
+import java.security.CodeSigner;
+import java.util.Arrays;
+import java.util.jar.JarEntry;
+import java.util.jar.JarFile;
+import junit.framework.TestCase;
+import tests.support.resource.Support_Resources;
+
+public class JarFileVerifyAllEntriesTest extends TestCase {
+
+    private static final String SIGNED_JAR = "hyts_signed.jar";
+    private static final String SIGNED_ENTRY = "coucou/FileAccess.class";
+    private static final String TAMPERED_JAR = "hyts_signed_inc.jar";
+
+    private File resources;
+
+    @Override public void setUp() throws Exception {
+        super.setUp();
+        resources = Support_Resources.createTempFolder();
+    }
+
+    public void testVerifyAllEntries() throws Exception {
+        File signedFile = Support_Resources.copyFile(resources, null, SIGNED_JAR);
+        CodeSigner[] signers;
+        try (JarFile jar = new JarFile(signedFile)) {
+            jar.verifyAllEntries(4);
+            // The entry was verified without being read.
+            signers = jar.getJarEntry(SIGNED_ENTRY).getCodeSigners();
+            assertNotNull(signers);
+            assertTrue(signers.length > 0);
+        }
+
+        // The same file is recognized when it is opened again, and reading an
+        // entry produces the same signers.
+        try (JarFile jar = new JarFile(signedFile)) {
+            JarEntry entry = jar.getJarEntry(SIGNED_ENTRY);
+            readFully(jar.getInputStream(entry));
+            assertTrue(Arrays.equals(signers, entry.getCodeSigners()));
+            jar.verifyAllEntries(1);
+        }
+    }
+
+    public void testVerifyAllEntries_thenReadEntries() throws Exception {
+        File signedFile = Support_Resources.copyFile(resources, null, SIGNED_JAR);
+        try (JarFile jar = new JarFile(signedFile)) {
+            jar.verifyAllEntries(2);
+            CodeSigner[] verified = jar.getJarEntry(SIGNED_ENTRY).getCodeSigners();
+            assertNotNull(verified);
+
+            // Entries read after verifyAllEntries keep the signers it found.
+            JarEntry entry = jar.getJarEntry(SIGNED_ENTRY);
+            readFully(jar.getInputStream(entry));
+            assertTrue(Arrays.equals(verified, entry.getCodeSigners()));
+        }
+    }
+
+    public void testVerifyAllEntries_matchesStreamingVerification() throws Exception {
+        File streamedFile = Support_Resources.copyFile(resources, null, SIGNED_JAR);
+        CodeSigner[] streamed;
+        try (JarFile jar = new JarFile(streamedFile)) {
+            JarEntry entry = jar.getJarEntry(SIGNED_ENTRY);
+            readFully(jar.getInputStream(entry));
+            streamed = entry.getCodeSigners();
+        }
+
+        File parallelDir = new File(resources, "parallel");
+        parallelDir.mkdirs();
+        File parallelFile = Support_Resources.copyFile(parallelDir, null, SIGNED_JAR);
+        try (JarFile jar = new JarFile(parallelFile)) {
+            jar.verifyAllEntries(2);
+            CodeSigner[] parallel = jar.getJarEntry(SIGNED_ENTRY).getCodeSigners();
+            assertEquals(streamed.length, parallel.length);
+            for (int i = 0; i < streamed.length; i++) {
+                assertEquals(streamed[i].getSignerCertPath(), parallel[i].getSignerCertPath());
+            }
+        }
+    }
+
+    public void testVerifyAllEntries_tampered() throws Exception {
+        File tamperedFile = Support_Resources.copyFile(resources, null, TAMPERED_JAR);
+        try (JarFile jar = new JarFile(tamperedFile)) {
+            jar.verifyAllEntries(4);
+            fail();
+        } catch (SecurityException expected) {
+        }
+    }
+
+    public void testVerifyAllEntries_unverifiedJar() throws Exception {
+        File signedFile = Support_Resources.copyFile(resources, null, SIGNED_JAR);
+        try (JarFile jar = new JarFile(signedFile, false /* verify */)) {
+            jar.verifyAllEntries(4);
+            assertNull(jar.getJarEntry(SIGNED_ENTRY).getCodeSigners());
+        }
+    }
+
+    public void testVerifyAllEntries_invalidParallelism() throws Exception {
+        File signedFile = Support_Resources.copyFile(resources, null, SIGNED_JAR);
+        try (JarFile jar = new JarFile(signedFile)) {
+            jar.verifyAllEntries(0);
+            fail();
+        } catch (IllegalArgumentException expected) {
+        }
+    }
+
+    private static void readFully(InputStream in) throws Exception {
+        byte[] buffer = new byte[1024];
+        while (in.read(buffer) != -1) {
+        }
+        in.close();
+    }
+}
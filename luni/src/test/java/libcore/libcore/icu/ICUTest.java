@@ -20,6 +20,7 @@ import java.text.BreakIterator;
 import java.text.Collator;
 import java.util.Arrays;
 import java.util.Locale;
+import java.util.concurrent.atomic.AtomicInteger;
 import libcore.icu.ICU;
 
 public class ICUTest extends junit.framework.TestCase {
@@ -53,6 +54,64 @@ public class ICUTest extends junit.framework.TestCase {
     assertEquals("M月d日", ICU.getBestDateTimePattern("MMMMd", new Locale("ja", "JP")));
   }
 
+  public void test_getBestDateTimePattern_concurrent() throws Exception {
+    // More locales than the generators cached natively, and more patterns than cached in Java.
+    final Locale[] locales = {
+        Locale.US, Locale.GERMANY, Locale.FRANCE, Locale.JAPAN, new Locale("es", "ES"),
+        new Locale("fa", "IR"), new Locale("ca", "ES"), new Locale("de", "CH"),
+    };
+    final String[] skeletons = { "MMMMd", "yMMMd", "yMd", "Hm", "hm", "MMMEd", "yMMMMEEEEd" };
+    final String[][] expected = new String[locales.length][skeletons.length];
+    for (int l = 0; l < locales.length; l++) {
+      for (int s = 0; s < skeletons.length; s++) {
+        expected[l][s] = ICU.getBestDateTimePattern(skeletons[s], locales[l]);
+        assertNotNull(expected[l][s]);
+      }
+    }
+
+    final AtomicInteger failures = new AtomicInteger();
+    Thread[] threads = new Thread[8];
+    for (int t = 0; t < threads.length; t++) {
+      final int seed = t;
+      threads[t] = new Thread(() -> {
+        for (int i = 0; i < 500; i++) {
+          int l = (i + seed) % locales.length;
+          int s = (i * 3 + seed) % skeletons.length;
+          if (!expected[l][s].equals(ICU.getBestDateTimePattern(skeletons[s], locales[l]))) {
+            failures.incrementAndGet();
+          }
+        }
+      });
+      threads[t].start();
+    }
+    for (Thread thread : threads) {
+      thread.join();
+    }
+    assertEquals(0, failures.get());
+  }
+
+  public void test_getBestDateTimePattern_afterDefaultLocaleChange() throws Exception {
+    String initialDefaultLocale = ICU.getDefaultLocale();
+    try {
+      ICU.setDefaultLocale("en-US");
+      assertEquals("MMMM d", ICU.getBestDateTimePattern("MMMMd", Locale.US));
+      assertEquals("d. MMMM", ICU.getBestDateTimePattern("MMMMd", new Locale("de", "CH")));
+
+      ICU.setDefaultLocale("de-CH");
+      assertEquals("MMMM d", ICU.getBestDateTimePattern("MMMMd", Locale.US));
+      assertEquals("d. MMMM", ICU.getBestDateTimePattern("MMMMd", new Locale("de", "CH")));
+
+      // ICU has no data for this locale, so its patterns come from the default locale's data.
+      final Locale unrecognizedLocale = new Locale("xy", "KR");
+      ICU.setDefaultLocale("en-US");
+      assertEquals("MMMM d", ICU.getBestDateTimePattern("MMMMd", unrecognizedLocale));
+      ICU.setDefaultLocale("de-CH");
+      assertEquals("d. MMMM", ICU.getBestDateTimePattern("MMMMd", unrecognizedLocale));
+    } finally {
+      ICU.setDefaultLocale(initialDefaultLocale);
+    }
+  }
+
   public void test_localeFromString() throws Exception {
     // localeFromString is pretty lenient. Some of these can't be round-tripped
     // through Locale.toString.
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.libcore.internal;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import junit.framework.TestCase;
+import libcore.internal.ConcurrentStringPool;
+
+public final class ConcurrentStringPoolTest extends TestCase {
+
+    public void testGet() {
+        ConcurrentStringPool pool = new ConcurrentStringPool();
+        String bcd = pool.get(new char[] { 'a', 'b', 'c', 'd', 'e' }, 1, 3);
+        assertEquals("bcd", bcd);
+        assertSame(bcd, pool.get(new char[] { 'a', 'b', 'c', 'd', 'e' }, 1, 3));
+        assertEquals("", pool.get(new char[0], 0, 0));
+    }
+
+    public void testHashCollisionRetainsBothStrings() {
+        ConcurrentStringPool pool = new ConcurrentStringPool();
+        char[] a = { (char) 1, (char) 0 };
+        char[] b = { (char) 0, (char) 31 };
+        assertEquals(new String(a).hashCode(), new String(b).hashCode());
+
+        String aString = pool.get(a, 0, 2);
+        assertEquals(new String(a), aString);
+        String bString = pool.get(b, 0, 2);
+        assertEquals(new String(b), bString);
+        assertSame(aString, pool.get(a, 0, 2));
+        assertSame(bString, pool.get(b, 0, 2));
+    }
+
+    public void testBucketIsBounded() {
+        // A single bucket holding two strings: the oldest is dropped.
+        ConcurrentStringPool pool = new ConcurrentStringPool(1, 2);
+        String a = pool.get("a".toCharArray(), 0, 1);
+        String b = pool.get("b".toCharArray(), 0, 1);
+        String c = pool.get("c".toCharArray(), 0, 1);
+        assertSame(b, pool.get("b".toCharArray(), 0, 1));
+        assertSame(c, pool.get("c".toCharArray(), 0, 1));
+        String a2 = pool.get("a".toCharArray(), 0, 1);
+        assertEquals(a, a2);
+        assertNotSame(a, a2);
+    }
+
+    public void testInvalidArguments() {
+        try {
+            new ConcurrentStringPool(0, 1);
+            fail();
+        } catch (IllegalArgumentException expected) {
+        }
+        try {
+            new ConcurrentStringPool(16, 0);
+            fail();
+        } catch (IllegalArgumentException expected) {
+        }
+    }
+
+    public void testConcurrentGet() throws Exception {
+        final ConcurrentStringPool pool = new ConcurrentStringPool(64, 8);
+        ExecutorService executor = Executors.newFixedThreadPool(4);
+        try {
+            List<Future<Void>> futures = new ArrayList<>();
+            for (int t = 0; t < 4; t++) {
+                futures.add(executor.submit(new Callable<Void>() {
+                    @Override public Void call() {
+                        for (int i = 0; i < 10000; i++) {
+                            char[] chars = ("name" + (i % 300)).toCharArray();
+                            assertEquals(new String(chars), pool.get(chars, 0, chars.length));
+                        }
+                        return null;
+                    }
+                }));
+            }
+            for (Future<Void> future : futures) {
+                future.get();
+            }
+        } finally {
+            executor.shutdown();
+        }
+    }
+}
@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.libcore.util;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.atomic.AtomicInteger;
+import junit.framework.TestCase;
+
+import libcore.util.ConcurrentLruCache;
+
+public final class ConcurrentLruCacheTest extends TestCase {
+
+    public void testCreateOnCacheMiss() {
+        ConcurrentLruCache<String, String> cache = newCreatingCache();
+        String created = cache.get("aa");
+        assertEquals("created-aa", created);
+        assertSnapshot(cache, "aa", "created-aa");
+    }
+
+    public void testNoCreateOnCacheHit() {
+        ConcurrentLruCache<String, String> cache = newCreatingCache();
+        cache.put("aa", "put-aa");
+        assertEquals("put-aa", cache.get("aa"));
+    }
+
+    public void testNullCreateIsNotCached() {
+        ConcurrentLruCache<String, String> cache = newCreatingCache();
+        assertNull(cache.get("a"));
+        assertSnapshot(cache);
+    }
+
+    public void testConstructorDoesNotAllowZeroCacheSize() {
+        try {
+            new ConcurrentLruCache<String, String>(0);
+            fail();
+        } catch (IllegalArgumentException expected) {
+        }
+    }
+
+    public void testCannotPutNullKeyOrValue() {
+        ConcurrentLruCache<String, String> cache = new ConcurrentLruCache<String, String>(3);
+        try {
+            cache.put(null, "A");
+            fail();
+        } catch (NullPointerException expected) {
+        }
+        try {
+            cache.put("a", null);
+            fail();
+        } catch (NullPointerException expected) {
+        }
+        try {
+            cache.get(null);
+            fail();
+        } catch (NullPointerException expected) {
+        }
+    }
+
+    public void testEvictionWithSingletonCache() {
+        ConcurrentLruCache<String, String> cache = new ConcurrentLruCache<String, String>(1);
+        cache.put("a", "A");
+        cache.get("a");
+        cache.put("b", "B");
+        assertSnapshot(cache, "b", "B");
+    }
+
+    public void testEntryEvictedWhenFull() {
+        List<String> evictionLog = new ArrayList<String>();
+        ConcurrentLruCache<String, String> cache = newLoggingCache(3, evictionLog);
+
+        cache.put("a", "A");
+        cache.put("b", "B");
+        cache.put("c", "C");
+        assertEquals(Arrays.asList(), evictionLog);
+
+        cache.put("d", "D");
+        assertEquals(Arrays.asList("a=A"), evictionLog);
+    }
+
+    public void testReadEntryGetsSecondChance() {
+        List<String> evictionLog = new ArrayList<String>();
+        ConcurrentLruCache<String, String> cache = newLoggingCache(3, evictionLog);
+
+        cache.put("a", "A");
+        cache.put("b", "B");
+        cache.put("c", "C");
+        cache.get("a");
+        cache.put("d", "D");
+        assertEquals(Arrays.asList("b=B"), evictionLog);
+        assertSnapshot(cache, "c", "C", "d", "D", "a", "A");
+
+        // The second chance is used up.
+        cache.put("e", "E");
+        cache.put("f", "F");
+        cache.put("g", "G");
+        assertEquals(Arrays.asList("b=B", "c=C", "d=D", "a=A"), evictionLog);
+    }
+
+    public void testPutDoesNotCauseEviction() {
+        List<String> evictionLog = new ArrayList<String>();
+        ConcurrentLruCache<String, String> cache = newLoggingCache(3, evictionLog);
+
+        cache.put("a", "A");
+        cache.put("b", "B");
+        cache.put("c", "C");
+        assertEquals("B", cache.put("b", "B2"));
+        assertEquals(Arrays.asList(), evictionLog);
+        assertSnapshot(cache, "a", "A", "c", "C", "b", "B2");
+        assertEquals(3, cache.size());
+    }
+
+    public void testRepeatedPutsKeepSize() {
+        ConcurrentLruCache<String, String> cache = new ConcurrentLruCache<String, String>(2);
+        for (int i = 0; i < 1000; i++) {
+            cache.put("a", "A" + i);
+            cache.put("b", "B" + i);
+        }
+        assertSnapshot(cache, "a", "A999", "b", "B999");
+        assertEquals(2, cache.size());
+    }
+
+    public void testEvictAll() {
+        List<String> evictionLog = new ArrayList<String>();
+        ConcurrentLruCache<String, String> cache = newLoggingCache(10, evictionLog);
+
+        cache.put("a", "A");
+        cache.put("b", "B");
+        cache.put("c", "C");
+        cache.get("b");
+        cache.evictAll();
+        assertSnapshot(cache);
+        assertEquals(0, cache.size());
+        assertEquals(Arrays.asList("a=A", "b=B", "c=C"), evictionLog);
+    }
+
+    public void testSizeOf() {
+        List<String> evictionLog = new ArrayList<String>();
+        ConcurrentLruCache<String, String> cache = new ConcurrentLruCache<String, String>(10) {
+            @Override protected int sizeOf(String key, String value) {
+                return value.length();
+            }
+
+            @Override protected void entryEvicted(String key, String value) {
+                evictionLog.add(key + "=" + value);
+            }
+        };
+
+        cache.put("a", "AAAA");
+        cache.put("b", "BBBB");
+        assertEquals(8, cache.size());
+        cache.put("c", "CCC");
+        assertEquals(Arrays.asList("a=AAAA"), evictionLog);
+        assertEquals(7, cache.size());
+        cache.put("d", "DDDDDDDDDDD");
+        assertEquals(Arrays.asList("a=AAAA", "b=BBBB", "c=CCC", "d=DDDDDDDDDDD"), evictionLog);
+        assertEquals(0, cache.size());
+    }
+
+    public void testStatistics() {
+        ConcurrentLruCache<String, String> cache = new ConcurrentLruCache<String, String>(1, true) {
+            @Override protected String create(String key) {
+                return "created-" + key;
+            }
+        };
+        cache.get("a");
+        cache.get("a");
+        cache.get("a");
+        cache.get("b");
+        assertEquals(2, cache.hitCount());
+        assertEquals(2, cache.missCount());
+        assertEquals(1, cache.evictionCount());
+
+        ConcurrentLruCache<String, String> noStats = newCreatingCache();
+        noStats.get("aa");
+        noStats.get("aa");
+        assertEquals(0, noStats.hitCount());
+        assertEquals(0, noStats.missCount());
+    }
+
+    public void testCreateFailureIsNotCached() {
+        AtomicInteger calls = new AtomicInteger();
+        ConcurrentLruCache<String, String> cache = new ConcurrentLruCache<String, String>(3) {
+            @Override protected String create(String key) {
+                if (calls.getAndIncrement() == 0) {
+                    throw new IllegalStateException();
+                }
+                return "created-" + key;
+            }
+        };
+        try {
+            cache.get("a");
+            fail();
+        } catch (IllegalStateException expected) {
+        }
+        assertEquals("created-a", cache.get("a"));
+        assertEquals(2, calls.get());
+    }
+
+    public void testConcurrentMissesCreateOnce() throws Exception {
+        final int threadCount = 8;
+        CountDownLatch creating = new CountDownLatch(1);
+        CountDownLatch release = new CountDownLatch(1);
+        AtomicInteger calls = new AtomicInteger();
+        ConcurrentLruCache<String, Object> cache = new ConcurrentLruCache<String, Object>(3) {
+            @Override protected Object create(String key) {
+                calls.incrementAndGet();
+                creating.countDown();
+                try {
+                    release.await();
+                } catch (InterruptedException e) {
+                    throw new AssertionError(e);
+                }
+                return new Object();
+            }
+        };
+
+        Object[] results = new Object[threadCount];
+        Thread[] threads = new Thread[threadCount];
+        for (int i = 0; i < threadCount; i++) {
+            final int index = i;
+            threads[i] = new Thread(() -> results[index] = cache.get("a"));
+            threads[i].start();
+        }
+        creating.await();
+        // Give the other threads time to miss and wait for the value.
+        Thread.sleep(100);
+        release.countDown();
+        for (Thread thread : threads) {
+            thread.join();
+        }
+
+        assertEquals(1, calls.get());
+        for (Object result : results) {
+            assertSame(results[0], result);
+        }
+    }
+
+    public void testConcurrentReadsAndWrites() throws Exception {
+        final int threadCount = 4;
+        final ConcurrentLruCache<Integer, Integer> cache =
+                new ConcurrentLruCache<Integer, Integer>(64) {
+            @Override protected Integer create(Integer key) {
+                return key * 2;
+            }
+        };
+        Thread[] threads = new Thread[threadCount];
+        AtomicInteger failures = new AtomicInteger();
+        for (int t = 0; t < threadCount; t++) {
+            final int seed = t;
+            threads[t] = new Thread(() -> {
+                for (int i = 0; i < 10000; i++) {
+                    int key = (i * 31 + seed) % 200;
+                    if (cache.get(key) != key * 2) {
+                        failures.incrementAndGet();
+                    }
+                    if (i % 10 == 0) {
+                        cache.put(key, key * 2);
+                    }
+                }
+            });
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+        assertEquals(0, failures.get());
+        assertTrue(cache.size() <= 64);
+        assertEquals(cache.size(), cache.snapshot().size());
+    }
+
+    private ConcurrentLruCache<String, String> newCreatingCache() {
+        return new ConcurrentLruCache<String, String>(3) {
+            @Override protected String create(String key) {
+                return (key.length() > 1) ? ("created-" + key) : null;
+            }
+        };
+    }
+
+    private ConcurrentLruCache<String, String> newLoggingCache(
+            int maxSize, final List<String> evictionLog) {
+        return new ConcurrentLruCache<String, String>(maxSize) {
+            @Override protected void entryEvicted(String key, String value) {
+                evictionLog.add(key + "=" + value);
+            }
+        };
+    }
+
+    private <T> void assertSnapshot(ConcurrentLruCache<T, T> cache, T... keysAndValues) {
+        List<T> actualKeysAndValues = new ArrayList<T>();
+        for (Map.Entry<T, T> entry : cache.snapshot().entrySet()) {
+            actualKeysAndValues.add(entry.getKey());
+            actualKeysAndValues.add(entry.getValue());
+        }
+
+        // assert using lists because order is important
+        assertEquals(Arrays.asList(keysAndValues), actualKeysAndValues);
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.libcore.util;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Random;
+import junit.framework.TestCase;
+
+import libcore.util.IntHashMap;
+
+public final class IntHashMapTest extends TestCase {
+
+    public void testPutGetRemove() {
+        IntHashMap<String> map = new IntHashMap<>();
+        assertTrue(map.isEmpty());
+        assertNull(map.put(1, "one"));
+        assertNull(map.put(-1, "minus one"));
+        assertEquals("one", map.put(1, "uno"));
+        assertEquals("uno", map.get(1));
+        assertEquals("minus one", map.get(-1));
+        assertNull(map.get(2));
+        assertEquals(2, map.size());
+
+        assertEquals("uno", map.remove(1));
+        assertNull(map.remove(1));
+        assertFalse(map.containsKey(1));
+        assertEquals(1, map.size());
+    }
+
+    public void testZeroKey() {
+        IntHashMap<String> map = new IntHashMap<>();
+        assertFalse(map.containsKey(0));
+        assertNull(map.put(0, "zero"));
+        assertTrue(map.containsKey(0));
+        assertEquals("zero", map.get(0));
+        assertEquals(1, map.size());
+        assertEquals("zero", map.remove(0));
+        assertFalse(map.containsKey(0));
+        assertTrue(map.isEmpty());
+    }
+
+    public void testNullValues() {
+        IntHashMap<String> map = new IntHashMap<>();
+        map.put(5, null);
+        assertTrue(map.containsKey(5));
+        assertNull(map.get(5));
+        assertEquals(1, map.size());
+    }
+
+    public void testKeysAndForEach() {
+        IntHashMap<Integer> map = new IntHashMap<>(4);
+        for (int i = -50; i < 50; i++) {
+            map.put(i, i * 2);
+        }
+        int[] keys = map.keys();
+        Arrays.sort(keys);
+        assertEquals(100, keys.length);
+        for (int i = 0; i < 100; i++) {
+            assertEquals(i - 50, keys[i]);
+        }
+        final List<Integer> visited = new ArrayList<>();
+        map.forEach((value, key) -> {
+            assertEquals(key * 2, (int) value);
+            visited.add(key);
+        });
+        assertEquals(100, visited.size());
+    }
+
+    public void testClear() {
+        IntHashMap<String> map = new IntHashMap<>();
+        map.put(0, "zero");
+        map.put(7, "seven");
+        map.clear();
+        assertTrue(map.isEmpty());
+        assertNull(map.get(0));
+        assertNull(map.get(7));
+        map.put(7, "seven");
+        assertEquals("seven", map.get(7));
+    }
+
+    public void testNegativeExpectedSize() {
+        try {
+            new IntHashMap<String>(-1);
+            fail();
+        } catch (IllegalArgumentException expected) {
+        }
+    }
+
+    // Removals shift entries back within probe sequences; check that every
+    // remaining entry is still found.
+    public void testRandomOperations() {
+        Random random = new Random(42);
+        for (int range : new int[] { 16, 1000, Integer.MAX_VALUE }) {
+            IntHashMap<Integer> map = new IntHashMap<>();
+            Map<Integer, Integer> expected = new HashMap<>();
+            for (int i = 0; i < 20000; i++) {
+                int key = random.nextInt(range) - range / 2;
+                int value = random.nextInt();
+                int op = random.nextInt(10);
+                if (op < 5) {
+                    assertEquals(expected.put(key, value), map.put(key, value));
+                } else if (op < 8) {
+                    assertEquals(expected.remove(key), map.remove(key));
+                } else {
+                    assertEquals(expected.get(key), map.get(key));
+                }
+                assertEquals(expected.size(), map.size());
+            }
+            for (Map.Entry<Integer, Integer> entry : expected.entrySet()) {
+                assertEquals(entry.getValue(), map.get(entry.getKey()));
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.libcore.util;
+
+import java.util.Arrays;
+import java.util.HashSet;
+import java.util.Random;
+import java.util.Set;
+import junit.framework.TestCase;
+
+import libcore.util.IntHashSet;
+
+public final class IntHashSetTest extends TestCase {
+
+    public void testAddContainsRemove() {
+        IntHashSet set = new IntHashSet();
+        assertTrue(set.isEmpty());
+        assertTrue(set.add(3));
+        assertFalse(set.add(3));
+        assertTrue(set.add(0));
+        assertTrue(set.add(-3));
+        assertEquals(3, set.size());
+        assertTrue(set.contains(0));
+        assertTrue(set.contains(-3));
+        assertFalse(set.contains(4));
+
+        assertTrue(set.remove(0));
+        assertFalse(set.remove(0));
+        assertTrue(set.remove(3));
+        assertEquals(1, set.size());
+        assertFalse(set.contains(3));
+    }
+
+    public void testToArrayAndForEach() {
+        IntHashSet set = new IntHashSet();
+        for (int i = -20; i < 20; i++) {
+            set.add(i);
+        }
+        int[] elements = set.toArray();
+        Arrays.sort(elements);
+        assertEquals(40, elements.length);
+        for (int i = 0; i < 40; i++) {
+            assertEquals(i - 20, elements[i]);
+        }
+        final int[] sum = new int[1];
+        set.forEach(value -> sum[0] += value);
+        assertEquals(-20, sum[0]);
+
+        set.clear();
+        assertTrue(set.isEmpty());
+        assertEquals(0, set.toArray().length);
+    }
+
+    public void testRandomOperations() {
+        Random random = new Random(42);
+        IntHashSet set = new IntHashSet();
+        Set<Integer> expected = new HashSet<>();
+        for (int i = 0; i < 20000; i++) {
+            int value = random.nextInt(2000) - 1000;
+            int op = random.nextInt(10);
+            if (op < 5) {
+                assertEquals(expected.add(value), set.add(value));
+            } else if (op < 8) {
+                assertEquals(expected.remove(value), set.remove(value));
+            } else {
+                assertEquals(expected.contains(value), set.contains(value));
+            }
+            assertEquals(expected.size(), set.size());
+        }
+        for (int value : expected) {
+            assertTrue(set.contains(value));
+        }
+    }
+}
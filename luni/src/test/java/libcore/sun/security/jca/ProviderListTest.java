@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.sun.security.jca;
+
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.JUnit4;
+
+import java.security.Provider;
+import java.security.Provider.Service;
+import java.util.List;
+
+import sun.security.jca.ProviderList;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * Tests that ProviderList's lookups, which are indexed once all providers are loaded,
+ * reflect the current services of its providers.
+ */
+@RunWith(JUnit4.class)
+public class ProviderListTest {
+
+    private static class TestProvider extends Provider {
+        TestProvider(String name) {
+            super(name, 1.0, "Test provider");
+        }
+    }
+
+    @Test
+    public void getService_precedenceAndAliases() {
+        Provider first = new TestProvider("First");
+        first.put("MessageDigest.FOO", "first.Foo");
+        first.put("Alg.Alias.MessageDigest.BAR", "FOO");
+        Provider second = new TestProvider("Second");
+        second.put("MessageDigest.FOO", "second.Foo");
+        second.put("MessageDigest.BAZ", "second.Baz");
+        ProviderList list = ProviderList.newList(first, second);
+
+        for (int i = 0; i < 2; i++) {
+            assertEquals("first.Foo", list.getService("MessageDigest", "foo").getClassName());
+            assertEquals("first.Foo", list.getService("MessageDigest", "Bar").getClassName());
+            assertEquals("second.Baz", list.getService("MessageDigest", "BAZ").getClassName());
+            assertNull(list.getService("MessageDigest", "Qux"));
+            assertNull(list.getService("Signature", "FOO"));
+
+            List<Service> services = list.getServices("MessageDigest", "FOO");
+            assertEquals(2, services.size());
+            assertSame(first, services.get(0).getProvider());
+            assertSame(second, services.get(1).getProvider());
+            assertTrue(list.getServices("MessageDigest", "Qux").isEmpty());
+        }
+    }
+
+    @Test
+    public void getService_seesProviderChanges() {
+        Provider first = new TestProvider("First");
+        Provider second = new TestProvider("Second");
+        second.put("MessageDigest.FOO", "second.Foo");
+        ProviderList list = ProviderList.newList(first, second);
+        assertEquals("second.Foo", list.getService("MessageDigest", "FOO").getClassName());
+        assertNull(list.getService("MessageDigest", "BAR"));
+
+        first.put("MessageDigest.FOO", "first.Foo");
+        second.put("Alg.Alias.MessageDigest.BAR", "FOO");
+        assertEquals("first.Foo", list.getService("MessageDigest", "FOO").getClassName());
+        assertEquals(2, list.getServices("MessageDigest", "FOO").size());
+        assertEquals("second.Foo", list.getService("MessageDigest", "BAR").getClassName());
+
+        first.remove("MessageDigest.FOO");
+        assertEquals("second.Foo", list.getService("MessageDigest", "FOO").getClassName());
+
+        second.clear();
+        assertNull(list.getService("MessageDigest", "FOO"));
+        assertNull(list.getService("MessageDigest", "BAR"));
+    }
+
+    @Test
+    public void getService_providerOverridingGetService() {
+        final String[] className = { "first.Foo" };
+        Provider dynamic = new TestProvider("Dynamic") {
+            @Override
+            public Service getService(String type, String algorithm) {
+                return new Service(this, type, algorithm, className[0], null, null);
+            }
+        };
+        ProviderList list = ProviderList.newList(dynamic);
+        assertEquals("first.Foo", list.getService("MessageDigest", "FOO").getClassName());
+        className[0] = "second.Foo";
+        assertEquals("second.Foo", list.getService("MessageDigest", "FOO").getClassName());
+    }
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.sun.security.util;
+
+import junit.framework.TestCase;
+
+import java.util.HashMap;
+import java.util.Map;
+import java.util.Random;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import sun.security.util.Cache;
+
+public class CacheTest extends TestCase {
+
+    public void test_putGetRemove() {
+        Cache<String, String> cache = Cache.newHardMemoryCache(10);
+        cache.put("a", "A");
+        cache.put("b", "B");
+        assertEquals("A", cache.get("a"));
+        assertEquals("B", cache.get("b"));
+        assertNull(cache.get("c"));
+        assertEquals(2, cache.size());
+
+        cache.put("a", "A2");
+        assertEquals("A2", cache.get("a"));
+        assertEquals(2, cache.size());
+
+        cache.remove("a");
+        assertNull(cache.get("a"));
+        assertEquals(1, cache.size());
+
+        cache.clear();
+        assertNull(cache.get("b"));
+        assertEquals(0, cache.size());
+    }
+
+    public void test_softCache() {
+        Cache<String, String> cache = Cache.newSoftMemoryCache(10);
+        cache.put("a", "A");
+        assertEquals("A", cache.get("a"));
+        cache.remove("a");
+        assertNull(cache.get("a"));
+    }
+
+    public void test_evictsUnreferencedEntriesFirst() {
+        Cache<String, String> cache = Cache.newHardMemoryCache(3);
+        cache.put("a", "A");
+        cache.put("b", "B");
+        cache.put("c", "C");
+        cache.get("a");
+        cache.put("d", "D");
+        assertEquals(3, cache.size());
+        assertNull(cache.get("b"));
+        assertEquals("A", cache.get("a"));
+        assertEquals("C", cache.get("c"));
+        assertEquals("D", cache.get("d"));
+    }
+
+    public void test_sizeIsBounded() {
+        Cache<Integer, Integer> cache = Cache.newHardMemoryCache(10);
+        for (int i = 0; i < 1000; i++) {
+            cache.put(i, i);
+            cache.get(i - 1);
+        }
+        assertEquals(10, cache.size());
+        // The most recent entry is never the one replaced.
+        assertEquals(Integer.valueOf(999), cache.get(999));
+    }
+
+    public void test_setCapacity() {
+        Cache<Integer, Integer> cache = Cache.newHardMemoryCache(10);
+        for (int i = 0; i < 10; i++) {
+            cache.put(i, i);
+        }
+        cache.setCapacity(4);
+        assertEquals(4, cache.size());
+        cache.put(10, 10);
+        assertEquals(4, cache.size());
+    }
+
+    public void test_expiredEntries() throws Exception {
+        Cache<String, String> cache = Cache.newHardMemoryCache(10, 1);
+        cache.put("a", "A");
+        assertEquals("A", cache.get("a"));
+        Thread.sleep(1100);
+        assertNull(cache.get("a"));
+        assertNull(cache.get("a"));
+        assertEquals(0, cache.size());
+        cache.put("a", "A2");
+        assertEquals("A2", cache.get("a"));
+    }
+
+    public void test_accept() {
+        Cache<String, String> cache = Cache.newHardMemoryCache(10);
+        cache.put("a", "A");
+        cache.put("b", "B");
+        cache.remove("b");
+        final Map<String, String> visited = new HashMap<>();
+        cache.accept(map -> visited.putAll(map));
+        assertEquals(1, visited.size());
+        assertEquals("A", visited.get("a"));
+    }
+
+    public void test_statistics() {
+        Cache<String, String> cache = Cache.newHardMemoryCache(1);
+        cache.put("a", "A");
+        cache.get("a");
+        cache.get("a");
+        cache.get("b");
+        cache.put("b", "B");
+        assertEquals(2, cache.hitCount());
+        assertEquals(1, cache.missCount());
+        assertEquals(1, cache.evictionCount());
+
+        Cache<String, String> nullCache = Cache.newNullCache();
+        nullCache.get("a");
+        assertEquals(0, nullCache.hitCount());
+        assertEquals(0, nullCache.missCount());
+    }
+
+    public void test_concurrentAccess() throws Exception {
+        final int threadCount = 8;
+        final int maxSize = 64;
+        final Cache<Integer, String> cache = Cache.newSoftMemoryCache(maxSize);
+        final AtomicInteger failures = new AtomicInteger();
+        Thread[] threads = new Thread[threadCount];
+        for (int t = 0; t < threadCount; t++) {
+            final Random random = new Random(t);
+            threads[t] = new Thread(() -> {
+                for (int i = 0; i < 20000; i++) {
+                    int key = random.nextInt(256);
+                    String value = cache.get(key);
+                    if (value != null && !value.equals("v" + key)) {
+                        failures.incrementAndGet();
+                    }
+                    if (value == null) {
+                        cache.put(key, "v" + key);
+                    } else if (i % 50 == 0) {
+                        cache.remove(key);
+                    }
+                }
+            });
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+        assertEquals(0, failures.get());
+        assertTrue(cache.size() <= maxSize);
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.sun.security.util;
+
+import junit.framework.TestCase;
+
+import java.util.Arrays;
+
+import sun.security.util.DerOutputStream;
+import sun.security.util.DerValue;
+
+public class DerValueTest extends TestCase {
+
+    public void test_toByteArray_roundTrip() throws Exception {
+        for (int length : new int[] { 0, 1, 127, 128, 255, 256, 70000 }) {
+            byte[] content = new byte[length];
+            for (int i = 0; i < length; i++) {
+                content[i] = (byte) i;
+            }
+            byte[] encoded = new DerValue(DerValue.tag_OctetString, content).toByteArray();
+            DerValue decoded = new DerValue(encoded);
+            assertTrue(Arrays.equals(content, decoded.getOctetString()));
+            assertTrue(Arrays.equals(encoded, new DerValue(encoded).toByteArray()));
+        }
+    }
+
+    public void test_toByteArray_nestedValue() throws Exception {
+        DerOutputStream inner = new DerOutputStream();
+        inner.putInteger(1);
+        inner.putOctetString(new byte[] { 1, 2, 3 });
+        DerOutputStream seq = new DerOutputStream();
+        seq.write(DerValue.tag_Sequence, inner);
+        DerValue outer = new DerValue(seq.toByteArray());
+
+        DerValue first = outer.data.getDerValue();
+        DerValue second = outer.data.getDerValue();
+        // Encoding a value does not disturb reading it.
+        assertTrue(Arrays.equals(
+                new byte[] { DerValue.tag_OctetString, 3, 1, 2, 3 }, second.toByteArray()));
+        assertTrue(Arrays.equals(new byte[] { 1, 2, 3 }, second.getOctetString()));
+        assertEquals(1, first.getInteger());
+        assertEquals(0, outer.data.available());
+    }
+}
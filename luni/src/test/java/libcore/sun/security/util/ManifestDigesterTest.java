@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.sun.security.util;
+
+import junit.framework.TestCase;
+
+import java.nio.charset.StandardCharsets;
+import java.security.MessageDigest;
+import java.util.Arrays;
+
+import sun.security.util.ManifestDigester;
+
+public class ManifestDigesterTest extends TestCase {
+
+    private static final String MAIN = "Manifest-Version: 1.0\r\nCreated-By: test\r\n\r\n";
+    private static final String FOO = "Name: foo.class\r\nSHA-256-Digest: AAAA\r\n\r\n";
+    // A name wrapped over three lines, as written for names longer than 72 bytes.
+    private static final String WRAPPED = "Name: org/example/a/very/long/path/\r\n"
+            + " that/is/wrapped/\r\n"
+            + " Bar.class\r\nSHA-256-Digest: BBBB\r\n\r\n";
+    private static final String ATTRIBUTES_ONLY = "Some-Attribute: value\r\n\r\n";
+    private static final String BAZ = "Name: baz.class\nSHA-256-Digest: CCCC\n\n";
+
+    private static byte[] bytes(String s) {
+        return s.getBytes(StandardCharsets.UTF_8);
+    }
+
+    private static byte[] sha256(String s) throws Exception {
+        return MessageDigest.getInstance("SHA-256").digest(bytes(s));
+    }
+
+    private static byte[] digest(ManifestDigester.Entry entry) throws Exception {
+        return entry.digest(MessageDigest.getInstance("SHA-256"));
+    }
+
+    public void test_sections() throws Exception {
+        String manifest = MAIN + FOO + ATTRIBUTES_ONLY + WRAPPED + BAZ;
+        ManifestDigester md = new ManifestDigester(bytes(manifest));
+
+        assertTrue(Arrays.equals(sha256(MAIN),
+                digest(md.get(ManifestDigester.MF_MAIN_ATTRS, false))));
+        assertTrue(Arrays.equals(sha256(FOO), digest(md.get("foo.class", false))));
+        assertTrue(Arrays.equals(sha256(WRAPPED),
+                digest(md.get("org/example/a/very/long/path/that/is/wrapped/Bar.class", false))));
+        assertTrue(Arrays.equals(sha256(BAZ), digest(md.get("baz.class", false))));
+        assertNull(md.get("Some-Attribute: value", false));
+        assertNull(md.get("missing.class", false));
+        assertNull(md.get(null, false));
+
+        // The workaround digest leaves out the blank line that ends the section.
+        byte[] workaround = md.get("foo.class", false).digestWorkaround(
+                MessageDigest.getInstance("SHA-256"));
+        assertTrue(Arrays.equals(sha256(FOO.substring(0, FOO.length() - 2)), workaround));
+
+        assertTrue(Arrays.equals(sha256(manifest),
+                md.manifestDigest(MessageDigest.getInstance("SHA-256"))));
+    }
+
+    public void test_oldStyleIgnoresTrailingSpaces() throws Exception {
+        String section = "Name: foo.class \r\nSHA-256-Digest: AAAA \r\n\r\n";
+        ManifestDigester md = new ManifestDigester(bytes(MAIN + section));
+        assertTrue(Arrays.equals(sha256(section), digest(md.get("foo.class ", false))));
+        assertTrue(Arrays.equals(sha256("Name: foo.class\r\nSHA-256-Digest: AAAA\r\n\r\n"),
+                digest(md.get("foo.class ", true))));
+    }
+
+    public void test_duplicateNames_lastWins() throws Exception {
+        String second = "Name: foo.class\r\nSHA-256-Digest: DDDD\r\n\r\n";
+        ManifestDigester md = new ManifestDigester(bytes(MAIN + FOO + second));
+        assertTrue(Arrays.equals(sha256(second), digest(md.get("foo.class", false))));
+    }
+
+    public void test_manySections() throws Exception {
+        StringBuilder manifest = new StringBuilder(MAIN);
+        for (int i = 0; i < 5000; i++) {
+            manifest.append("Name: entry").append(i).append(".class\r\n")
+                    .append("SHA-256-Digest: AAAA\r\n\r\n");
+        }
+        ManifestDigester md = new ManifestDigester(bytes(manifest.toString()));
+        for (int i = 0; i < 5000; i++) {
+            String section = "Name: entry" + i + ".class\r\nSHA-256-Digest: AAAA\r\n\r\n";
+            assertTrue(Arrays.equals(sha256(section),
+                    digest(md.get("entry" + i + ".class", false))));
+        }
+        assertNull(md.get("entry5000.class", false));
+    }
+
+    public void test_empty() {
+        ManifestDigester md = new ManifestDigester(new byte[0]);
+        assertNull(md.get(ManifestDigester.MF_MAIN_ATTRS, false));
+    }
+}
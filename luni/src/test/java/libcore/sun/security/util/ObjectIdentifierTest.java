@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.sun.security.util;
+
+import junit.framework.TestCase;
+
+import java.io.IOException;
+
+import sun.security.util.DerInputStream;
+import sun.security.util.DerOutputStream;
+import sun.security.util.DerValue;
+import sun.security.util.ObjectIdentifier;
+import sun.security.x509.PKIXExtensions;
+
+public class ObjectIdentifierTest extends TestCase {
+
+    public void test_decodeSharesInstances() throws Exception {
+        byte[] encoded = encode(new ObjectIdentifier("1.2.3.4.5.6.7.8.9"));
+        ObjectIdentifier first = new DerValue(encoded).getOID();
+        ObjectIdentifier second = new DerInputStream(encoded).getOID();
+        assertSame(first, second);
+        assertEquals("1.2.3.4.5.6.7.8.9", first.toString());
+    }
+
+    public void test_decodeKnownOid() throws Exception {
+        ObjectIdentifier decoded =
+                new DerValue(encode(PKIXExtensions.KeyUsage_Id)).getOID();
+        assertEquals(PKIXExtensions.KeyUsage_Id, decoded);
+        assertEquals(PKIXExtensions.KeyUsage_Id.hashCode(), decoded.hashCode());
+        assertEquals("2.5.29.15", decoded.toString());
+    }
+
+    public void test_decodeInvalidEncoding() throws Exception {
+        try {
+            new DerValue(new byte[] { DerValue.tag_ObjectId, 1, (byte) 0x80 }).getOID();
+            fail();
+        } catch (IOException expected) {
+        }
+        try {
+            new DerInputStream(new byte[] { DerValue.tag_ObjectId, 2, (byte) 0x80, 1 }).getOID();
+            fail();
+        } catch (IOException expected) {
+        }
+    }
+
+    public void test_of_String() throws Exception {
+        assertSame(PKIXExtensions.KeyUsage_Id, ObjectIdentifier.of("2.5.29.15"));
+        ObjectIdentifier unknown = ObjectIdentifier.of("1.2.3.4.5.6.7.8.10");
+        assertEquals(new ObjectIdentifier("1.2.3.4.5.6.7.8.10"), unknown);
+        try {
+            ObjectIdentifier.of("3.1");
+            fail();
+        } catch (IOException expected) {
+        }
+    }
+
+    public void test_equalsAndHashCode() throws Exception {
+        ObjectIdentifier a = new ObjectIdentifier("1.2.840.113549.1.1.11");
+        ObjectIdentifier b = new ObjectIdentifier(new int[] { 1, 2, 840, 113549, 1, 1, 11 });
+        ObjectIdentifier c = new ObjectIdentifier("1.2.840.113549.1.1.12");
+        assertEquals(a, b);
+        assertEquals(a.hashCode(), b.hashCode());
+        assertFalse(a.equals(c));
+        assertFalse(c.equals(a));
+    }
+
+    private static byte[] encode(ObjectIdentifier oid) throws IOException {
+        DerOutputStream out = new DerOutputStream();
+        out.putOID(oid);
+        return out.toByteArray();
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package libcore.sun.security.x509;
+
+import junit.framework.TestCase;
+
+import java.io.IOException;
+import java.util.Arrays;
+
+import sun.security.util.DerInputStream;
+import sun.security.util.DerOutputStream;
+import sun.security.util.DerValue;
+import sun.security.x509.BasicConstraintsExtension;
+import sun.security.x509.CertificateExtensions;
+import sun.security.x509.Extension;
+import sun.security.x509.KeyUsageExtension;
+import sun.security.x509.PKIXExtensions;
+
+public class CertificateExtensionsTest extends TestCase {
+
+    private static final byte[] MALFORMED_VALUE = { 0x01 };
+
+    public void test_nonCriticalExtensionDecodedOnAccess() throws Exception {
+        byte[] encoded = encode(
+                new BasicConstraintsExtension(true, true, 0),
+                keyUsage(false, keyUsageValue()));
+        CertificateExtensions exts = new CertificateExtensions(new DerInputStream(encoded));
+
+        assertTrue(exts.get(KeyUsageExtension.NAME) instanceof KeyUsageExtension);
+        assertTrue(exts.get(BasicConstraintsExtension.NAME) instanceof BasicConstraintsExtension);
+        assertEquals(2, exts.getAllExtensions().size());
+        assertTrue(exts.getUnparseableExtensions().isEmpty());
+
+        DerOutputStream out = new DerOutputStream();
+        exts.encode(out, true);
+        assertTrue(Arrays.equals(encoded, out.toByteArray()));
+    }
+
+    public void test_malformedNonCriticalExtensionIsUnparseable() throws Exception {
+        CertificateExtensions exts = new CertificateExtensions(new DerInputStream(
+                encode(keyUsage(false, MALFORMED_VALUE))));
+
+        assertEquals(1, exts.getUnparseableExtensions().size());
+        assertTrue(exts.getUnparseableExtensions().containsKey(
+                PKIXExtensions.KeyUsage_Id.toString()));
+        try {
+            exts.get(KeyUsageExtension.NAME);
+            fail();
+        } catch (IOException expected) {
+        }
+    }
+
+    public void test_malformedCriticalExtensionFailsParse() throws Exception {
+        try {
+            new CertificateExtensions(new DerInputStream(
+                    encode(keyUsage(true, MALFORMED_VALUE))));
+            fail();
+        } catch (IOException expected) {
+        }
+    }
+
+    public void test_duplicateNonCriticalExtensionsFailParse() throws Exception {
+        try {
+            new CertificateExtensions(new DerInputStream(encode(
+                    keyUsage(false, keyUsageValue()), keyUsage(false, keyUsageValue()))));
+            fail();
+        } catch (IOException expected) {
+        }
+    }
+
+    public void test_equalsDecodesBothSides() throws Exception {
+        byte[] encoded = encode(keyUsage(false, keyUsageValue()));
+        CertificateExtensions a = new CertificateExtensions(new DerInputStream(encoded));
+        CertificateExtensions b = new CertificateExtensions(new DerInputStream(encoded));
+        assertEquals(a, b);
+        assertEquals(a.hashCode(), b.hashCode());
+    }
+
+    private static byte[] keyUsageValue() throws IOException {
+        return new KeyUsageExtension(new boolean[] { true, false, true }).getExtensionValue();
+    }
+
+    private static Extension keyUsage(boolean critical, byte[] value) throws IOException {
+        byte[] octetString = new DerValue(DerValue.tag_OctetString, value).toByteArray();
+        return new Extension(PKIXExtensions.KeyUsage_Id, critical, octetString);
+    }
+
+    private static byte[] encode(Extension... exts) throws IOException {
+        DerOutputStream out = new DerOutputStream();
+        for (Extension ext : exts) {
+            ext.encode(out);
+        }
+        DerOutputStream seq = new DerOutputStream();
+        seq.write(DerValue.tag_Sequence, out);
+        return seq.toByteArray();
+    }
+}
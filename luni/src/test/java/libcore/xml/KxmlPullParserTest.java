@@ -17,6 +17,8 @@
 package libcore.xml;
 
 import com.android.org.kxml2.io.KXmlParser;
+import java.io.StringReader;
+import libcore.internal.ConcurrentStringPool;
 import org.xmlpull.v1.XmlPullParser;
 
 public class KxmlPullParserTest extends PullParserTest {
@@ -24,4 +26,27 @@ public class KxmlPullParserTest extends PullParserTest {
     @Override XmlPullParser newPullParser() {
         return new KXmlParser();
     }
+
+    public void testSharedNamePool() throws Exception {
+        ConcurrentStringPool namePool = new ConcurrentStringPool();
+        String xml = "<foo bar='1'><baz/></foo>";
+
+        KXmlParser first = new KXmlParser();
+        first.setNamePool(namePool);
+        first.setInput(new StringReader(xml));
+        assertEquals(XmlPullParser.START_TAG, first.next());
+        String foo = first.getName();
+        String bar = first.getAttributeName(0);
+
+        KXmlParser second = new KXmlParser();
+        second.setNamePool(namePool);
+        second.setInput(new StringReader(xml));
+        assertEquals(XmlPullParser.START_TAG, second.next());
+        assertEquals("foo", second.getName());
+        assertSame(foo, second.getName());
+        assertSame(bar, second.getAttributeName(0));
+        assertEquals("1", second.getAttributeValue(0));
+        assertEquals(XmlPullParser.START_TAG, second.next());
+        assertEquals("baz", second.getName());
+    }
 }
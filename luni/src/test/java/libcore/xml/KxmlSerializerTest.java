@@ -19,7 +19,10 @@ package libcore.xml;
 import com.android.org.kxml2.io.KXmlSerializer;
 import java.io.ByteArrayOutputStream;
 import java.io.IOException;
+import java.io.OutputStreamWriter;
 import java.io.StringWriter;
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
 import junit.framework.TestCase;
 import org.w3c.dom.Document;
 import org.w3c.dom.Node;
@@ -220,6 +223,62 @@ public final class KxmlSerializerTest extends TestCase {
         assertEquals("a]]>b", text);
     }
 
+    private static void writeSampleDocument(XmlSerializer serializer) throws IOException {
+        serializer.startDocument("UTF-8", null);
+        serializer.startTag(NAMESPACE, "root");
+        serializer.attribute(NAMESPACE, "plain", "abcdefghijklmnopqrstuvwxyz");
+        serializer.attribute(NAMESPACE, "escaped", "a<b>c&d\"e\n\u00e9\u4e2d");
+        serializer.text("caf\u00e9 \u4e2d\u6587 & <text> \ud83d\ude4a " + "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx");
+        serializer.comment(" \ud83d\ude4a\u00e9 ");
+        serializer.cdsect("\u00ff]]>\u0100");
+        serializer.endTag(NAMESPACE, "root");
+        serializer.endDocument();
+    }
+
+    public void testUtf8OutputStreamMatchesWriter() throws Exception {
+        ByteArrayOutputStream expected = new ByteArrayOutputStream();
+        XmlSerializer serializer = new KXmlSerializer();
+        serializer.setOutput(new OutputStreamWriter(expected, StandardCharsets.UTF_8));
+        writeSampleDocument(serializer);
+
+        // Tiny buffers exercise buffer boundaries, including split surrogate pairs.
+        for (int charBufferLength : new int[] { 1, 2, 3, 7, 8192 }) {
+            for (int byteBufferLength : new int[] { 4, 5, 13, 8192 }) {
+                ByteArrayOutputStream actual = new ByteArrayOutputStream();
+                serializer = new KXmlSerializer(charBufferLength, byteBufferLength);
+                serializer.setOutput(actual, "UTF-8");
+                writeSampleDocument(serializer);
+                assertEquals(charBufferLength + "/" + byteBufferLength,
+                        expected.toString("UTF-8"), actual.toString("UTF-8"));
+                assertTrue(Arrays.equals(expected.toByteArray(), actual.toByteArray()));
+            }
+        }
+    }
+
+    public void testUtf8OutputStreamReusedAcrossSetOutput() throws Exception {
+        KXmlSerializer serializer = new KXmlSerializer(16, 16);
+        ByteArrayOutputStream first = new ByteArrayOutputStream();
+        serializer.setOutput(first, "utf-8");
+        writeSampleDocument(serializer);
+        ByteArrayOutputStream second = new ByteArrayOutputStream();
+        serializer.setOutput(second, "utf-8");
+        writeSampleDocument(serializer);
+        assertTrue(Arrays.equals(first.toByteArray(), second.toByteArray()));
+    }
+
+    public void testInvalidBufferLengths() throws Exception {
+        try {
+            new KXmlSerializer(0, 8192);
+            fail();
+        } catch (IllegalArgumentException expected) {
+        }
+        try {
+            new KXmlSerializer(8192, 3);
+            fail();
+        } catch (IllegalArgumentException expected) {
+        }
+    }
+
     private static boolean isValidXmlCodePoint(int c) {
         // http://www.w3.org/TR/REC-xml/#charsets
         return (c >= 0x20 && c <= 0xd7ff) || (c == 0x9) || (c == 0xa) || (c == 0xd) ||
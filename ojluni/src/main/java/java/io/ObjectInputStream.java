@@ -31,6 +31,8 @@ import java.lang.ref.ReferenceQueue;
 import java.lang.reflect.Array;
 import java.lang.reflect.Modifier;
 import java.lang.reflect.Proxy;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
 import java.security.AccessControlContext;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
@@ -44,6 +46,7 @@ import java.util.concurrent.atomic.AtomicBoolean;
 import static java.io.ObjectStreamClass.processQueue;
 import sun.reflect.misc.ReflectUtil;
 import dalvik.system.VMStack;
+import libcore.io.Memory;
 
 /**
  * An ObjectInputStream deserializes primitive data and objects previously
@@ -2516,6 +2519,24 @@ public class ObjectInputStream
     {
         /** maximum data block length */
         private static final int MAX_BLOCK_SIZE = 1024;
+        // BEGIN Android-added: Larger buffer and bulk conversion of primitive arrays.
+        /**
+         * (tunable) length of buffer for reading general/block data. This may
+         * exceed MAX_BLOCK_SIZE; data is still never read from the underlying
+         * stream in advance of its use.
+         */
+        private static final int BUF_SIZE = 4096;
+        /**
+         * (tunable) minimum number of primitive array elements converted with a
+         * single bulk copy rather than one element at a time
+         */
+        private static final int BULK_CONVERSION_THRESHOLD = 16;
+        /** whether stream (big-endian) values must be byte-swapped */
+        private static final boolean SWAP_BYTES =
+            ByteOrder.nativeOrder() != ByteOrder.BIG_ENDIAN;
+        /** minimum read length that bypasses buf in block data mode */
+        private static final int DIRECT_READ_THRESHOLD = 512;
+        // END Android-added: Larger buffer and bulk conversion of primitive arrays.
         /** maximum data block header length */
         private static final int MAX_HEADER_SIZE = 5;
         /** (tunable) length of char buffer (for reading strings) */
@@ -2524,7 +2545,9 @@ public class ObjectInputStream
         private static final int HEADER_BLOCKED = -2;
 
         /** buffer for reading general/block data */
-        private final byte[] buf = new byte[MAX_BLOCK_SIZE];
+        // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+        // private final byte[] buf = new byte[MAX_BLOCK_SIZE];
+        private final byte[] buf = new byte[BUF_SIZE];
         /** buffer for reading block data headers */
         private final byte[] hbuf = new byte[MAX_HEADER_SIZE];
         /** char buffer for fast string reads */
@@ -2683,8 +2706,9 @@ public class ObjectInputStream
                 do {
                     pos = 0;
                     if (unread > 0) {
+                        // Android-changed: Larger buffer and bulk conversion of primitive arrays.
                         int n =
-                            in.read(buf, 0, Math.min(unread, MAX_BLOCK_SIZE));
+                            in.read(buf, 0, Math.min(unread, BUF_SIZE));
                         if (n >= 0) {
                             end = n;
                             unread -= n;
@@ -2791,7 +2815,8 @@ public class ObjectInputStream
                     remain -= nread;
                     pos += nread;
                 } else {
-                    int nread = (int) Math.min(remain, MAX_BLOCK_SIZE);
+                    // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                    int nread = (int) Math.min(remain, BUF_SIZE);
                     if ((nread = in.read(buf, 0, nread)) < 0) {
                         break;
                     }
@@ -2851,6 +2876,20 @@ public class ObjectInputStream
             if (len == 0) {
                 return 0;
             } else if (blkmode) {
+                // BEGIN Android-added: Read large spans straight from the current block.
+                if (!copy && pos == end && unread > 0 && len >= DIRECT_READ_THRESHOLD) {
+                    int nread = in.read(b, off, Math.min(len, unread));
+                    if (nread < 0) {
+                        pos = 0;
+                        end = -1;
+                        unread = 0;
+                        throw new StreamCorruptedException(
+                            "unexpected EOF in middle of data block");
+                    }
+                    unread -= nread;
+                    return nread;
+                }
+                // END Android-added: Read large spans straight from the current block.
                 if (pos == end) {
                     refill();
                 }
@@ -2862,7 +2901,8 @@ public class ObjectInputStream
                 pos += nread;
                 return nread;
             } else if (copy) {
-                int nread = in.read(buf, 0, Math.min(len, MAX_BLOCK_SIZE));
+                // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                int nread = in.read(buf, 0, Math.min(len, BUF_SIZE));
                 if (nread > 0) {
                     System.arraycopy(buf, 0, b, off, nread);
                 }
@@ -3034,7 +3074,8 @@ public class ObjectInputStream
             int stop, endoff = off + len;
             while (off < endoff) {
                 if (!blkmode) {
-                    int span = Math.min(endoff - off, MAX_BLOCK_SIZE);
+                    // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                    int span = Math.min(endoff - off, BUF_SIZE);
                     in.readFully(buf, 0, span);
                     stop = off + span;
                     pos = 0;
@@ -3055,7 +3096,8 @@ public class ObjectInputStream
             int stop, endoff = off + len;
             while (off < endoff) {
                 if (!blkmode) {
-                    int span = Math.min(endoff - off, MAX_BLOCK_SIZE >> 1);
+                    // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                    int span = Math.min(endoff - off, BUF_SIZE >> 1);
                     in.readFully(buf, 0, span << 1);
                     stop = off + span;
                     pos = 0;
@@ -3066,6 +3108,14 @@ public class ObjectInputStream
                     stop = Math.min(endoff, off + ((end - pos) >> 1));
                 }
 
+                // BEGIN Android-added: Larger buffer and bulk conversion of primitive arrays.
+                if (stop - off >= BULK_CONVERSION_THRESHOLD) {
+                    int span = stop - off;
+                    Memory.unsafeBulkGet(v, off, span << 1, buf, pos, 2, SWAP_BYTES);
+                    off = stop;
+                    pos += span << 1;
+                }
+                // END Android-added: Larger buffer and bulk conversion of primitive arrays.
                 while (off < stop) {
                     v[off++] = Bits.getChar(buf, pos);
                     pos += 2;
@@ -3077,7 +3127,8 @@ public class ObjectInputStream
             int stop, endoff = off + len;
             while (off < endoff) {
                 if (!blkmode) {
-                    int span = Math.min(endoff - off, MAX_BLOCK_SIZE >> 1);
+                    // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                    int span = Math.min(endoff - off, BUF_SIZE >> 1);
                     in.readFully(buf, 0, span << 1);
                     stop = off + span;
                     pos = 0;
@@ -3088,6 +3139,14 @@ public class ObjectInputStream
                     stop = Math.min(endoff, off + ((end - pos) >> 1));
                 }
 
+                // BEGIN Android-added: Larger buffer and bulk conversion of primitive arrays.
+                if (stop - off >= BULK_CONVERSION_THRESHOLD) {
+                    int span = stop - off;
+                    Memory.unsafeBulkGet(v, off, span << 1, buf, pos, 2, SWAP_BYTES);
+                    off = stop;
+                    pos += span << 1;
+                }
+                // END Android-added: Larger buffer and bulk conversion of primitive arrays.
                 while (off < stop) {
                     v[off++] = Bits.getShort(buf, pos);
                     pos += 2;
@@ -3099,7 +3158,8 @@ public class ObjectInputStream
             int stop, endoff = off + len;
             while (off < endoff) {
                 if (!blkmode) {
-                    int span = Math.min(endoff - off, MAX_BLOCK_SIZE >> 2);
+                    // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                    int span = Math.min(endoff - off, BUF_SIZE >> 2);
                     in.readFully(buf, 0, span << 2);
                     stop = off + span;
                     pos = 0;
@@ -3110,6 +3170,14 @@ public class ObjectInputStream
                     stop = Math.min(endoff, off + ((end - pos) >> 2));
                 }
 
+                // BEGIN Android-added: Larger buffer and bulk conversion of primitive arrays.
+                if (stop - off >= BULK_CONVERSION_THRESHOLD) {
+                    int span = stop - off;
+                    Memory.unsafeBulkGet(v, off, span << 2, buf, pos, 4, SWAP_BYTES);
+                    off = stop;
+                    pos += span << 2;
+                }
+                // END Android-added: Larger buffer and bulk conversion of primitive arrays.
                 while (off < stop) {
                     v[off++] = Bits.getInt(buf, pos);
                     pos += 4;
@@ -3121,7 +3189,8 @@ public class ObjectInputStream
             int span, endoff = off + len;
             while (off < endoff) {
                 if (!blkmode) {
-                    span = Math.min(endoff - off, MAX_BLOCK_SIZE >> 2);
+                    // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                    span = Math.min(endoff - off, BUF_SIZE >> 2);
                     in.readFully(buf, 0, span << 2);
                     pos = 0;
                 } else if (end - pos < 4) {
@@ -3141,7 +3210,8 @@ public class ObjectInputStream
             int stop, endoff = off + len;
             while (off < endoff) {
                 if (!blkmode) {
-                    int span = Math.min(endoff - off, MAX_BLOCK_SIZE >> 3);
+                    // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                    int span = Math.min(endoff - off, BUF_SIZE >> 3);
                     in.readFully(buf, 0, span << 3);
                     stop = off + span;
                     pos = 0;
@@ -3152,6 +3222,14 @@ public class ObjectInputStream
                     stop = Math.min(endoff, off + ((end - pos) >> 3));
                 }
 
+                // BEGIN Android-added: Larger buffer and bulk conversion of primitive arrays.
+                if (stop - off >= BULK_CONVERSION_THRESHOLD) {
+                    int span = stop - off;
+                    Memory.unsafeBulkGet(v, off, span << 3, buf, pos, 8, SWAP_BYTES);
+                    off = stop;
+                    pos += span << 3;
+                }
+                // END Android-added: Larger buffer and bulk conversion of primitive arrays.
                 while (off < stop) {
                     v[off++] = Bits.getLong(buf, pos);
                     pos += 8;
@@ -3163,7 +3241,8 @@ public class ObjectInputStream
             int span, endoff = off + len;
             while (off < endoff) {
                 if (!blkmode) {
-                    span = Math.min(endoff - off, MAX_BLOCK_SIZE >> 3);
+                    // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                    span = Math.min(endoff - off, BUF_SIZE >> 3);
                     in.readFully(buf, 0, span << 3);
                     pos = 0;
                 } else if (end - pos < 8) {
@@ -3194,11 +3273,35 @@ public class ObjectInputStream
          * utflen bytes.
          */
         private String readUTFBody(long utflen) throws IOException {
-            StringBuilder sbuf = new StringBuilder();
             if (!blkmode) {
                 end = pos = 0;
+                // BEGIN Android-added: Decode buffered ASCII strings in one step.
+                if (utflen > 0 && utflen <= BUF_SIZE) {
+                    in.readFully(buf, 0, (int) utflen);
+                    end = (int) utflen;
+                }
             }
 
+            if (utflen <= end - pos) {
+                int start = pos;
+                int stop = start + (int) utflen;
+                int i = start;
+                while (i < stop && buf[i] >= 0) {
+                    i++;
+                }
+                if (i == stop) {
+                    pos = stop;
+                    return new String(buf, start, stop - start,
+                                      StandardCharsets.ISO_8859_1);
+                }
+            }
+            // END Android-added: Decode buffered ASCII strings in one step.
+
+            // Android-changed: Presize the builder for non-ASCII strings.
+            // StringBuilder sbuf = new StringBuilder();
+            StringBuilder sbuf =
+                new StringBuilder((int) Math.min(utflen, BUF_SIZE));
+
             while (utflen > 0) {
                 int avail = end - pos;
                 if (avail >= 3 || (long) avail == utflen) {
@@ -3213,7 +3316,8 @@ public class ObjectInputStream
                             System.arraycopy(buf, pos, buf, 0, avail);
                         }
                         pos = 0;
-                        end = (int) Math.min(MAX_BLOCK_SIZE, utflen);
+                        // Android-changed: Larger buffer and bulk conversion of primitive arrays.
+                        end = (int) Math.min(BUF_SIZE, utflen);
                         in.readFully(buf, avail, end - avail);
                     }
                 }
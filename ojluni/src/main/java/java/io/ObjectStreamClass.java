@@ -103,7 +103,43 @@ public class ObjectStreamClass implements Serializable {
         /** queue for WeakReferences to field reflectors keys */
         private static final ReferenceQueue<Class<?>> reflectorsQueue =
             new ReferenceQueue<>();
+
+        // BEGIN Android-added: Allocation-free lookup of cached descriptors.
+        /**
+         * Direct-mapped cache of descriptors indexed by the identity hash
+         * code of their class, consulted before localDescs. Slots are read
+         * and written without synchronization; a racing update at worst
+         * causes a lookup to fall back to localDescs.
+         */
+        static final DescriptorEntry[] fastDescs = new DescriptorEntry[256];
+        // END Android-added: Allocation-free lookup of cached descriptors.
+
+        // BEGIN Android-added: Precomputed default serialVersionUIDs.
+        /** precomputed default serialVersionUIDs, by class */
+        static final ConcurrentMap<WeakClassKey,Long> defaultSuids =
+            new ConcurrentHashMap<>();
+
+        /** queue for WeakReferences to classes with precomputed SUIDs */
+        private static final ReferenceQueue<Class<?>> defaultSuidsQueue =
+            new ReferenceQueue<>();
+        // END Android-added: Precomputed default serialVersionUIDs.
+    }
+
+    // BEGIN Android-added: Allocation-free lookup of cached descriptors.
+    /**
+     * An entry in {@link Caches#fastDescs}. Like the entries of
+     * {@link Caches#localDescs}, the class is weakly and the descriptor
+     * softly reachable from the cache.
+     */
+    private static final class DescriptorEntry extends WeakReference<Class<?>> {
+        final SoftReference<ObjectStreamClass> desc;
+
+        DescriptorEntry(Class<?> cl, ObjectStreamClass desc) {
+            super(cl);
+            this.desc = new SoftReference<>(desc);
+        }
     }
+    // END Android-added: Allocation-free lookup of cached descriptors.
 
     /** class associated with this descriptor (if any) */
     private Class<?> cl;
@@ -255,6 +291,14 @@ public class ObjectStreamClass implements Serializable {
     public long getSerialVersionUID() {
         // REMIND: synchronize instead of relying on volatile?
         if (suid == null) {
+            // BEGIN Android-added: Precomputed default serialVersionUIDs.
+            if (cl != null) {
+                suid = Caches.defaultSuids.get(new WeakClassKey(cl, null));
+                if (suid != null) {
+                    return suid.longValue();
+                }
+            }
+            // END Android-added: Precomputed default serialVersionUIDs.
             suid = AccessController.doPrivileged(
                 new PrivilegedAction<Long>() {
                     public Long run() {
@@ -266,6 +310,30 @@ public class ObjectStreamClass implements Serializable {
         return suid.longValue();
     }
 
+    // BEGIN Android-added: Precomputed default serialVersionUIDs.
+    /**
+     * Supplies the default serialVersionUID of a class that does not declare
+     * one, so that it need not be computed by reflection and hashing the
+     * first time the class is serialized. The value would typically be
+     * computed ahead of time, for example at build time, with {@link
+     * #getSerialVersionUID()}; supplying a value that differs from the
+     * computed one makes the class incompatible with other serialized
+     * forms of it.
+     *
+     * <p>This has no effect on classes that declare a serialVersionUID, or
+     * on descriptors whose serialVersionUID has already been computed.
+     *
+     * @param cl the class
+     * @param suid the default serialVersionUID of {@code cl}
+     * @hide
+     */
+    public static void putDefaultSerialVersionUID(Class<?> cl, long suid) {
+        processQueue(Caches.defaultSuidsQueue, Caches.defaultSuids);
+        Caches.defaultSuids.put(new WeakClassKey(cl, Caches.defaultSuidsQueue),
+                Long.valueOf(suid));
+    }
+    // END Android-added: Precomputed default serialVersionUIDs.
+
     /**
      * Return the class in the local VM that this version is mapped to.  Null
      * is returned if there is no corresponding local class.
@@ -330,6 +398,16 @@ public class ObjectStreamClass implements Serializable {
         if (!(all || Serializable.class.isAssignableFrom(cl))) {
             return null;
         }
+        // BEGIN Android-added: Allocation-free lookup of cached descriptors.
+        int slot = System.identityHashCode(cl) & (Caches.fastDescs.length - 1);
+        DescriptorEntry fast = Caches.fastDescs[slot];
+        if (fast != null && fast.get() == cl) {
+            ObjectStreamClass desc = fast.desc.get();
+            if (desc != null) {
+                return desc;
+            }
+        }
+        // END Android-added: Allocation-free lookup of cached descriptors.
         processQueue(Caches.localDescsQueue, Caches.localDescs);
         WeakClassKey key = new WeakClassKey(cl, Caches.localDescsQueue);
         Reference<?> ref = Caches.localDescs.get(key);
@@ -356,6 +434,8 @@ public class ObjectStreamClass implements Serializable {
         }
 
         if (entry instanceof ObjectStreamClass) {  // check common case first
+            // Android-added: Allocation-free lookup of cached descriptors.
+            Caches.fastDescs[slot] = new DescriptorEntry(cl, (ObjectStreamClass) entry);
             return (ObjectStreamClass) entry;
         }
         if (entry instanceof EntryFuture) {
@@ -387,6 +467,8 @@ public class ObjectStreamClass implements Serializable {
         }
 
         if (entry instanceof ObjectStreamClass) {
+            // Android-added: Allocation-free lookup of cached descriptors.
+            Caches.fastDescs[slot] = new DescriptorEntry(cl, (ObjectStreamClass) entry);
             return (ObjectStreamClass) entry;
         } else if (entry instanceof RuntimeException) {
             throw (RuntimeException) entry;
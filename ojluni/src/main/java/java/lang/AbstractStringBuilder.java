@@ -121,8 +121,13 @@ abstract class AbstractStringBuilder implements Appendable, CharSequence {
     private void ensureCapacityInternal(int minimumCapacity) {
         // overflow-conscious code
         if (minimumCapacity - value.length > 0) {
-            value = Arrays.copyOf(value,
-                    newCapacity(minimumCapacity));
+            // BEGIN Android-changed: Copy only the used part of value when growing.
+            // value = Arrays.copyOf(value,
+            //         newCapacity(minimumCapacity));
+            char[] newValue = new char[newCapacity(minimumCapacity)];
+            System.arraycopy(value, 0, newValue, 0, count);
+            value = newValue;
+            // END Android-changed: Copy only the used part of value when growing.
         }
     }
 
@@ -539,8 +544,17 @@ abstract class AbstractStringBuilder implements Appendable, CharSequence {
                 + s.length());
         int len = end - start;
         ensureCapacityInternal(count + len);
-        for (int i = start, j = count; i < end; i++, j++)
-            value[j] = s.charAt(i);
+        // BEGIN Android-changed: Bulk copy from String and AbstractStringBuilder.
+        if (s instanceof String) {
+            ((String) s).getChars(start, end, value, count);
+        } else if (s instanceof AbstractStringBuilder) {
+            // getChars holds the source's lock if it is a StringBuffer.
+            ((AbstractStringBuilder) s).getChars(start, end, value, count);
+        } else {
+            for (int i = start, j = count; i < end; i++, j++)
+                value[j] = s.charAt(i);
+        }
+        // END Android-changed: Bulk copy from String and AbstractStringBuilder.
         count += len;
         return this;
     }
@@ -703,6 +717,30 @@ abstract class AbstractStringBuilder implements Appendable, CharSequence {
         return this;
     }
 
+    // BEGIN Android-added: Append small integral values directly.
+    /**
+     * Integral floating-point values whose magnitude is below this limit are
+     * formatted by {@link Double#toString(double)} as their integer digits
+     * followed by {@code ".0"}.
+     */
+    private static final int INTEGRAL_DIRECT_LIMIT = 10_000_000;
+
+    /**
+     * Appends {@code i} as an integral floating-point value, without going
+     * through {@link FloatingDecimal}.
+     */
+    private AbstractStringBuilder appendIntegral(int i) {
+        int spaceNeeded = count + ((i < 0) ? Integer.stringSize(-i) + 3
+                                           : Integer.stringSize(i) + 2);
+        ensureCapacityInternal(spaceNeeded);
+        value[spaceNeeded - 2] = '.';
+        value[spaceNeeded - 1] = '0';
+        Integer.getChars(i, spaceNeeded - 2, value);
+        count = spaceNeeded;
+        return this;
+    }
+    // END Android-added: Append small integral values directly.
+
     /**
      * Appends the string representation of the {@code float}
      * argument to this sequence.
@@ -716,6 +754,13 @@ abstract class AbstractStringBuilder implements Appendable, CharSequence {
      * @return  a reference to this object.
      */
     public AbstractStringBuilder append(float f) {
+        // BEGIN Android-added: Append small integral values directly.
+        int i = (int) f;
+        if (i == f && i > -INTEGRAL_DIRECT_LIMIT && i < INTEGRAL_DIRECT_LIMIT
+                && (i != 0 || Float.floatToRawIntBits(f) == 0)) {
+            return appendIntegral(i);
+        }
+        // END Android-added: Append small integral values directly.
         FloatingDecimal.appendTo(f,this);
         return this;
     }
@@ -733,6 +778,13 @@ abstract class AbstractStringBuilder implements Appendable, CharSequence {
      * @return  a reference to this object.
      */
     public AbstractStringBuilder append(double d) {
+        // BEGIN Android-added: Append small integral values directly.
+        int i = (int) d;
+        if (i == d && i > -INTEGRAL_DIRECT_LIMIT && i < INTEGRAL_DIRECT_LIMIT
+                && (i != 0 || Double.doubleToRawLongBits(d) == 0)) {
+            return appendIntegral(i);
+        }
+        // END Android-added: Append small integral values directly.
         FloatingDecimal.appendTo(d,this);
         return this;
     }
@@ -1162,8 +1214,17 @@ abstract class AbstractStringBuilder implements Appendable, CharSequence {
         ensureCapacityInternal(count + len);
         System.arraycopy(value, dstOffset, value, dstOffset + len,
                          count - dstOffset);
-        for (int i=start; i<end; i++)
-            value[dstOffset++] = s.charAt(i);
+        // BEGIN Android-changed: Bulk copy from String and AbstractStringBuilder.
+        if (s instanceof String) {
+            ((String) s).getChars(start, end, value, dstOffset);
+        } else if (s instanceof AbstractStringBuilder && s != this) {
+            // getChars holds the source's lock if it is a StringBuffer.
+            ((AbstractStringBuilder) s).getChars(start, end, value, dstOffset);
+        } else {
+            for (int i=start; i<end; i++)
+                value[dstOffset++] = s.charAt(i);
+        }
+        // END Android-changed: Bulk copy from String and AbstractStringBuilder.
         count += len;
         return this;
     }
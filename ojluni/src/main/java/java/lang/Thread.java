@@ -206,6 +206,13 @@ class Thread implements Runnable {
      */
     ThreadLocal.ThreadLocalMap inheritableThreadLocals = null;
 
+    // Android-added: Indexed mode of ThreadLocal.
+    /*
+     * Values of ThreadLocals in indexed mode. Maintained by the ThreadLocal
+     * class.
+     */
+    ThreadLocal.IndexedValues indexedThreadLocals = null;
+
     /*
      * The requested stack size for this thread, or 0 if the creator did
      * not specify a stack size.  It is up to the VM to do whatever it
@@ -934,6 +941,8 @@ class Thread implements Runnable {
         /* Speed the release of some of these resources */
         threadLocals = null;
         inheritableThreadLocals = null;
+        // Android-added: Indexed mode of ThreadLocal.
+        indexedThreadLocals = null;
         inheritedAccessControlContext = null;
         blocker = null;
         uncaughtExceptionHandler = null;
@@ -25,6 +25,9 @@
 
 package java.lang;
 import java.lang.ref.*;
+// Android-added: Indexed mode.
+import java.util.Arrays;
+import java.util.BitSet;
 import java.util.Objects;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.function.Supplier;
@@ -105,6 +108,150 @@ public class ThreadLocal<T> {
         return nextHashCode.getAndAdd(HASH_INCREMENT);
     }
 
+    // BEGIN Android-added: Indexed mode.
+    /*
+     * A ThreadLocal created in indexed mode is assigned the lowest index
+     * not used by another live indexed ThreadLocal, and keeps its values
+     * at that index in the arrays of Thread.indexedThreadLocals, so that
+     * get() needs no hashing or probing. When the ThreadLocal is
+     * collected, a Cleaner frees its index for reuse. Values of a
+     * collected ThreadLocal are told apart from those of a later one
+     * with the same index by the owner id stored next to each value.
+     * Each release bumps releasedGeneration; the next time a thread sets
+     * or removes an indexed value and sees a new generation, it drops the
+     * values of all collected ThreadLocals. As with ThreadLocalMap's stale
+     * entries, get() hits never do this work.
+     */
+
+    /**
+     * The index of this ThreadLocal's values in Thread.indexedThreadLocals,
+     * or -1 if it is not indexed.
+     */
+    private final int index;
+
+    /**
+     * Id of this ThreadLocal, stored with its values in indexed mode.
+     * Never 0, which marks an empty index.
+     */
+    private final int indexedId;
+
+    /** The indices in use, guarded by itself. */
+    private static final BitSet usedIndices = new BitSet();
+
+    /**
+     * The id of the indexed ThreadLocal using each index, or 0. Written
+     * holding usedIndices.
+     */
+    private static volatile int[] indexOwners = new int[16];
+
+    /** The next id of an indexed ThreadLocal. */
+    private static final AtomicInteger nextIndexedId = new AtomicInteger();
+
+    /**
+     * The number of indices released so far. Incremented holding
+     * usedIndices, after the index's owner has been cleared.
+     */
+    private static volatile int releasedGeneration;
+
+    private static int allocateIndex(int id) {
+        synchronized (usedIndices) {
+            int index = usedIndices.nextClearBit(0);
+            usedIndices.set(index);
+            int[] owners = indexOwners;
+            if (index >= owners.length) {
+                owners = Arrays.copyOf(owners, owners.length * 2);
+            }
+            owners[index] = id;
+            indexOwners = owners;
+            return index;
+        }
+    }
+
+    /** Frees the index of an indexed ThreadLocal once it is collected. */
+    private static final class IndexReleaser implements Runnable {
+        private final int index;
+
+        IndexReleaser(int index) {
+            this.index = index;
+        }
+
+        @Override
+        public void run() {
+            synchronized (usedIndices) {
+                indexOwners[index] = 0;
+                usedIndices.clear(index);
+                releasedGeneration++;
+            }
+        }
+    }
+
+    /**
+     * Values of indexed ThreadLocals for one thread. Only accessed by that
+     * thread.
+     */
+    static final class IndexedValues {
+        Object[] values;
+        /** The indexedId of the ThreadLocal that set each value, or 0. */
+        int[] owners;
+        /** The releasedGeneration as of the last expungeStale(). */
+        int expungedGeneration;
+
+        IndexedValues(int capacity) {
+            values = new Object[capacity];
+            owners = new int[capacity];
+            expungedGeneration = releasedGeneration;
+        }
+
+        /**
+         * Grows the arrays to hold at least capacity values, dropping the
+         * values of ThreadLocals that have been collected.
+         */
+        void grow(int capacity) {
+            int length = Math.max(capacity, owners.length * 2);
+            values = Arrays.copyOf(values, length);
+            owners = Arrays.copyOf(owners, length);
+            expungeStale();
+        }
+
+        /**
+         * Drops the values of collected ThreadLocals if any index has been
+         * released since they were last dropped.
+         */
+        void maybeExpungeStale() {
+            if (expungedGeneration != releasedGeneration) {
+                expungeStale();
+            }
+        }
+
+        private void expungeStale() {
+            // Read the generation first: a release racing with the scan is
+            // then seen by the next call.
+            expungedGeneration = releasedGeneration;
+            int[] liveOwners = indexOwners;
+            for (int i = 0; i < owners.length; i++) {
+                if (owners[i] != 0 && (i >= liveOwners.length || owners[i] != liveOwners[i])) {
+                    owners[i] = 0;
+                    values[i] = null;
+                }
+            }
+        }
+    }
+
+    private void setIndexed(Thread t, T value) {
+        IndexedValues indexed = t.indexedThreadLocals;
+        if (indexed == null) {
+            t.indexedThreadLocals = indexed =
+                new IndexedValues(Math.max(index + 1, indexOwners.length));
+        } else if (index >= indexed.owners.length) {
+            indexed.grow(index + 1);
+        } else {
+            indexed.maybeExpungeStale();
+        }
+        indexed.values[index] = value;
+        indexed.owners[index] = indexedId;
+    }
+    // END Android-added: Indexed mode.
+
     /**
      * Returns the current thread's "initial value" for this
      * thread-local variable.  This method will be invoked the first
@@ -146,8 +293,55 @@ public class ThreadLocal<T> {
      * @see #withInitial(java.util.function.Supplier)
      */
     public ThreadLocal() {
+        // Android-added: Indexed mode.
+        this(false);
+    }
+
+    // BEGIN Android-added: Indexed mode.
+    /**
+     * Creates a thread local variable. If {@code indexed} is true, the
+     * variable is assigned a small index and each thread keeps its value
+     * in an array at that index instead of in a hash map, which makes
+     * {@link #get} a few loads. The array of every thread that uses the
+     * variable keeps a slot for it until it is collected, so this suits
+     * long-lived thread locals used on hot paths. Instances of
+     * {@link InheritableThreadLocal} are never indexed.
+     *
+     * @param indexed whether to keep values in indexed mode
+     * @hide
+     */
+    protected ThreadLocal(boolean indexed) {
+        if (indexed && !(this instanceof InheritableThreadLocal)) {
+            int id;
+            do {
+                id = nextIndexedId.incrementAndGet();
+            } while (id == 0);
+            indexedId = id;
+            index = allocateIndex(id);
+            sun.misc.Cleaner.create(this, new IndexReleaser(index));
+        } else {
+            indexedId = 0;
+            index = -1;
+        }
     }
 
+    /**
+     * Creates a thread local variable in indexed mode, as by
+     * {@link #ThreadLocal(boolean)}. The initial value of the variable
+     * is determined by invoking the {@code get} method on the
+     * {@code Supplier}.
+     *
+     * @param <S> the type of the thread local's value
+     * @param supplier the supplier to be used to determine the initial value
+     * @return a new thread local variable
+     * @throws NullPointerException if the specified supplier is null
+     * @hide
+     */
+    public static <S> ThreadLocal<S> withInitialIndexed(Supplier<? extends S> supplier) {
+        return new SuppliedThreadLocal<>(supplier, true);
+    }
+    // END Android-added: Indexed mode.
+
     /**
      * Returns the value in the current thread's copy of this
      * thread-local variable.  If the variable has no value for the
@@ -158,6 +352,18 @@ public class ThreadLocal<T> {
      */
     public T get() {
         Thread t = Thread.currentThread();
+        // BEGIN Android-added: Indexed mode.
+        if (index >= 0) {
+            IndexedValues indexed = t.indexedThreadLocals;
+            if (indexed != null && index < indexed.owners.length
+                    && indexed.owners[index] == indexedId) {
+                @SuppressWarnings("unchecked")
+                T result = (T)indexed.values[index];
+                return result;
+            }
+            return setInitialValue();
+        }
+        // END Android-added: Indexed mode.
         ThreadLocalMap map = getMap(t);
         if (map != null) {
             ThreadLocalMap.Entry e = map.getEntry(this);
@@ -179,6 +385,12 @@ public class ThreadLocal<T> {
     private T setInitialValue() {
         T value = initialValue();
         Thread t = Thread.currentThread();
+        // BEGIN Android-added: Indexed mode.
+        if (index >= 0) {
+            setIndexed(t, value);
+            return value;
+        }
+        // END Android-added: Indexed mode.
         ThreadLocalMap map = getMap(t);
         if (map != null)
             map.set(this, value);
@@ -198,6 +410,12 @@ public class ThreadLocal<T> {
      */
     public void set(T value) {
         Thread t = Thread.currentThread();
+        // BEGIN Android-added: Indexed mode.
+        if (index >= 0) {
+            setIndexed(t, value);
+            return;
+        }
+        // END Android-added: Indexed mode.
         ThreadLocalMap map = getMap(t);
         if (map != null)
             map.set(this, value);
@@ -217,6 +435,19 @@ public class ThreadLocal<T> {
      * @since 1.5
      */
      public void remove() {
+         // BEGIN Android-added: Indexed mode.
+         if (index >= 0) {
+             IndexedValues indexed = Thread.currentThread().indexedThreadLocals;
+             if (indexed != null) {
+                 if (index < indexed.owners.length && indexed.owners[index] == indexedId) {
+                     indexed.values[index] = null;
+                     indexed.owners[index] = 0;
+                 }
+                 indexed.maybeExpungeStale();
+             }
+             return;
+         }
+         // END Android-added: Indexed mode.
          ThreadLocalMap m = getMap(Thread.currentThread());
          if (m != null)
              m.remove(this);
@@ -279,6 +510,12 @@ public class ThreadLocal<T> {
             this.supplier = Objects.requireNonNull(supplier);
         }
 
+        // Android-added: Indexed mode.
+        SuppliedThreadLocal(Supplier<? extends T> supplier, boolean indexed) {
+            super(indexed);
+            this.supplier = Objects.requireNonNull(supplier);
+        }
+
         @Override
         protected T initialValue() {
             return supplier.get();
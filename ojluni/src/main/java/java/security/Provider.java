@@ -690,6 +690,11 @@ public abstract class Provider extends Properties {
     // Unmodifiable set of all services. Initialized on demand.
     private transient Set<Service> serviceSet;
 
+    // Android-added: Count changes to the services so that lookups can be cached.
+    // Incremented, while holding the lock on this, whenever a service or legacy
+    // property is added, changed or removed. See getServiceVersion().
+    private transient volatile int serviceVersion;
+
     // register the id attributes for this provider
     // this is to ensure that equals() and hashCode() do not incorrectly
     // report to different provider objects as the same
@@ -727,6 +732,8 @@ public abstract class Provider extends Properties {
         }
 
         legacyChanged = true;
+        // Android-added: Count changes to the services so that lookups can be cached.
+        serviceVersion++;
         if (legacyStrings == null) {
             legacyStrings = new LinkedHashMap<String,String>();
         }
@@ -792,6 +799,8 @@ public abstract class Provider extends Properties {
 
     private void implReplaceAll(BiFunction<? super Object, ? super Object, ? extends Object> function) {
         legacyChanged = true;
+        // Android-added: Count changes to the services so that lookups can be cached.
+        serviceVersion++;
         if (legacyStrings == null) {
             legacyStrings = new LinkedHashMap<String,String>();
         } else {
@@ -885,6 +894,8 @@ public abstract class Provider extends Properties {
         legacyChanged = false;
         servicesChanged = false;
         serviceSet = null;
+        // Android-added: Count changes to the services so that lookups can be cached.
+        serviceVersion++;
         super.clear();
         putId();
         // Android-added: Provider registration
@@ -1164,6 +1175,8 @@ public abstract class Provider extends Properties {
             serviceMap = new LinkedHashMap<ServiceKey,Service>();
         }
         servicesChanged = true;
+        // Android-added: Count changes to the services so that lookups can be cached.
+        serviceVersion++;
         String type = s.getType();
         String algorithm = s.getAlgorithm();
         ServiceKey key = new ServiceKey(type, algorithm, true);
@@ -1271,6 +1284,8 @@ public abstract class Provider extends Properties {
             return;
         }
         servicesChanged = true;
+        // Android-added: Count changes to the services so that lookups can be cached.
+        serviceVersion++;
         serviceMap.remove(key);
         for (String alias : s.getAliases()) {
             serviceMap.remove(new ServiceKey(type, alias, false));
@@ -1923,4 +1938,18 @@ public abstract class Provider extends Properties {
         getServices();
     }
     // END Android-added: Provider registration
+
+    // BEGIN Android-added: Count changes to the services so that lookups can be cached.
+    /**
+     * Returns a number that changes whenever a service or a legacy property of
+     * this provider is added, changed or removed. If two calls return the same
+     * value, {@link #getService} returned the same results between them, unless
+     * a subclass overrides it.
+     *
+     * @hide
+     */
+    public int getServiceVersion() {
+        return serviceVersion;
+    }
+    // END Android-added: Count changes to the services so that lookups can be cached.
 }
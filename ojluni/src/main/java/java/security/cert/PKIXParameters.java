@@ -97,6 +97,8 @@ public class PKIXParameters implements CertPathParameters {
     private boolean policyQualifiersRejected = true;
     private List<CertStore> certStores;
     private CertSelector certSelector;
+    // Android-added: Opt-in caching of validation results.
+    private boolean resultCacheEnabled = false;
 
     /**
      * Creates an instance of {@code PKIXParameters} with the specified
@@ -355,6 +357,33 @@ public class PKIXParameters implements CertPathParameters {
         return revocationEnabled;
     }
 
+    // BEGIN Android-added: Opt-in caching of validation results.
+    /**
+     * Sets whether the PKIX {@code CertPathValidator} may reuse the result
+     * of an earlier successful validation of the same certificates against
+     * trust anchors with the same content and the same settings. Validations
+     * with revocation checking, additional {@code PKIXCertPathChecker}s or
+     * target certificate constraints are never cached. By default, results
+     * are not reused.
+     *
+     * @param val whether validation results may be reused
+     * @hide
+     */
+    public void setResultCacheEnabled(boolean val) {
+        resultCacheEnabled = val;
+    }
+
+    /**
+     * Returns whether validation results may be reused. See
+     * {@link #setResultCacheEnabled}.
+     *
+     * @hide
+     */
+    public boolean isResultCacheEnabled() {
+        return resultCacheEnabled;
+    }
+    // END Android-added: Opt-in caching of validation results.
+
     /**
      * Sets the ExplicitPolicyRequired flag. If this flag is true, an
      * acceptable policy needs to be explicitly identified in every certificate.
@@ -49,6 +49,8 @@ import java.math.RoundingMode;
 import java.util.Currency;
 import java.util.Locale;
 import java.util.Objects;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicLong;
 import libcore.icu.LocaleData;
@@ -488,11 +490,80 @@ public class DecimalFormat extends NumberFormat {
      * {@link #icuDecimalFormat} in the process. This should only be called from constructors.
      */
     private void initPattern(String pattern) {
-        this.icuDecimalFormat =  new android.icu.text.DecimalFormat_ICU58_Android(pattern,
-                symbols.getIcuDecimalFormatSymbols());
+        // Android-changed: Copy a cached ICU DecimalFormat instead of parsing the pattern.
+        // this.icuDecimalFormat =  new android.icu.text.DecimalFormat_ICU58_Android(pattern,
+        //         symbols.getIcuDecimalFormatSymbols());
+        this.icuDecimalFormat = newIcuDecimalFormat(pattern, symbols.getIcuDecimalFormatSymbols());
         updateFieldsFromIcu();
     }
 
+    /**
+     * The maximum number of entries in {@link #cachedIcuDecimalFormats}.
+     */
+    private static final int MAX_CACHED_ICU_DECIMAL_FORMATS = 64;
+
+    /**
+     * ICU DecimalFormats created by {@link #initPattern}, keyed by pattern and symbols. These
+     * are never modified; each DecimalFormat uses its own clone. Instances created with the
+     * symbols of {@link DecimalFormatSymbols#getInstance(Locale)} share the same ICU symbols
+     * and so the same entries.
+     */
+    private static final ConcurrentMap<IcuDecimalFormatKey,
+            android.icu.text.DecimalFormat_ICU58_Android> cachedIcuDecimalFormats =
+                    new ConcurrentHashMap<>();
+
+    private static android.icu.text.DecimalFormat_ICU58_Android newIcuDecimalFormat(
+            String pattern, android.icu.text.DecimalFormatSymbols icuSymbols) {
+        IcuDecimalFormatKey key = new IcuDecimalFormatKey(pattern, icuSymbols);
+        android.icu.text.DecimalFormat_ICU58_Android cached = cachedIcuDecimalFormats.get(key);
+        if (cached == null) {
+            cached = new android.icu.text.DecimalFormat_ICU58_Android(pattern, icuSymbols);
+            if (cachedIcuDecimalFormats.size() >= MAX_CACHED_ICU_DECIMAL_FORMATS) {
+                cachedIcuDecimalFormats.clear();
+            }
+            cachedIcuDecimalFormats.putIfAbsent(key, cached);
+        }
+        return (android.icu.text.DecimalFormat_ICU58_Android) cached.clone();
+    }
+
+    /**
+     * Key of {@link #cachedIcuDecimalFormats}. Symbols are compared by identity; equal but
+     * distinct symbols only cause a cache miss.
+     */
+    private static final class IcuDecimalFormatKey {
+        private final String pattern;
+        private final android.icu.text.DecimalFormatSymbols icuSymbols;
+        private final int hash;
+
+        IcuDecimalFormatKey(String pattern, android.icu.text.DecimalFormatSymbols icuSymbols) {
+            this.pattern = pattern;
+            this.icuSymbols = icuSymbols;
+            this.hash = 31 * pattern.hashCode() + System.identityHashCode(icuSymbols);
+        }
+
+        @Override
+        public int hashCode() {
+            return hash;
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            if (!(o instanceof IcuDecimalFormatKey)) {
+                return false;
+            }
+            IcuDecimalFormatKey that = (IcuDecimalFormatKey) o;
+            return icuSymbols == that.icuSymbols && pattern.equals(that.pattern);
+        }
+    }
+
+    /**
+     * Returns the zero digit of this format's symbols, without copying them as
+     * {@link #getDecimalFormatSymbols()} does.
+     */
+    char getZeroDigit() {
+        return symbols.getZeroDigit();
+    }
+
     /**
      * Update local fields indicating maximum/minimum integer/fraction digit count from the ICU
      * DecimalFormat. This needs to be called whenever a new pattern is applied.
@@ -46,6 +46,8 @@ import java.io.ObjectStreamField;
 import java.io.Serializable;
 import java.util.Currency;
 import java.util.Locale;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
 import libcore.icu.ICU;
 import libcore.icu.LocaleData;
 
@@ -153,9 +155,37 @@ public class DecimalFormatSymbols implements Cloneable, Serializable {
      */
     public static final DecimalFormatSymbols getInstance(Locale locale) {
         // Android-changed: Removed used of DecimalFormatSymbolsProvider.
-        return new DecimalFormatSymbols(locale);
+        // BEGIN Android-changed: Return a copy of a cached instance.
+        // return new DecimalFormatSymbols(locale);
+        DecimalFormatSymbols cached = cachedInstances.get(locale);
+        if (cached == null) {
+            cached = new DecimalFormatSymbols(locale);
+            // Create the ICU symbols up front so that all copies share them.
+            cached.getIcuDecimalFormatSymbols();
+            if (cachedInstances.size() >= MAX_CACHED_INSTANCES) {
+                cachedInstances.clear();
+            }
+            cachedInstances.putIfAbsent(locale, cached);
+        }
+        return (DecimalFormatSymbols) cached.clone();
+        // END Android-changed: Return a copy of a cached instance.
     }
 
+    // BEGIN Android-added: Cache of instances returned by getInstance(Locale).
+    /**
+     * The maximum number of locales in {@link #cachedInstances}.
+     */
+    private static final int MAX_CACHED_INSTANCES = 32;
+
+    /**
+     * Fully initialized instances, including their ICU symbols, by locale. These are never
+     * modified; {@link #getInstance(Locale)} returns clones, which share the ICU symbols until
+     * a setter is called on them.
+     */
+    private static final ConcurrentMap<Locale, DecimalFormatSymbols> cachedInstances =
+            new ConcurrentHashMap<>(3);
+    // END Android-added: Cache of instances returned by getInstance(Locale).
+
     /**
      * Gets the character used for zero. Different for Arabic, etc.
      *
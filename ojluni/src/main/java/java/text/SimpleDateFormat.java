@@ -496,6 +496,14 @@ public class SimpleDateFormat extends DateFormat {
     transient private NumberFormat originalNumberFormat;
     transient private String originalNumberPattern;
 
+    // BEGIN Android-added: Format other unbounded fields without NumberFormat.
+    /**
+     * The numberFormat created by this format for its locale, or null. Numbers
+     * are only formatted without NumberFormat while this is numberFormat.
+     */
+    transient private NumberFormat ownNumberFormat;
+    // END Android-added: Format other unbounded fields without NumberFormat.
+
     /**
      * The minus sign to be used with format and parse.
      */
@@ -568,6 +576,20 @@ public class SimpleDateFormat extends DateFormat {
     private static final ConcurrentMap<Locale, NumberFormat> cachedNumberFormatData
         = new ConcurrentHashMap<>(3);
 
+    // BEGIN Android-added: Cache compiled patterns.
+    /**
+     * The maximum number of patterns in {@link #cachedCompiledPatterns}.
+     */
+    private static final int MAX_CACHED_COMPILED_PATTERNS = 64;
+
+    /**
+     * Cache compiled patterns with pattern key. Compiled patterns are never
+     * modified, so instances share them.
+     */
+    private static final ConcurrentMap<String, char[]> cachedCompiledPatterns
+        = new ConcurrentHashMap<>();
+    // END Android-added: Cache compiled patterns.
+
     /**
      * The Locale used to instantiate this
      * <code>SimpleDateFormat</code>. The value may be null if this object
@@ -715,7 +737,8 @@ public class SimpleDateFormat extends DateFormat {
     /* Initialize compiledPattern and numberFormat fields */
     private void initialize(Locale loc) {
         // Verify and compile the given pattern.
-        compiledPattern = compile(pattern);
+        // Android-changed: Cache compiled patterns.
+        compiledPattern = compileCached(pattern);
 
         /* try the cache first */
         numberFormat = cachedNumberFormatData.get(loc);
@@ -727,6 +750,8 @@ public class SimpleDateFormat extends DateFormat {
             cachedNumberFormatData.putIfAbsent(loc, numberFormat);
         }
         numberFormat = (NumberFormat) numberFormat.clone();
+        // Android-added: Format other unbounded fields without NumberFormat.
+        ownNumberFormat = numberFormat;
 
         initializeDefaultCentury();
     }
@@ -806,6 +831,24 @@ public class SimpleDateFormat extends DateFormat {
      * @exception NullPointerException if the given pattern is null
      * @exception IllegalArgumentException if the given pattern is invalid
      */
+    // BEGIN Android-added: Cache compiled patterns.
+    /**
+     * Returns the compiled form of the given pattern, like {@link #compile},
+     * from a shared cache. The returned array must not be modified.
+     */
+    private char[] compileCached(String pattern) {
+        char[] compiled = cachedCompiledPatterns.get(pattern);
+        if (compiled == null) {
+            compiled = compile(pattern);
+            if (cachedCompiledPatterns.size() >= MAX_CACHED_COMPILED_PATTERNS) {
+                cachedCompiledPatterns.clear();
+            }
+            cachedCompiledPatterns.putIfAbsent(pattern, compiled);
+        }
+        return compiled;
+    }
+    // END Android-added: Cache compiled patterns.
+
     private char[] compile(String pattern) {
         int length = pattern.length();
         boolean inQuote = false;
@@ -1642,7 +1685,9 @@ public class SimpleDateFormat extends DateFormat {
         // either 2 or Integer.MAX_VALUE (maxIntCount in format()).
         try {
             if (zeroDigit == 0) {
-                zeroDigit = ((DecimalFormat)numberFormat).getDecimalFormatSymbols().getZeroDigit();
+                // Android-changed: Avoid copying the symbols to read the zero digit.
+                // zeroDigit = ((DecimalFormat)numberFormat).getDecimalFormatSymbols().getZeroDigit();
+                zeroDigit = ((DecimalFormat)numberFormat).getZeroDigit();
             }
             if (value >= 0) {
                 if (value < 100 && minDigits >= 1 && minDigits <= 2) {
@@ -1671,6 +1716,27 @@ public class SimpleDateFormat extends DateFormat {
                         return;
                     }
                 }
+                // BEGIN Android-added: Format other unbounded fields without NumberFormat.
+                // This covers e.g. 3-digit milliseconds and 5-digit years. A
+                // NumberFormat set by the caller, or the format's own one once
+                // grouping is turned on, may format these differently.
+                if (maxDigits == Integer.MAX_VALUE && minDigits <= 10
+                        && numberFormat == ownNumberFormat && !numberFormat.isGroupingUsed()) {
+                    int digits = 1;
+                    int divisor = 1;
+                    while (digits < 10 && value / divisor >= 10) {
+                        divisor *= 10;
+                        digits++;
+                    }
+                    for (int i = digits; i < minDigits; i++) {
+                        buffer.append(zeroDigit);
+                    }
+                    for (; divisor > 0; divisor /= 10) {
+                        buffer.append((char)(zeroDigit + (value / divisor) % 10));
+                    }
+                    return;
+                }
+                // END Android-added: Format other unbounded fields without NumberFormat.
             }
         } catch (Exception e) {
         }
@@ -2886,7 +2952,8 @@ public class SimpleDateFormat extends DateFormat {
     }
 
     private void applyPatternImpl(String pattern) {
-        compiledPattern = compile(pattern);
+        // Android-changed: Cache compiled patterns.
+        compiledPattern = compileCached(pattern);
         this.pattern = pattern;
     }
 
@@ -2940,6 +3007,8 @@ public class SimpleDateFormat extends DateFormat {
     public Object clone() {
         SimpleDateFormat other = (SimpleDateFormat) super.clone();
         other.formatData = (DateFormatSymbols) formatData.clone();
+        // Android-added: Format other unbounded fields without NumberFormat.
+        other.ownNumberFormat = (ownNumberFormat == numberFormat) ? other.numberFormat : null;
         return other;
     }
 
@@ -230,6 +230,9 @@ public class Base64 {
         private static final int MIMELINEMAX = 76;
         private static final byte[] CRLF = new byte[] {'\r', '\n'};
 
+        // Android-added: Encode direct buffers in bounded chunks.
+        private static final int DIRECT_CHUNK_LENGTH = 8192;
+
         static final Encoder RFC4648 = new Encoder(false, null, -1, true);
         static final Encoder RFC4648_URLSAFE = new Encoder(true, null, -1, true);
         static final Encoder RFC2045 = new Encoder(false, CRLF, MIMELINEMAX, true);
@@ -341,9 +344,30 @@ public class Base64 {
                               dst);
                 buffer.position(buffer.limit());
             } else {
-                byte[] src = new byte[buffer.remaining()];
-                buffer.get(src);
-                ret = encode0(src, 0, src.length, dst);
+                // BEGIN Android-changed: Encode direct buffers in bounded chunks.
+                // byte[] src = new byte[buffer.remaining()];
+                // buffer.get(src);
+                // ret = encode0(src, 0, src.length, dst);
+                // Every chunk but the last is a whole number of 3-byte groups
+                // (and of lines, if there are any), so the chunks encode
+                // exactly as the whole input would, with no padding between.
+                int chunkLength = DIRECT_CHUNK_LENGTH / 3 * 3;
+                if (linemax > 0) {
+                    int lineBytes = linemax / 4 * 3;
+                    chunkLength = Math.max(1, DIRECT_CHUNK_LENGTH / lineBytes) * lineBytes;
+                }
+                byte[] src = new byte[Math.min(buffer.remaining(), chunkLength)];
+                while (buffer.hasRemaining()) {
+                    int n = Math.min(buffer.remaining(), src.length);
+                    buffer.get(src, 0, n);
+                    if (ret > 0 && linemax > 0) {
+                        for (byte b : newline) {
+                            dst[ret++] = b;
+                        }
+                    }
+                    ret = encode0(src, 0, n, dst, ret);
+                }
+                // END Android-changed: Encode direct buffers in bounded chunks.
             }
             if (ret != dst.length)
                  dst = Arrays.copyOf(dst, ret);
@@ -389,13 +413,18 @@ public class Base64 {
         }
 
         private int encode0(byte[] src, int off, int end, byte[] dst) {
+            return encode0(src, off, end, dst, 0);
+        }
+
+        // Android-changed: Added dp parameter to encode into the middle of dst.
+        private int encode0(byte[] src, int off, int end, byte[] dst, int dp) {
             char[] base64 = isURL ? toBase64URL : toBase64;
             int sp = off;
             int slen = (end - off) / 3 * 3;
             int sl = off + slen;
             if (linemax > 0 && slen  > linemax / 4 * 3)
                 slen = linemax / 4 * 3;
-            int dp = 0;
+            // int dp = 0;
             while (sp < sl) {
                 int sl0 = Math.min(sp + slen, sl);
                 for (int sp0 = sp, dp0 = dp ; sp0 < sl0; ) {
@@ -691,6 +720,30 @@ public class Base64 {
             int bits = 0;
             int shiftto = 18;       // pos of first byte of 4-byte atom
             while (sp < sl) {
+                // BEGIN Android-added: Decode whole 4-byte units at a time.
+                // Units containing padding, line separators or illegal
+                // characters fall through to the byte at a time loop below,
+                // which reports errors exactly as before.
+                if (shiftto == 18) {
+                    int sl0 = sp + ((sl - sp) & ~3);
+                    while (sp < sl0) {
+                        int b1 = base64[src[sp] & 0xff];
+                        int b2 = base64[src[sp + 1] & 0xff];
+                        int b3 = base64[src[sp + 2] & 0xff];
+                        int b4 = base64[src[sp + 3] & 0xff];
+                        if ((b1 | b2 | b3 | b4) < 0)
+                            break;
+                        int bits0 = b1 << 18 | b2 << 12 | b3 << 6 | b4;
+                        dst[dp] = (byte)(bits0 >> 16);
+                        dst[dp + 1] = (byte)(bits0 >> 8);
+                        dst[dp + 2] = (byte)bits0;
+                        dp += 3;
+                        sp += 4;
+                    }
+                    if (sp == sl)
+                        break;
+                }
+                // END Android-added: Decode whole 4-byte units at a time.
                 int b = src[sp++] & 0xff;
                 if ((b = base64[b]) < 0) {
                     if (b == -2) {         // padding byte '='
@@ -761,6 +814,13 @@ public class Base64 {
         private final boolean doPadding;// whether or not to pad
         private int linepos = 0;
 
+        // BEGIN Android-added: Pass encoded bytes to the underlying stream in bulk.
+        private static final int ENC_BUFFER_LENGTH = 1024;
+        private final byte[] buf = new byte[ENC_BUFFER_LENGTH];
+        private int bufpos = 0;
+        private byte[] singleByte;
+        // END Android-added: Pass encoded bytes to the underlying stream in bulk.
+
         EncOutputStream(OutputStream os, char[] base64,
                         byte[] newline, int linemax, boolean doPadding) {
             super(os);
@@ -772,18 +832,73 @@ public class Base64 {
 
         @Override
         public void write(int b) throws IOException {
-            byte[] buf = new byte[1];
-            buf[0] = (byte)(b & 0xff);
-            write(buf, 0, 1);
+            // Android-changed: Reuse the single byte array.
+            // byte[] buf = new byte[1];
+            if (singleByte == null)
+                singleByte = new byte[1];
+            singleByte[0] = (byte)(b & 0xff);
+            write(singleByte, 0, 1);
         }
 
         private void checkNewline() throws IOException {
             if (linepos == linemax) {
-                out.write(newline);
+                // Android-changed: Pass encoded bytes to the underlying stream in bulk.
+                // out.write(newline);
+                put(newline);
                 linepos = 0;
             }
         }
 
+        // BEGIN Android-added: Pass encoded bytes to the underlying stream in bulk.
+        // Buffered output is always passed on before write() or close()
+        // returns, so flush() needs no changes.
+        private void put(int b) throws IOException {
+            if (bufpos == buf.length)
+                flushBuffer();
+            buf[bufpos++] = (byte) b;
+        }
+
+        private void put(byte[] b) throws IOException {
+            for (byte x : b)
+                put(x);
+        }
+
+        private void flushBuffer() throws IOException {
+            if (bufpos > 0) {
+                out.write(buf, 0, bufpos);
+                bufpos = 0;
+            }
+        }
+
+        // Encodes {@code n} complete 3-byte groups from b[off..].
+        private void encodeGroups(byte[] b, int off, int n) throws IOException {
+            while (n > 0) {
+                checkNewline();
+                // Encode up to the end of the line, or as much as fits.
+                int groups = Math.min(n, (buf.length - bufpos) / 4);
+                if (linemax > 0)
+                    groups = Math.min(groups, (linemax - linepos) / 4);
+                if (groups == 0) {
+                    flushBuffer();
+                    continue;
+                }
+                int bp = bufpos;
+                for (int i = 0; i < groups; i++) {
+                    int bits = (b[off++] & 0xff) << 16 |
+                               (b[off++] & 0xff) <<  8 |
+                               (b[off++] & 0xff);
+                    buf[bp++] = (byte)base64[(bits >>> 18) & 0x3f];
+                    buf[bp++] = (byte)base64[(bits >>> 12) & 0x3f];
+                    buf[bp++] = (byte)base64[(bits >>> 6)  & 0x3f];
+                    buf[bp++] = (byte)base64[bits & 0x3f];
+                }
+                bufpos = bp;
+                linepos += groups * 4;
+                n -= groups;
+            }
+        }
+        // END Android-added: Pass encoded bytes to the underlying stream in bulk.
+
         @Override
         public void write(byte[] b, int off, int len) throws IOException {
             if (closed)
@@ -807,14 +922,18 @@ public class Base64 {
                 b2 = b[off++] & 0xff;
                 len--;
                 checkNewline();
-                out.write(base64[b0 >> 2]);
-                out.write(base64[(b0 << 4) & 0x3f | (b1 >> 4)]);
-                out.write(base64[(b1 << 2) & 0x3f | (b2 >> 6)]);
-                out.write(base64[b2 & 0x3f]);
+                // BEGIN Android-changed: Pass encoded bytes to the underlying stream in bulk.
+                put(base64[b0 >> 2]);
+                put(base64[(b0 << 4) & 0x3f | (b1 >> 4)]);
+                put(base64[(b1 << 2) & 0x3f | (b2 >> 6)]);
+                put(base64[b2 & 0x3f]);
+                // END Android-changed: Pass encoded bytes to the underlying stream in bulk.
                 linepos += 4;
             }
             int nBits24 = len / 3;
             leftover = len - (nBits24 * 3);
+            // BEGIN Android-changed: Pass encoded bytes to the underlying stream in bulk.
+            /*
             while (nBits24-- > 0) {
                 checkNewline();
                 int bits = (b[off++] & 0xff) << 16 |
@@ -826,6 +945,11 @@ public class Base64 {
                 out.write(base64[bits & 0x3f]);
                 linepos += 4;
            }
+            */
+            encodeGroups(b, off, nBits24);
+            off += nBits24 * 3;
+            flushBuffer();
+            // END Android-changed: Pass encoded bytes to the underlying stream in bulk.
             if (leftover == 1) {
                 b0 = b[off++] & 0xff;
             } else if (leftover == 2) {
@@ -838,24 +962,27 @@ public class Base64 {
         public void close() throws IOException {
             if (!closed) {
                 closed = true;
+                // BEGIN Android-changed: Pass encoded bytes to the underlying stream in bulk.
                 if (leftover == 1) {
                     checkNewline();
-                    out.write(base64[b0 >> 2]);
-                    out.write(base64[(b0 << 4) & 0x3f]);
+                    put(base64[b0 >> 2]);
+                    put(base64[(b0 << 4) & 0x3f]);
                     if (doPadding) {
-                        out.write('=');
-                        out.write('=');
+                        put('=');
+                        put('=');
                     }
                 } else if (leftover == 2) {
                     checkNewline();
-                    out.write(base64[b0 >> 2]);
-                    out.write(base64[(b0 << 4) & 0x3f | (b1 >> 4)]);
-                    out.write(base64[(b1 << 2) & 0x3f]);
+                    put(base64[b0 >> 2]);
+                    put(base64[(b0 << 4) & 0x3f | (b1 >> 4)]);
+                    put(base64[(b1 << 2) & 0x3f]);
                     if (doPadding) {
-                       out.write('=');
+                       put('=');
                     }
                 }
                 leftover = 0;
+                flushBuffer();
+                // END Android-changed: Pass encoded bytes to the underlying stream in bulk.
                 out.close();
             }
         }
@@ -877,6 +1004,13 @@ public class Base64 {
         private boolean eof = false;
         private boolean closed = false;
 
+        // BEGIN Android-added: Read encoded bytes from the underlying stream in bulk.
+        private static final int DEC_BUFFER_LENGTH = 1024;
+        private final byte[] inbuf = new byte[DEC_BUFFER_LENGTH];
+        private int inpos = 0;
+        private int inlimit = 0;
+        // END Android-added: Read encoded bytes from the underlying stream in bulk.
+
         DecInputStream(InputStream is, int[] base64, boolean isMIME) {
             this.is = is;
             this.base64 = base64;
@@ -885,6 +1019,47 @@ public class Base64 {
 
         private byte[] sbBuf = new byte[1];
 
+        // BEGIN Android-added: Read encoded bytes from the underlying stream in bulk.
+        // Returns the next encoded byte, or -1 at the end of the underlying
+        // stream. No more is read ahead than is needed to produce
+        // {@code len} decoded bytes from unbroken input, and nothing is read
+        // ahead from a stream that can't take back what follows the padding
+        // (see unreadEncoded()).
+        private int readEncoded(int len) throws IOException {
+            if (inpos == inlimit) {
+                int want = 1;
+                if (is.markSupported()) {
+                    want = Math.min(inbuf.length, (len + 2) / 3 * 4);
+                    is.mark(want);
+                }
+                int n;
+                do {
+                    n = is.read(inbuf, 0, want);
+                } while (n == 0);
+                if (n < 0)
+                    return -1;
+                inpos = 0;
+                inlimit = n;
+            }
+            return inbuf[inpos++] & 0xff;
+        }
+
+        // Leaves the bytes read ahead past the padding in the underlying
+        // stream, as if they had been read one at a time.
+        private void unreadEncoded() throws IOException {
+            if (inpos == inlimit)
+                return;
+            is.reset();
+            for (int skip = inpos; skip > 0; ) {
+                int n = is.read(inbuf, 0, skip);
+                if (n < 0)
+                    break;
+                skip -= n;
+            }
+            inpos = inlimit = 0;
+        }
+        // END Android-added: Read encoded bytes from the underlying stream in bulk.
+
         @Override
         public int read() throws IOException {
             return read(sbBuf, 0, 1) == -1 ? -1 : sbBuf[0] & 0xff;
@@ -910,7 +1085,30 @@ public class Base64 {
                 bits = 0;
             }
             while (len > 0) {
-                int v = is.read();
+                // BEGIN Android-added: Decode whole 4-byte units at a time.
+                if (nextin == 18) {
+                    int units = Math.min(len / 3, (inlimit - inpos) / 4);
+                    for (; units > 0; units--) {
+                        int b1 = base64[inbuf[inpos] & 0xff];
+                        int b2 = base64[inbuf[inpos + 1] & 0xff];
+                        int b3 = base64[inbuf[inpos + 2] & 0xff];
+                        int b4 = base64[inbuf[inpos + 3] & 0xff];
+                        if ((b1 | b2 | b3 | b4) < 0)
+                            break;
+                        int bits0 = b1 << 18 | b2 << 12 | b3 << 6 | b4;
+                        b[off++] = (byte)(bits0 >> 16);
+                        b[off++] = (byte)(bits0 >> 8);
+                        b[off++] = (byte)bits0;
+                        len -= 3;
+                        inpos += 4;
+                    }
+                    if (len == 0)
+                        break;
+                }
+                // END Android-added: Decode whole 4-byte units at a time.
+                // Android-changed: Read encoded bytes from the underlying stream in bulk.
+                // int v = is.read();
+                int v = readEncoded(len);
                 if (v == -1) {
                     eof = true;
                     if (nextin != 18) {
@@ -939,8 +1137,10 @@ public class Base64 {
                     // x=    shiftto==12 dangling x, invalid unit
                     // xx=   shiftto==6 && missing last '='
                     // xx=y  or last is not '='
+                    // Android-changed: Read encoded bytes from the underlying stream in bulk.
+                    // nextin == 6 && is.read() != '=') {
                     if (nextin == 18 || nextin == 12 ||
-                        nextin == 6 && is.read() != '=') {
+                        nextin == 6 && readEncoded(1) != '=') {
                         throw new IOException("Illegal base64 ending sequence:" + nextin);
                     }
                     b[off++] = (byte)(bits >> (16));
@@ -954,6 +1154,8 @@ public class Base64 {
                         }
                     }
                     eof = true;
+                    // Android-added: Read encoded bytes from the underlying stream in bulk.
+                    unreadEncoded();
                     break;
                 }
                 if ((v = base64[v]) == -1) {
@@ -987,7 +1189,9 @@ public class Base64 {
         public int available() throws IOException {
             if (closed)
                 throw new IOException("Stream is closed");
-            return is.available();   // TBD:
+            // Android-changed: Include encoded bytes that have been read ahead.
+            // return is.available();   // TBD:
+            return (inlimit - inpos) + is.available();   // TBD:
         }
 
         @Override
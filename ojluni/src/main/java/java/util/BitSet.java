@@ -29,6 +29,8 @@ import java.io.*;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.nio.LongBuffer;
+// Android-added: Range-restricted bulk operations and bulk iteration.
+import java.util.function.IntConsumer;
 import java.util.stream.IntStream;
 import java.util.stream.StreamSupport;
 
@@ -1011,6 +1013,218 @@ public class BitSet implements Cloneable, java.io.Serializable {
         checkInvariants();
     }
 
+    // BEGIN Android-added: Range-restricted bulk operations and bulk iteration.
+    /**
+     * Returns the word of {@code set} at {@code wordIndex}, or zero if it
+     * lies beyond the words in use.
+     */
+    private static long wordAt(BitSet set, int wordIndex) {
+        return (wordIndex < set.wordsInUse) ? set.words[wordIndex] : 0;
+    }
+
+    /**
+     * Returns the mask of the bits of word {@code wordIndex} that lie in
+     * {@code fromIndex} (inclusive) to {@code toIndex} (exclusive), where
+     * {@code fromIndex < toIndex}.
+     */
+    private static long rangeMask(int wordIndex, int fromIndex, int toIndex) {
+        long mask = WORD_MASK;
+        if (wordIndex == wordIndex(fromIndex))
+            mask &= WORD_MASK << fromIndex;
+        if (wordIndex == wordIndex(toIndex - 1))
+            mask &= WORD_MASK >>> -toIndex;
+        return mask;
+    }
+
+    /**
+     * Performs a logical <b>AND</b> of the bits of this bit set from
+     * {@code fromIndex} (inclusive) to {@code toIndex} (exclusive) with the
+     * corresponding bits of the argument. Bits outside the range are
+     * unchanged.
+     *
+     * @param  set a bit set
+     * @param  fromIndex index of the first bit to operate on
+     * @param  toIndex index after the last bit to operate on
+     * @throws IndexOutOfBoundsException if {@code fromIndex} is negative,
+     *         or {@code toIndex} is negative, or {@code fromIndex} is
+     *         larger than {@code toIndex}
+     * @hide
+     */
+    public void and(BitSet set, int fromIndex, int toIndex) {
+        checkRange(fromIndex, toIndex);
+        if (this == set || fromIndex == toIndex)
+            return;
+
+        int endWordIndex = Math.min(wordIndex(toIndex - 1), wordsInUse - 1);
+        for (int i = wordIndex(fromIndex); i <= endWordIndex; i++)
+            words[i] &= wordAt(set, i) | ~rangeMask(i, fromIndex, toIndex);
+
+        recalculateWordsInUse();
+        checkInvariants();
+    }
+
+    /**
+     * Performs a logical <b>OR</b> of the bits of this bit set from
+     * {@code fromIndex} (inclusive) to {@code toIndex} (exclusive) with the
+     * corresponding bits of the argument. Bits outside the range are
+     * unchanged.
+     *
+     * @param  set a bit set
+     * @param  fromIndex index of the first bit to operate on
+     * @param  toIndex index after the last bit to operate on
+     * @throws IndexOutOfBoundsException if {@code fromIndex} is negative,
+     *         or {@code toIndex} is negative, or {@code fromIndex} is
+     *         larger than {@code toIndex}
+     * @hide
+     */
+    public void or(BitSet set, int fromIndex, int toIndex) {
+        checkRange(fromIndex, toIndex);
+        if (this == set || fromIndex == toIndex)
+            return;
+
+        int startWordIndex = wordIndex(fromIndex);
+        int endWordIndex = Math.min(wordIndex(toIndex - 1), set.wordsInUse - 1);
+        if (startWordIndex > endWordIndex)
+            return;
+        expandTo(endWordIndex);
+        for (int i = startWordIndex; i <= endWordIndex; i++)
+            words[i] |= set.words[i] & rangeMask(i, fromIndex, toIndex);
+
+        recalculateWordsInUse();
+        checkInvariants();
+    }
+
+    /**
+     * Performs a logical <b>XOR</b> of the bits of this bit set from
+     * {@code fromIndex} (inclusive) to {@code toIndex} (exclusive) with the
+     * corresponding bits of the argument. Bits outside the range are
+     * unchanged.
+     *
+     * @param  set a bit set
+     * @param  fromIndex index of the first bit to operate on
+     * @param  toIndex index after the last bit to operate on
+     * @throws IndexOutOfBoundsException if {@code fromIndex} is negative,
+     *         or {@code toIndex} is negative, or {@code fromIndex} is
+     *         larger than {@code toIndex}
+     * @hide
+     */
+    public void xor(BitSet set, int fromIndex, int toIndex) {
+        checkRange(fromIndex, toIndex);
+        if (fromIndex == toIndex)
+            return;
+
+        int startWordIndex = wordIndex(fromIndex);
+        int endWordIndex = Math.min(wordIndex(toIndex - 1), set.wordsInUse - 1);
+        if (startWordIndex > endWordIndex)
+            return;
+        expandTo(endWordIndex);
+        for (int i = startWordIndex; i <= endWordIndex; i++)
+            words[i] ^= set.words[i] & rangeMask(i, fromIndex, toIndex);
+
+        recalculateWordsInUse();
+        checkInvariants();
+    }
+
+    /**
+     * Clears the bits of this bit set from {@code fromIndex} (inclusive) to
+     * {@code toIndex} (exclusive) whose corresponding bit is set in the
+     * argument. Bits outside the range are unchanged.
+     *
+     * @param  set a bit set
+     * @param  fromIndex index of the first bit to operate on
+     * @param  toIndex index after the last bit to operate on
+     * @throws IndexOutOfBoundsException if {@code fromIndex} is negative,
+     *         or {@code toIndex} is negative, or {@code fromIndex} is
+     *         larger than {@code toIndex}
+     * @hide
+     */
+    public void andNot(BitSet set, int fromIndex, int toIndex) {
+        checkRange(fromIndex, toIndex);
+        if (fromIndex == toIndex)
+            return;
+
+        int endWordIndex = Math.min(wordIndex(toIndex - 1),
+                                    Math.min(wordsInUse, set.wordsInUse) - 1);
+        for (int i = wordIndex(fromIndex); i <= endWordIndex; i++)
+            words[i] &= ~(set.words[i] & rangeMask(i, fromIndex, toIndex));
+
+        recalculateWordsInUse();
+        checkInvariants();
+    }
+
+    /**
+     * Performs the given action for the index of each bit that is set to
+     * {@code true}, in increasing order. This visits each word once rather
+     * than searching again from each index, as a loop over
+     * {@link #nextSetBit(int)} does.
+     *
+     * <p>The bit set must not be modified by the action.
+     *
+     * @param  action the action to be performed for each index
+     * @throws NullPointerException if the specified action is null
+     * @hide
+     */
+    public void forEachSetBit(IntConsumer action) {
+        Objects.requireNonNull(action);
+        checkInvariants();
+
+        for (int u = 0; u < wordsInUse; u++) {
+            long word = words[u];
+            int base = u * BITS_PER_WORD;
+            while (word != 0) {
+                action.accept(base + Long.numberOfTrailingZeros(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    /**
+     * Copies the indices of up to {@code len} bits that are set to
+     * {@code true}, starting with the first such bit on or after
+     * {@code fromIndex}, into {@code dst} in increasing order. To export
+     * all set bits in chunks, call again with {@code fromIndex} one more
+     * than the last index copied until fewer than {@code len} are returned.
+     *
+     * @param  fromIndex the index to start checking from (inclusive)
+     * @param  dst the array to copy indices into
+     * @param  off the first position of {@code dst} to write
+     * @param  len the maximum number of indices to copy
+     * @return the number of indices copied
+     * @throws IndexOutOfBoundsException if {@code fromIndex} is negative,
+     *         or {@code off} and {@code len} do not describe a range of
+     *         {@code dst}
+     * @hide
+     */
+    public int nextSetBits(int fromIndex, int[] dst, int off, int len) {
+        if (fromIndex < 0)
+            throw new IndexOutOfBoundsException("fromIndex < 0: " + fromIndex);
+        if (off < 0 || len < 0 || len > dst.length - off)
+            throw new IndexOutOfBoundsException("off: " + off + ", len: " + len +
+                                                ", length: " + dst.length);
+        checkInvariants();
+
+        int u = wordIndex(fromIndex);
+        if (u >= wordsInUse || len == 0)
+            return 0;
+
+        int dp = off;
+        int end = off + len;
+        long word = words[u] & (WORD_MASK << fromIndex);
+        while (true) {
+            int base = u * BITS_PER_WORD;
+            while (word != 0) {
+                dst[dp++] = base + Long.numberOfTrailingZeros(word);
+                if (dp == end)
+                    return len;
+                word &= word - 1;
+            }
+            if (++u == wordsInUse)
+                return dp - off;
+            word = words[u];
+        }
+    }
+    // END Android-added: Range-restricted bulk operations and bulk iteration.
+
     /**
      * Returns the hash code value for this bit set. The hash code depends
      * only on which bits are set within this {@code BitSet}.
@@ -142,7 +142,9 @@ final class DualPivotQuicksort {
              * use Quicksort instead of merge sort.
              */
             if (++count == MAX_RUN_COUNT) {
-                sort(a, left, right, true);
+                // Android-changed: Use radix sort for large unstructured ranges.
+                // sort(a, left, right, true);
+                sortUnstructured(a, left, right, work, workBase, workLen);
                 return;
             }
         }
@@ -590,7 +592,9 @@ final class DualPivotQuicksort {
              * use Quicksort instead of merge sort.
              */
             if (++count == MAX_RUN_COUNT) {
-                sort(a, left, right, true);
+                // Android-changed: Use radix sort for large unstructured ranges.
+                // sort(a, left, right, true);
+                sortUnstructured(a, left, right, work, workBase, workLen);
                 return;
             }
         }
@@ -2138,7 +2142,9 @@ final class DualPivotQuicksort {
              * use Quicksort instead of merge sort.
              */
             if (++count == MAX_RUN_COUNT) {
-                sort(a, left, right, true);
+                // Android-changed: Use radix sort for large unstructured ranges.
+                // sort(a, left, right, true);
+                sortUnstructured(a, left, right, work, workBase, workLen);
                 return;
             }
         }
@@ -2677,7 +2683,9 @@ final class DualPivotQuicksort {
              * use Quicksort instead of merge sort.
              */
             if (++count == MAX_RUN_COUNT) {
-                sort(a, left, right, true);
+                // Android-changed: Use radix sort for large unstructured ranges.
+                // sort(a, left, right, true);
+                sortUnstructured(a, left, right, work, workBase, workLen);
                 return;
             }
         }
@@ -3075,4 +3083,296 @@ final class DualPivotQuicksort {
             sort(a, great + 1, right, false);
         }
     }
+
+    // BEGIN Android-added: LSD radix sort for large unstructured ranges.
+    /*
+     * Large ranges that are not nearly sorted are sorted with a least
+     * significant digit radix sort, one byte at a time. Its cost is linear
+     * in the length of the range, whereas Quicksort makes O(log(n))
+     * passes; it is only worthwhile once the range is long enough to
+     * amortize the histogram and the extra memory traffic. Digits that are
+     * the same for every element (common when the values span a small
+     * range) are skipped.
+     *
+     * The keys are ordered as unsigned integers: the sign bit of integral
+     * values is flipped, and for floating-point values all bits of negative
+     * numbers are flipped, which places -0.0 before 0.0. NaNs have already
+     * been moved out of the range by the callers.
+     */
+
+    /**
+     * If the length of an unstructured range to be sorted is at least this
+     * constant, radix sort is used in preference to Quicksort.
+     */
+    private static final int RADIX_SORT_THRESHOLD = 1 << 13;
+
+    /**
+     * Radix sort needs a scratch array as long as the range, whereas
+     * Quicksort sorts in place. Longer ranges are sorted with Quicksort so
+     * that sorting a large array doesn't need up to as much memory again.
+     */
+    private static final int RADIX_SORT_MAX_ALLOCATION = 1 << 20;
+
+    private static final int RADIX_BITS = 8;
+    private static final int RADIX = 1 << RADIX_BITS;
+    private static final int RADIX_MASK = RADIX - 1;
+
+    /**
+     * Converts counts[base .. base + RADIX) into starting offsets. Returns
+     * false if every element has the same digit, so the pass can be
+     * skipped.
+     */
+    private static boolean toOffsets(int[] counts, int base, int length) {
+        int sum = 0;
+        for (int i = base; i < base + RADIX; i++) {
+            int c = counts[i];
+            if (c == length) {
+                return false;
+            }
+            counts[i] = sum;
+            sum += c;
+        }
+        return true;
+    }
+
+    /**
+     * Returns a scratch array for radix sort, or null if there isn't
+     * enough memory, in which case the range is sorted in place instead.
+     */
+    private static int[] newIntWork(int length) {
+        try {
+            return new int[length];
+        } catch (OutOfMemoryError e) {
+            return null;
+        }
+    }
+
+    private static void sortUnstructured(int[] a, int left, int right,
+                                         int[] work, int workBase, int workLen) {
+        int length = right - left + 1;
+        if (length < RADIX_SORT_THRESHOLD) {
+            sort(a, left, right, true);
+            return;
+        }
+        if (work == null || workLen < length || workBase + length > work.length) {
+            work = (length <= RADIX_SORT_MAX_ALLOCATION) ? newIntWork(length) : null;
+            if (work == null) {
+                sort(a, left, right, true);
+                return;
+            }
+            workBase = 0;
+        }
+
+        int[] counts = new int[4 * RADIX];
+        for (int i = left; i <= right; i++) {
+            int key = a[i] ^ Integer.MIN_VALUE;
+            counts[key & RADIX_MASK]++;
+            counts[RADIX + ((key >>> 8) & RADIX_MASK)]++;
+            counts[2 * RADIX + ((key >>> 16) & RADIX_MASK)]++;
+            counts[3 * RADIX + (key >>> 24)]++;
+        }
+
+        int[] src = a, dst = work;
+        int srcBase = left, dstBase = workBase;
+        for (int pass = 0, shift = 0; pass < 4; pass++, shift += RADIX_BITS) {
+            int base = pass * RADIX;
+            if (!toOffsets(counts, base, length)) {
+                continue;
+            }
+            for (int i = srcBase, end = srcBase + length; i < end; i++) {
+                int v = src[i];
+                dst[dstBase + counts[base + (((v ^ Integer.MIN_VALUE) >>> shift) & RADIX_MASK)]++] = v;
+            }
+            int[] t = src; src = dst; dst = t;
+            int o = srcBase; srcBase = dstBase; dstBase = o;
+        }
+        if (src != a) {
+            System.arraycopy(src, srcBase, a, left, length);
+        }
+    }
+
+    /**
+     * Returns a scratch array for radix sort, or null if there isn't
+     * enough memory, in which case the range is sorted in place instead.
+     */
+    private static long[] newLongWork(int length) {
+        try {
+            return new long[length];
+        } catch (OutOfMemoryError e) {
+            return null;
+        }
+    }
+
+    private static void sortUnstructured(long[] a, int left, int right,
+                                         long[] work, int workBase, int workLen) {
+        int length = right - left + 1;
+        if (length < RADIX_SORT_THRESHOLD) {
+            sort(a, left, right, true);
+            return;
+        }
+        if (work == null || workLen < length || workBase + length > work.length) {
+            work = (length <= RADIX_SORT_MAX_ALLOCATION) ? newLongWork(length) : null;
+            if (work == null) {
+                sort(a, left, right, true);
+                return;
+            }
+            workBase = 0;
+        }
+
+        int[] counts = new int[8 * RADIX];
+        for (int i = left; i <= right; i++) {
+            long key = a[i] ^ Long.MIN_VALUE;
+            for (int pass = 0; pass < 8; pass++, key >>>= RADIX_BITS) {
+                counts[pass * RADIX + (int) (key & RADIX_MASK)]++;
+            }
+        }
+
+        long[] src = a, dst = work;
+        int srcBase = left, dstBase = workBase;
+        for (int pass = 0, shift = 0; pass < 8; pass++, shift += RADIX_BITS) {
+            int base = pass * RADIX;
+            if (!toOffsets(counts, base, length)) {
+                continue;
+            }
+            for (int i = srcBase, end = srcBase + length; i < end; i++) {
+                long v = src[i];
+                dst[dstBase + counts[base + (int) (((v ^ Long.MIN_VALUE) >>> shift) & RADIX_MASK)]++] = v;
+            }
+            long[] t = src; src = dst; dst = t;
+            int o = srcBase; srcBase = dstBase; dstBase = o;
+        }
+        if (src != a) {
+            System.arraycopy(src, srcBase, a, left, length);
+        }
+    }
+
+    /**
+     * Returns the bits of {@code f} transformed so that their unsigned
+     * order is the order of {@link Float#compare}, for non-NaN values.
+     */
+    private static int radixKey(float f) {
+        int bits = Float.floatToRawIntBits(f);
+        return bits ^ ((bits >> 31) | Integer.MIN_VALUE);
+    }
+
+    /**
+     * Returns a scratch array for radix sort, or null if there isn't
+     * enough memory, in which case the range is sorted in place instead.
+     */
+    private static float[] newFloatWork(int length) {
+        try {
+            return new float[length];
+        } catch (OutOfMemoryError e) {
+            return null;
+        }
+    }
+
+    private static void sortUnstructured(float[] a, int left, int right,
+                                         float[] work, int workBase, int workLen) {
+        int length = right - left + 1;
+        if (length < RADIX_SORT_THRESHOLD) {
+            sort(a, left, right, true);
+            return;
+        }
+        if (work == null || workLen < length || workBase + length > work.length) {
+            work = (length <= RADIX_SORT_MAX_ALLOCATION) ? newFloatWork(length) : null;
+            if (work == null) {
+                sort(a, left, right, true);
+                return;
+            }
+            workBase = 0;
+        }
+
+        int[] counts = new int[4 * RADIX];
+        for (int i = left; i <= right; i++) {
+            int key = radixKey(a[i]);
+            counts[key & RADIX_MASK]++;
+            counts[RADIX + ((key >>> 8) & RADIX_MASK)]++;
+            counts[2 * RADIX + ((key >>> 16) & RADIX_MASK)]++;
+            counts[3 * RADIX + (key >>> 24)]++;
+        }
+
+        float[] src = a, dst = work;
+        int srcBase = left, dstBase = workBase;
+        for (int pass = 0, shift = 0; pass < 4; pass++, shift += RADIX_BITS) {
+            int base = pass * RADIX;
+            if (!toOffsets(counts, base, length)) {
+                continue;
+            }
+            for (int i = srcBase, end = srcBase + length; i < end; i++) {
+                float v = src[i];
+                dst[dstBase + counts[base + ((radixKey(v) >>> shift) & RADIX_MASK)]++] = v;
+            }
+            float[] t = src; src = dst; dst = t;
+            int o = srcBase; srcBase = dstBase; dstBase = o;
+        }
+        if (src != a) {
+            System.arraycopy(src, srcBase, a, left, length);
+        }
+    }
+
+    /**
+     * Returns the bits of {@code d} transformed so that their unsigned
+     * order is the order of {@link Double#compare}, for non-NaN values.
+     */
+    private static long radixKey(double d) {
+        long bits = Double.doubleToRawLongBits(d);
+        return bits ^ ((bits >> 63) | Long.MIN_VALUE);
+    }
+
+    /**
+     * Returns a scratch array for radix sort, or null if there isn't
+     * enough memory, in which case the range is sorted in place instead.
+     */
+    private static double[] newDoubleWork(int length) {
+        try {
+            return new double[length];
+        } catch (OutOfMemoryError e) {
+            return null;
+        }
+    }
+
+    private static void sortUnstructured(double[] a, int left, int right,
+                                         double[] work, int workBase, int workLen) {
+        int length = right - left + 1;
+        if (length < RADIX_SORT_THRESHOLD) {
+            sort(a, left, right, true);
+            return;
+        }
+        if (work == null || workLen < length || workBase + length > work.length) {
+            work = (length <= RADIX_SORT_MAX_ALLOCATION) ? newDoubleWork(length) : null;
+            if (work == null) {
+                sort(a, left, right, true);
+                return;
+            }
+            workBase = 0;
+        }
+
+        int[] counts = new int[8 * RADIX];
+        for (int i = left; i <= right; i++) {
+            long key = radixKey(a[i]);
+            for (int pass = 0; pass < 8; pass++, key >>>= RADIX_BITS) {
+                counts[pass * RADIX + (int) (key & RADIX_MASK)]++;
+            }
+        }
+
+        double[] src = a, dst = work;
+        int srcBase = left, dstBase = workBase;
+        for (int pass = 0, shift = 0; pass < 8; pass++, shift += RADIX_BITS) {
+            int base = pass * RADIX;
+            if (!toOffsets(counts, base, length)) {
+                continue;
+            }
+            for (int i = srcBase, end = srcBase + length; i < end; i++) {
+                double v = src[i];
+                dst[dstBase + counts[base + (int) ((radixKey(v) >>> shift) & RADIX_MASK)]++] = v;
+            }
+            double[] t = src; src = dst; dst = t;
+            int o = srcBase; srcBase = dstBase; dstBase = o;
+        }
+        if (src != a) {
+            System.arraycopy(src, srcBase, a, left, length);
+        }
+    }
+    // END Android-added: LSD radix sort for large unstructured ranges.
 }
@@ -55,6 +55,8 @@ import java.time.ZoneOffset;
 import java.time.temporal.ChronoField;
 import java.time.temporal.TemporalAccessor;
 import java.time.temporal.TemporalQueries;
+// Android-added: Cache locale symbols.
+import java.util.concurrent.ConcurrentHashMap;
 
 import libcore.icu.LocaleData;
 import sun.misc.FpUtils;
@@ -2284,8 +2286,10 @@ public final class Formatter implements Closeable, Flushable {
 
     private static char getZero(Locale l) {
         if ((l != null) && !l.equals(Locale.US)) {
-            DecimalFormatSymbols dfs = DecimalFormatSymbols.getInstance(l);
-            return dfs.getZeroDigit();
+            // Android-changed: Cache locale symbols.
+            // DecimalFormatSymbols dfs = DecimalFormatSymbols.getInstance(l);
+            // return dfs.getZeroDigit();
+            return getLocaleSymbols(l).zero;
         } else {
             return '0';
         }
@@ -2502,9 +2506,23 @@ public final class Formatter implements Closeable, Flushable {
         // last ordinary index
         int lasto = -1;
 
-        FormatString[] fsa = parse(format);
-        for (int i = 0; i < fsa.length; i++) {
-            FormatString fs = fsa[i];
+        // BEGIN Android-changed: Reuse compiled format strings.
+        // FormatString[] fsa = parse(format);
+        // for (int i = 0; i < fsa.length; i++) {
+        //     FormatString fs = fsa[i];
+        Object[] parts = compile(format).parts;
+        for (int i = 0; i < parts.length; i++) {
+            Object part = parts[i];
+            if (part instanceof String) {
+                try {
+                    a.append((String) part);
+                } catch (IOException x) {
+                    lastException = x;
+                }
+                continue;
+            }
+            FormatString fs = new FormatSpecifier((SpecifierTemplate) part);
+        // END Android-changed: Reuse compiled format strings.
             int index = fs.index();
             try {
                 switch (index) {
@@ -2537,6 +2555,155 @@ public final class Formatter implements Closeable, Flushable {
         return this;
     }
 
+    // BEGIN Android-added: Cache compiled format strings and locale symbols.
+    /**
+     * Number of slots in {@link #compiledFormats}. Must be a power of two.
+     */
+    private static final int COMPILED_FORMAT_CACHE_SIZE = 256;
+
+    /**
+     * Format strings longer than this are compiled on every use rather than
+     * cached, which bounds the memory retained by the cache.
+     */
+    private static final int MAX_CACHED_FORMAT_LENGTH = 512;
+
+    /**
+     * A direct-mapped cache of compiled format strings shared by all
+     * formatters. Entries are immutable and published through final fields,
+     * so slots are read and written without synchronization; a racing
+     * update at worst causes a format string to be compiled again.
+     */
+    private static final CompiledFormat[] compiledFormats =
+            new CompiledFormat[COMPILED_FORMAT_CACHE_SIZE];
+
+    /**
+     * A parsed format string. Each element of {@code parts} is either a
+     * {@code String} of fixed text or a {@link SpecifierTemplate}.
+     */
+    private static final class CompiledFormat {
+        final String format;
+        final Object[] parts;
+
+        CompiledFormat(String format, Object[] parts) {
+            this.format = format;
+            this.parts = parts;
+        }
+    }
+
+    /**
+     * The parsed and validated state of a {@link FormatSpecifier}, detached
+     * from the formatter that parsed it so that it may be shared.
+     */
+    private static final class SpecifierTemplate {
+        final int index;
+        // Never modified once parsing has completed.
+        final Flags f;
+        final int width;
+        final int precision;
+        final boolean dt;
+        final char c;
+
+        SpecifierTemplate(int index, Flags f, int width, int precision, boolean dt, char c) {
+            this.index = index;
+            this.f = f;
+            this.width = width;
+            this.precision = precision;
+            this.dt = dt;
+            this.c = c;
+        }
+    }
+
+    private CompiledFormat compile(String format) {
+        int hash = format.hashCode();
+        int slot = (hash ^ (hash >>> 16)) & (COMPILED_FORMAT_CACHE_SIZE - 1);
+        CompiledFormat compiled = compiledFormats[slot];
+        if (compiled != null && compiled.format.equals(format)) {
+            return compiled;
+        }
+
+        FormatString[] fsa = parse(format);
+        Object[] parts = new Object[fsa.length];
+        for (int i = 0; i < fsa.length; i++) {
+            if (fsa[i] instanceof FixedString) {
+                parts[i] = ((FixedString) fsa[i]).s;
+            } else {
+                FormatSpecifier fs = (FormatSpecifier) fsa[i];
+                parts[i] = new SpecifierTemplate(fs.index, fs.f, fs.width, fs.precision, fs.dt,
+                        fs.c);
+            }
+        }
+        compiled = new CompiledFormat(format, parts);
+        if (format.length() <= MAX_CACHED_FORMAT_LENGTH) {
+            compiledFormats[slot] = compiled;
+        }
+        return compiled;
+    }
+
+    /**
+     * Locale-dependent symbols used when localizing numbers.
+     */
+    private static final class LocaleSymbols {
+        static final LocaleSymbols ROOT = new LocaleSymbols('0', '.', ',', 3);
+
+        final char zero;
+        final char decimalSeparator;
+        // '\0' if the locale does not group digits.
+        final char groupingSeparator;
+        final int groupingSize;
+
+        LocaleSymbols(char zero, char decimalSeparator, char groupingSeparator,
+                      int groupingSize) {
+            this.zero = zero;
+            this.decimalSeparator = decimalSeparator;
+            this.groupingSeparator = groupingSeparator;
+            this.groupingSize = groupingSize;
+        }
+    }
+
+    /**
+     * Upper bound on the number of locales whose symbols are retained.
+     */
+    private static final int MAX_CACHED_LOCALES = 32;
+
+    private static final ConcurrentHashMap<Locale, LocaleSymbols> localeSymbols =
+            new ConcurrentHashMap<>();
+
+    /**
+     * Returns the symbols for {@code l}, which must not be {@code null}.
+     * Looking these up from {@link DecimalFormatSymbols} is expensive
+     * compared to formatting a single number, so they are cached per locale.
+     */
+    private static LocaleSymbols getLocaleSymbols(Locale l) {
+        if (l.equals(Locale.US)) {
+            return LocaleSymbols.ROOT;
+        }
+        LocaleSymbols symbols = localeSymbols.get(l);
+        if (symbols != null) {
+            return symbols;
+        }
+
+        DecimalFormatSymbols dfs = DecimalFormatSymbols.getInstance(l);
+        char grpSep = dfs.getGroupingSeparator();
+        DecimalFormat df = (DecimalFormat) NumberFormat.getIntegerInstance(l);
+        int grpSize = df.getGroupingSize();
+        // BEGIN Android-changed: Fix division by zero if group separator is not clear.
+        // http://b/33245708
+        // Some locales have a group separator but also patterns without groups.
+        // If we do not clear the group separator in these cases a divide by zero
+        // is thrown when determining where to place the separators.
+        if (!df.isGroupingUsed() || df.getGroupingSize() == 0) {
+            grpSep = '\0';
+        }
+        // END Android-changed: Fix division by zero if group separator is not clear.
+        symbols = new LocaleSymbols(dfs.getZeroDigit(), dfs.getDecimalSeparator(), grpSep,
+                grpSize);
+        if (localeSymbols.size() < MAX_CACHED_LOCALES) {
+            localeSymbols.putIfAbsent(l, symbols);
+        }
+        return symbols;
+    }
+    // END Android-added: Cache compiled format strings and locale symbols.
+
     // BEGIN Android-changed: changed parse() to manual parsing instead of regex.
     /**
      * Finds format specifiers in the format string.
@@ -2827,6 +2994,18 @@ public final class Formatter implements Closeable, Flushable {
                 throw new UnknownFormatConversionException(String.valueOf(c));
         }
 
+        // BEGIN Android-added: Cache compiled format strings.
+        // The template has already been validated.
+        FormatSpecifier(SpecifierTemplate template) {
+            index = template.index;
+            f = template.f;
+            width = template.width;
+            precision = template.precision;
+            dt = template.dt;
+            c = template.c;
+        }
+        // END Android-added: Cache compiled format strings.
+
         public void print(Object arg, Locale l) throws IOException {
             if (dt) {
                 printDateTime(arg, l);
@@ -3180,15 +3359,36 @@ public final class Formatter implements Closeable, Flushable {
 
         private void print(long value, Locale l) throws IOException {
 
+            // BEGIN Android-changed: Append decimal integers directly to the destination.
+            // StringBuilder sb = new StringBuilder();
+            if (c == Conversion.DECIMAL_INTEGER && width == -1) {
+                // Without a width there is nothing to justify, so the
+                // digits can go straight into a StringBuilder destination.
+                if (f.valueOf() == 0 && getZero(l) == '0') {
+                    if (a instanceof StringBuilder) {
+                        ((StringBuilder) a).append(value);
+                    } else {
+                        a.append(Long.toString(value));
+                    }
+                    return;
+                }
+                if (a instanceof StringBuilder) {
+                    StringBuilder sb = (StringBuilder) a;
+                    boolean neg = value < 0;
+                    leadingSign(sb, neg);
+                    localizedMagnitude(sb, magnitude(value), f, -1, l);
+                    trailingSign(sb, neg);
+                    return;
+                }
+            }
+
             StringBuilder sb = new StringBuilder();
+            // END Android-changed: Append decimal integers directly to the destination.
 
             if (c == Conversion.DECIMAL_INTEGER) {
                 boolean neg = value < 0;
-                char[] va;
-                if (value < 0)
-                    va = Long.toString(value, 10).substring(1).toCharArray();
-                else
-                    va = Long.toString(value, 10).toCharArray();
+                // Android-changed: Extracted magnitude().
+                char[] va = magnitude(value);
 
                 // leading sign indicator
                 leadingSign(sb, neg);
@@ -3234,6 +3434,14 @@ public final class Formatter implements Closeable, Flushable {
             a.append(justify(sb.toString()));
         }
 
+        // BEGIN Android-added: Extracted magnitude().
+        // Returns the decimal digits of |value|.
+        private char[] magnitude(long value) {
+            String s = Long.toString(value, 10);
+            return (value < 0) ? s.substring(1).toCharArray() : s.toCharArray();
+        }
+        // END Android-added: Extracted magnitude().
+
         // neg := val < 0
         private StringBuilder leadingSign(StringBuilder sb, boolean neg) {
             if (!neg) {
@@ -3319,7 +3527,14 @@ public final class Formatter implements Closeable, Flushable {
         }
 
         private void print(double value, Locale l) throws IOException {
-            StringBuilder sb = new StringBuilder();
+            // BEGIN Android-changed: Append fixed-point values directly to the destination.
+            // StringBuilder sb = new StringBuilder();
+            // Without a width there is nothing to justify. Only %f is
+            // handled this way because it cannot fail part way through.
+            boolean direct = c == Conversion.DECIMAL_FLOAT && width == -1
+                    && a instanceof StringBuilder;
+            StringBuilder sb = direct ? (StringBuilder) a : new StringBuilder();
+            // END Android-changed: Append fixed-point values directly to the destination.
             boolean neg = Double.compare(value, 0.0) == -1;
 
             if (!Double.isNaN(value)) {
@@ -3342,7 +3557,10 @@ public final class Formatter implements Closeable, Flushable {
             }
 
             // justify based on width
-            a.append(justify(sb.toString()));
+            // Android-changed: Append fixed-point values directly to the destination.
+            // a.append(justify(sb.toString()));
+            if (!direct)
+                a.append(justify(sb.toString()));
         }
 
         // !Double.isInfinite(value) && !Double.isNaN(value)
@@ -4405,8 +4623,10 @@ public final class Formatter implements Closeable, Flushable {
 
         private char getZero(Locale l) {
             if ((l != null) &&  !l.equals(locale())) {
-                DecimalFormatSymbols dfs = DecimalFormatSymbols.getInstance(l);
-                return dfs.getZeroDigit();
+                // Android-changed: Cache locale symbols.
+                // DecimalFormatSymbols dfs = DecimalFormatSymbols.getInstance(l);
+                // return dfs.getZeroDigit();
+                return getLocaleSymbols(l).zero;
             }
             return zero;
         }
@@ -4443,35 +4663,19 @@ public final class Formatter implements Closeable, Flushable {
                 }
             }
 
+            // BEGIN Android-changed: Cache locale symbols.
+            // The symbols below were looked up from DecimalFormatSymbols and
+            // NumberFormat on every call; see getLocaleSymbols().
+            LocaleSymbols symbols = (l == null) ? LocaleSymbols.ROOT : getLocaleSymbols(l);
             if (dot < len) {
-                if (l == null || l.equals(Locale.US)) {
-                    decSep  = '.';
-                } else {
-                    DecimalFormatSymbols dfs = DecimalFormatSymbols.getInstance(l);
-                    decSep  = dfs.getDecimalSeparator();
-                }
+                decSep = symbols.decimalSeparator;
             }
 
             if (f.contains(Flags.GROUP)) {
-                if (l == null || l.equals(Locale.US)) {
-                    grpSep = ',';
-                    grpSize = 3;
-                } else {
-                    DecimalFormatSymbols dfs = DecimalFormatSymbols.getInstance(l);
-                    grpSep = dfs.getGroupingSeparator();
-                    DecimalFormat df = (DecimalFormat) NumberFormat.getIntegerInstance(l);
-                    grpSize = df.getGroupingSize();
-                    // BEGIN Android-changed: Fix division by zero if group separator is not clear.
-                    // http://b/33245708
-                    // Some locales have a group separator but also patterns without groups.
-                    // If we do not clear the group separator in these cases a divide by zero
-                    // is thrown when determining where to place the separators.
-                    if (!df.isGroupingUsed() || df.getGroupingSize() == 0) {
-                        grpSep = '\0';
-                    }
-                    // END Android-changed: Fix division by zero if group separator is not clear.
-                }
+                grpSep = symbols.groupingSeparator;
+                grpSize = symbols.groupingSize;
             }
+            // END Android-changed: Cache locale symbols.
 
             // localize the digits inserting group separators as necessary
             for (int j = 0; j < len; j++) {
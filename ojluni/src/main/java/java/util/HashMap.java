@@ -496,18 +496,40 @@ public class HashMap<K,V> extends AbstractMap<K,V>
      * @param evict false when initially constructing this map, else
      * true (relayed to method afterNodeInsertion).
      */
+    @SuppressWarnings("unchecked")
     final void putMapEntries(Map<? extends K, ? extends V> m, boolean evict) {
         int s = m.size();
         if (s > 0) {
+            // BEGIN Android-changed: Size the table once, before inserting.
+            // The old estimate of s / loadFactor + 1 could double the
+            // table needlessly, and a single resize() was not enough
+            // when s exceeded twice the threshold, so the rest of the
+            // growth happened entry by entry, splitting and treeifying
+            // bins along the way.
             if (table == null) { // pre-size
-                float ft = ((float)s / loadFactor) + 1.0F;
-                int t = ((ft < (float)MAXIMUM_CAPACITY) ?
-                         (int)ft : MAXIMUM_CAPACITY);
+                int t = calculateHashMapCapacity(s, loadFactor);
                 if (t > threshold)
                     threshold = tableSizeFor(t);
+            } else {
+                while (s > threshold && table.length < MAXIMUM_CAPACITY)
+                    resize();
+            }
+            // END Android-changed: Size the table once, before inserting.
+            // BEGIN Android-added: Reuse the cached hashes of a HashMap.
+            // A plain HashMap iterates in table order, so walking its
+            // table inserts in the same order as its entrySet would,
+            // without creating an iterator or calling hashCode again.
+            if (m.getClass() == HashMap.class) {
+                Node<K,V>[] tab = ((HashMap<K,V>)m).table;
+                if (tab != null) {
+                    for (Node<K,V> e : tab) {
+                        for (; e != null; e = e.next)
+                            putVal(e.hash, e.key, e.value, false, evict);
+                    }
+                }
+                return;
             }
-            else if (s > threshold)
-                resize();
+            // END Android-added: Reuse the cached hashes of a HashMap.
             for (Map.Entry<? extends K, ? extends V> e : m.entrySet()) {
                 K key = e.getKey();
                 V value = e.getValue();
@@ -516,6 +538,17 @@ public class HashMap<K,V> extends AbstractMap<K,V>
         }
     }
 
+    // BEGIN Android-added: Size the table once, before inserting.
+    /**
+     * Returns the initial capacity for a HashMap that holds
+     * numMappings mappings without resizing.
+     */
+    static int calculateHashMapCapacity(int numMappings, float loadFactor) {
+        double capacity = Math.ceil(numMappings / (double) loadFactor);
+        return (capacity < MAXIMUM_CAPACITY) ? (int) capacity : MAXIMUM_CAPACITY;
+    }
+    // END Android-added: Size the table once, before inserting.
+
     /**
      * Returns the number of key-value mappings in this map.
      *
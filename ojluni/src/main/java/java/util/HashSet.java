@@ -115,7 +115,12 @@ public class HashSet<E>
      * @throws NullPointerException if the specified collection is null
      */
     public HashSet(Collection<? extends E> c) {
-        map = new HashMap<>(Math.max((int) (c.size()/.75f) + 1, 16));
+        // Android-changed: Use the exact capacity for c.size() elements.
+        // The old estimate, c.size() / .75f + 1, doubled the table for
+        // sizes at the threshold, and float rounding could undersize it
+        // for large collections.
+        map = new HashMap<>(Math.max(
+                HashMap.calculateHashMapCapacity(c.size(), .75f), 16));
         addAll(c);
     }
 
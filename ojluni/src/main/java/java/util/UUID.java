@@ -94,7 +94,75 @@ public final class UUID implements java.io.Serializable, Comparable<UUID> {
      */
     private static class Holder {
         static final SecureRandom numberGenerator = new SecureRandom();
+
+        // Android-added: Buffer random bytes per thread for randomUUID().
+        static final ThreadLocal<RandomBuffer> randomBuffers =
+                ThreadLocal.withInitial(RandomBuffer::new);
+    }
+
+    // BEGIN Android-added: Buffer random bytes per thread for randomUUID().
+    /**
+     * Random bytes drawn in blocks from {@link Holder#numberGenerator}, so
+     * that threads calling {@link #randomUUID()} contend on the shared
+     * generator once per block rather than once per UUID. Bytes are
+     * cleared as they are used.
+     */
+    private static final class RandomBuffer {
+        private static final int UUIDS_PER_BLOCK = 32;
+
+        /**
+         * Incremented in the child after the zygote forks, so that the
+         * child never hands out bytes buffered by its parent.
+         */
+        static volatile int forkGeneration;
+
+        private final byte[] bytes = new byte[16 * UUIDS_PER_BLOCK];
+        private int pos = bytes.length;
+        // The value of forkGeneration when the buffer was filled.
+        private int generation;
+
+        UUID nextUUID() {
+            int currentGeneration = forkGeneration;
+            if (pos == bytes.length || generation != currentGeneration) {
+                Holder.numberGenerator.nextBytes(bytes);
+                pos = 0;
+                generation = currentGeneration;
+            }
+            UUID uuid = fromRandomBytes(bytes, pos);
+            Arrays.fill(bytes, pos, pos + 16, (byte) 0);
+            pos += 16;
+            return uuid;
+        }
+    }
+
+    /**
+     * Discards the random bytes buffered for {@link #randomUUID()}. Called
+     * by the zygote in the child process after every fork.
+     *
+     * @hide for internal use only.
+     */
+    public static void discardBufferedRandomBytesInternal() {
+        RandomBuffer.forkGeneration++;
+    }
+
+    /**
+     * Returns a version 4 UUID built from the 16 random bytes at
+     * {@code data[off]}.
+     */
+    private static UUID fromRandomBytes(byte[] data, int off) {
+        long msb = 0;
+        long lsb = 0;
+        for (int i = off; i < off + 8; i++)
+            msb = (msb << 8) | (data[i] & 0xff);
+        for (int i = off + 8; i < off + 16; i++)
+            lsb = (lsb << 8) | (data[i] & 0xff);
+        msb &= ~0xf000L;                    /* clear version        */
+        msb |= 0x4000L;                     /* set to version 4     */
+        lsb &= 0x3fffffffffffffffL;         /* clear variant        */
+        lsb |= 0x8000000000000000L;         /* set to IETF variant  */
+        return new UUID(msb, lsb);
     }
+    // END Android-added: Buffer random bytes per thread for randomUUID().
 
     // Constructors and Factories
 
@@ -139,16 +207,50 @@ public final class UUID implements java.io.Serializable, Comparable<UUID> {
      * @return  A randomly generated {@code UUID}
      */
     public static UUID randomUUID() {
-        SecureRandom ng = Holder.numberGenerator;
-
-        byte[] randomBytes = new byte[16];
-        ng.nextBytes(randomBytes);
-        randomBytes[6]  &= 0x0f;  /* clear version        */
-        randomBytes[6]  |= 0x40;  /* set to version 4     */
-        randomBytes[8]  &= 0x3f;  /* clear variant        */
-        randomBytes[8]  |= 0x80;  /* set to IETF variant  */
-        return new UUID(randomBytes);
+        // BEGIN Android-changed: Buffer random bytes per thread for randomUUID().
+        // SecureRandom ng = Holder.numberGenerator;
+        //
+        // byte[] randomBytes = new byte[16];
+        // ng.nextBytes(randomBytes);
+        // randomBytes[6]  &= 0x0f;  /* clear version        */
+        // randomBytes[6]  |= 0x40;  /* set to version 4     */
+        // randomBytes[8]  &= 0x3f;  /* clear variant        */
+        // randomBytes[8]  |= 0x80;  /* set to IETF variant  */
+        // return new UUID(randomBytes);
+        return Holder.randomBuffers.get().nextUUID();
+        // END Android-changed: Buffer random bytes per thread for randomUUID().
+    }
+
+    // BEGIN Android-added: Bulk generation of random UUIDs.
+    /**
+     * Returns {@code count} type 4 (pseudo randomly generated) UUIDs, as if
+     * by calling {@link #randomUUID()} {@code count} times. The random bytes
+     * are drawn from the generator in large blocks.
+     *
+     * @param  count
+     *         The number of UUIDs to generate
+     *
+     * @return  An array of {@code count} randomly generated {@code UUID}s
+     *
+     * @throws  IllegalArgumentException
+     *          If {@code count} is negative
+     * @hide
+     */
+    public static UUID[] randomUUIDs(int count) {
+        if (count < 0)
+            throw new IllegalArgumentException("count < 0: " + count);
+        UUID[] result = new UUID[count];
+        byte[] randomBytes = new byte[16 * Math.min(count, 256)];
+        for (int i = 0; i < count; ) {
+            int n = Math.min(count - i, randomBytes.length / 16);
+            Holder.numberGenerator.nextBytes(randomBytes);
+            for (int j = 0; j < n; j++)
+                result[i++] = fromRandomBytes(randomBytes, 16 * j);
+        }
+        Arrays.fill(randomBytes, (byte) 0);
+        return result;
     }
+    // END Android-added: Bulk generation of random UUIDs.
 
     /**
      * Static factory to retrieve a type 3 (name based) {@code UUID} based on
@@ -431,6 +431,67 @@ public class LinkedBlockingQueue<E> extends AbstractQueue<E>
         return c >= 0;
     }
 
+    // BEGIN Android-added: Bulk insertion for ThreadPoolExecutor.executeAll.
+    /**
+     * Inserts the elements of the given collection at the tail of this
+     * queue, in iteration order, until the queue is full. Unlike repeated
+     * calls to {@link #offer(Object)}, this acquires the put lock once and
+     * signals waiting consumers at most once; consumers pass the signal on
+     * to each other as they take elements.
+     *
+     * @param elements the elements to insert
+     * @return the number of elements inserted, which are the first ones
+     *         returned by the collection's iterator
+     * @throws NullPointerException if the collection or any of its
+     *         elements is null
+     * @hide
+     */
+    public int offerAll(Collection<? extends E> elements) {
+        // Link the new nodes before taking the lock.
+        Node<E> first = null, tail = null;
+        int n = 0;
+        for (E e : elements) {
+            if (e == null) throw new NullPointerException();
+            Node<E> node = new Node<E>(e);
+            if (first == null)
+                first = node;
+            else
+                tail.next = node;
+            tail = node;
+            ++n;
+        }
+        final AtomicInteger count = this.count;
+        if (n == 0 || count.get() == capacity)
+            return 0;
+        int added = 0;
+        int c = -1;
+        final ReentrantLock putLock = this.putLock;
+        putLock.lock();
+        try {
+            int room = capacity - count.get();
+            if (room > 0) {
+                added = Math.min(n, room);
+                if (added < n) {
+                    tail = first;
+                    for (int i = 1; i < added; i++)
+                        tail = tail.next;
+                    tail.next = null;
+                }
+                last.next = first;
+                last = tail;
+                c = count.getAndAdd(added);
+                if (c + added < capacity)
+                    notFull.signal();
+            }
+        } finally {
+            putLock.unlock();
+        }
+        if (c == 0)
+            signalNotEmpty();
+        return added;
+    }
+    // END Android-added: Bulk insertion for ThreadPoolExecutor.executeAll.
+
     public E take() throws InterruptedException {
         E x;
         int c = -1;
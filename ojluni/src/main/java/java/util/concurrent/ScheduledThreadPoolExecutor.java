@@ -39,11 +39,15 @@ import static java.util.concurrent.TimeUnit.MILLISECONDS;
 import static java.util.concurrent.TimeUnit.NANOSECONDS;
 
 import java.util.AbstractQueue;
+// Android-added: Timing wheel work queue.
+import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collection;
 import java.util.Iterator;
 import java.util.List;
 import java.util.NoSuchElementException;
+// Android-added: Timing wheel work queue.
+import java.util.PriorityQueue;
 import java.util.concurrent.atomic.AtomicLong;
 import java.util.concurrent.locks.Condition;
 import java.util.concurrent.locks.ReentrantLock;
@@ -203,6 +207,12 @@ public class ScheduledThreadPoolExecutor
          */
         int heapIndex;
 
+        // Android-added: Timing wheel work queue.
+        /**
+         * Node in a TimingWheelWorkQueue, to support O(1) cancellation.
+         */
+        volatile TimingWheelWorkQueue.Node timerNode;
+
         /**
          * Creates a one-shot action with given nanoTime-based trigger time.
          */
@@ -514,6 +524,39 @@ public class ScheduledThreadPoolExecutor
               new DelayedWorkQueue(), threadFactory, handler);
     }
 
+    // BEGIN Android-added: Timing wheel work queue.
+    /**
+     * Creates a new {@code ScheduledThreadPoolExecutor} that keeps
+     * pending tasks in timing wheels with the given tick rather than in
+     * a heap. Scheduling and cancelling a task then take constant time,
+     * which suits executors holding many tasks that are mostly cancelled
+     * before they run, such as timeouts. A task may run up to one tick
+     * after its delay has elapsed.
+     *
+     * @param corePoolSize the number of threads to keep in the pool, even
+     *        if they are idle, unless {@code allowCoreThreadTimeOut} is set
+     * @param threadFactory the factory to use when the executor
+     *        creates a new thread
+     * @param handler the handler to use when execution is blocked
+     *        because the thread bounds and queue capacities are reached
+     * @param tick the resolution of the timing wheels
+     * @param unit the time unit of the {@code tick} argument
+     * @throws IllegalArgumentException if {@code corePoolSize < 0} or
+     *         {@code tick} is not positive
+     * @throws NullPointerException if {@code threadFactory},
+     *         {@code handler} or {@code unit} is null
+     * @hide
+     */
+    public ScheduledThreadPoolExecutor(int corePoolSize,
+                                       ThreadFactory threadFactory,
+                                       RejectedExecutionHandler handler,
+                                       long tick, TimeUnit unit) {
+        super(corePoolSize, Integer.MAX_VALUE,
+              DEFAULT_KEEPALIVE_MILLIS, MILLISECONDS,
+              new TimingWheelWorkQueue(unit.toNanos(tick)), threadFactory, handler);
+    }
+    // END Android-added: Timing wheel work queue.
+
     /**
      * Returns the nanoTime-based trigger time of a delayed action.
      */
@@ -654,6 +697,21 @@ public class ScheduledThreadPoolExecutor
         schedule(command, 0, NANOSECONDS);
     }
 
+    // Android-added: Batch submission.
+    /**
+     * Executes each of the given tasks with zero required delay, as
+     * {@link #execute} does. Each task is queued separately.
+     *
+     * @throws RejectedExecutionException {@inheritDoc}
+     * @throws NullPointerException {@inheritDoc}
+     * @hide
+     */
+    @Override
+    public void executeAll(Collection<? extends Runnable> commands) {
+        for (Runnable command : commands)
+            execute(command);
+    }
+
     // Override AbstractExecutorService methods
 
     /**
@@ -1319,4 +1377,794 @@ public class ScheduledThreadPoolExecutor
             }
         }
     }
+
+    // BEGIN Android-added: Timing wheel work queue.
+    /**
+     * Alternative to DelayedWorkQueue for executors holding many pending
+     * tasks, most of which are cancelled before they run, such as
+     * timeouts. Only tasks that are due are kept in a heap; the others
+     * are kept in hashed hierarchical timing wheels (Varghese and Lauck)
+     * with a fixed tick, so that adding and removing a task are O(1)
+     * rather than O(log n). The wheels are sharded by the thread adding
+     * the task, so that threads scheduling tasks concurrently do not
+     * contend on one lock.
+     *
+     * In exchange, a task may be taken up to one tick after its delay
+     * has elapsed, tasks due in the same tick are not necessarily
+     * taken in time order, and peek, contains for tasks that are not
+     * ScheduledFutureTasks, and iteration are O(n).
+     */
+    static class TimingWheelWorkQueue extends AbstractQueue<Runnable>
+        implements BlockingQueue<Runnable> {
+
+        /*
+         * Each shard has LEVELS wheels of WHEEL_SIZE slots. A slot of
+         * the wheel at level k spans WHEEL_SIZE^k ticks; a task is put
+         * in the lowest level whose wheel reaches its deadline, and in
+         * the slot given by the corresponding digit of its deadline.
+         * When the current tick reaches the start of a slot at level
+         * k > 0, its tasks are cascaded into lower levels; when it
+         * reaches a slot at level 0, its tasks are due and are moved to
+         * the ready heap. Deadlines beyond the reach of the top wheel
+         * are put in its furthest slot and cascaded again.
+         *
+         * Ticks are counted from the creation of the queue, and a task's
+         * deadline is rounded up to a whole tick, so no task is taken
+         * before its delay has elapsed. Shards are only advanced by
+         * threads taking tasks, which hold the main lock and then each
+         * shard's lock in turn, so time passing costs nothing while no
+         * thread is waiting for a task. Each shard keeps a bitmap of its
+         * occupied slots per level, so advancing skips over empty slots.
+         *
+         * Threads taking tasks use the same leader-follower scheme as
+         * DelayedWorkQueue. Threads adding tasks to a shard only take the
+         * main lock if the task's next event (expiry or cascade) is
+         * before the tick that the leader waits for, as published in
+         * wakeupTick.
+         */
+
+        private static final int WHEEL_BITS = 6;
+        private static final int WHEEL_SIZE = 1 << WHEEL_BITS;
+        private static final int WHEEL_MASK = WHEEL_SIZE - 1;
+        private static final int LEVELS = 6;
+
+        /** The furthest deadline, in ticks from now, that the wheels reach. */
+        private static final long MAX_DELTA = (1L << (WHEEL_BITS * LEVELS)) - 1;
+
+        /** Values of wakeupTick when no thread waits, or no thread waits as leader. */
+        private static final long NO_WAITERS = Long.MIN_VALUE;
+        private static final long NO_LEADER = Long.MAX_VALUE;
+
+        /** A task in a shard. */
+        static final class Node {
+            final RunnableScheduledFuture<?> task;
+            final Shard shard;
+            /** Tick at which the task is due. */
+            final long deadline;
+            Node prev, next;
+            /** Index into Shard.slots, or -1 if not in a wheel. */
+            int slot = -1;
+
+            Node(RunnableScheduledFuture<?> task, Shard shard, long deadline) {
+                this.task = task;
+                this.shard = shard;
+                this.deadline = deadline;
+            }
+        }
+
+        /**
+         * One set of timing wheels. Except for nextEvent and count, fields
+         * are guarded by lock.
+         */
+        static final class Shard {
+            final TimingWheelWorkQueue queue;
+            final ReentrantLock lock = new ReentrantLock();
+            /** Heads of the lists of nodes in each slot, LEVELS * WHEEL_SIZE. */
+            final Node[] slots = new Node[LEVELS * WHEEL_SIZE];
+            /** Bitmap of the non-empty slots at each level. */
+            final long[] occupied = new long[LEVELS];
+            /** The first tick not yet processed. */
+            long now;
+            /** A lower bound on the next tick at which nodes expire or cascade. */
+            volatile long nextEvent = Long.MAX_VALUE;
+            /** The number of nodes in the wheels. Written holding lock. */
+            volatile int count;
+
+            Shard(TimingWheelWorkQueue queue) {
+                this.queue = queue;
+            }
+
+            /**
+             * Adds node to the wheels. Returns the tick of its next event,
+             * or -1 if it is already due. Call only when holding lock.
+             */
+            long add(Node node) {
+                long delta = node.deadline - now;
+                if (delta < 0)
+                    return -1L;
+                long position = node.deadline;
+                int level;
+                if (delta < WHEEL_SIZE)
+                    level = 0;
+                else {
+                    if (delta > MAX_DELTA)
+                        delta = MAX_DELTA;
+                    position = now + delta;
+                    level = (63 - Long.numberOfLeadingZeros(delta)) / WHEEL_BITS;
+                }
+                int shift = level * WHEEL_BITS;
+                int index = (int) (position >>> shift) & WHEEL_MASK;
+                int s = (level << WHEEL_BITS) + index;
+                Node head = slots[s];
+                node.next = head;
+                if (head != null)
+                    head.prev = node;
+                slots[s] = node;
+                node.slot = s;
+                occupied[level] |= 1L << index;
+                long event = position & ~((1L << shift) - 1);
+                if (event < nextEvent)
+                    nextEvent = event;
+                return event;
+            }
+
+            /** Removes node from the wheels. Call only when holding lock. */
+            void unlink(Node node) {
+                int s = node.slot;
+                Node prev = node.prev, next = node.next;
+                if (prev != null)
+                    prev.next = next;
+                else if ((slots[s] = next) == null)
+                    occupied[s >>> WHEEL_BITS] &= ~(1L << (s & WHEEL_MASK));
+                if (next != null)
+                    next.prev = prev;
+                node.prev = node.next = null;
+                node.slot = -1;
+            }
+
+            /** Removes and returns the list of nodes in slot s. */
+            private Node detach(int s) {
+                Node head = slots[s];
+                slots[s] = null;
+                occupied[s >>> WHEEL_BITS] &= ~(1L << (s & WHEEL_MASK));
+                return head;
+            }
+
+            /**
+             * Moves all nodes due at or before tick target to ready.
+             * Call only when holding lock and the main lock.
+             */
+            void advance(long target, PriorityQueue<RunnableScheduledFuture<?>> ready) {
+                while (now <= target) {
+                    long event = computeNextEvent();
+                    if (event > target) {
+                        now = target + 1;
+                        break;
+                    }
+                    now = event;
+                    // Cascade higher levels first, as their nodes may
+                    // land in the slots of lower levels starting now.
+                    for (int level = LEVELS - 1; level > 0; level--) {
+                        int shift = level * WHEEL_BITS;
+                        if ((now & ((1L << shift) - 1)) != 0)
+                            continue;
+                        int index = (int) (now >>> shift) & WHEEL_MASK;
+                        if ((occupied[level] & (1L << index)) == 0)
+                            continue;
+                        for (Node n = detach((level << WHEEL_BITS) + index), next;
+                             n != null; n = next) {
+                            next = n.next;
+                            n.prev = n.next = null;
+                            n.slot = -1;
+                            if (add(n) < 0)
+                                expire(n, ready);
+                        }
+                    }
+                    for (Node n = detach((int) now & WHEEL_MASK), next; n != null; n = next) {
+                        next = n.next;
+                        n.prev = n.next = null;
+                        n.slot = -1;
+                        expire(n, ready);
+                    }
+                    now++;
+                }
+                nextEvent = computeNextEvent();
+            }
+
+            private void expire(Node node, PriorityQueue<RunnableScheduledFuture<?>> ready) {
+                count--;
+                setNode(node.task, null);
+                ready.add(node.task);
+            }
+
+            /**
+             * Returns the first tick, at or after now, at which nodes
+             * expire or cascade, or Long.MAX_VALUE if there are no nodes.
+             */
+            private long computeNextEvent() {
+                long result = Long.MAX_VALUE;
+                for (int level = 0; level < LEVELS; level++) {
+                    long bits = occupied[level];
+                    if (bits == 0)
+                        continue;
+                    int shift = level * WHEEL_BITS;
+                    int digit = (int) (now >>> shift) & WHEEL_MASK;
+                    // The slot at the current digit is still pending only if
+                    // now is at its start; otherwise it was already processed
+                    // and its nodes are one revolution ahead.
+                    int from = ((now & ((1L << shift) - 1)) == 0) ? digit : digit + 1;
+                    long ahead = (from < WHEEL_SIZE) ? bits & (-1L << from) : 0L;
+                    long revolution = now & ~((1L << (shift + WHEEL_BITS)) - 1);
+                    long event;
+                    if (ahead != 0)
+                        event = revolution
+                            + ((long) Long.numberOfTrailingZeros(ahead) << shift);
+                    else
+                        event = revolution + (1L << (shift + WHEEL_BITS))
+                            + ((long) Long.numberOfTrailingZeros(bits) << shift);
+                    if (event < result)
+                        result = event;
+                }
+                return result;
+            }
+
+            /** Adds all tasks to c. Call only when holding lock. */
+            void collect(Collection<? super RunnableScheduledFuture<?>> c) {
+                for (Node head : slots)
+                    for (Node n = head; n != null; n = n.next)
+                        c.add(n.task);
+            }
+
+            /** Returns the node of a task equal to x, or null. Call only when holding lock. */
+            Node find(Object x) {
+                for (Node head : slots)
+                    for (Node n = head; n != null; n = n.next)
+                        if (x.equals(n.task))
+                            return n;
+                return null;
+            }
+
+            /** Removes all nodes. Call only when holding lock. */
+            void clear() {
+                for (int s = 0; s < slots.length; s++) {
+                    for (Node n = slots[s], next; n != null; n = next) {
+                        next = n.next;
+                        n.prev = n.next = null;
+                        n.slot = -1;
+                        setNode(n.task, null);
+                        setIndex(n.task, -1);
+                    }
+                    slots[s] = null;
+                }
+                Arrays.fill(occupied, 0L);
+                nextEvent = Long.MAX_VALUE;
+                count = 0;
+            }
+        }
+
+        private final long tickNanos;
+        private final long origin = System.nanoTime();
+        private final Shard[] shards;
+
+        /** Guards ready, leader, leaderTick and waiters. */
+        private final ReentrantLock lock = new ReentrantLock();
+
+        /** Tasks that are due, taken from the shards. */
+        private final PriorityQueue<RunnableScheduledFuture<?>> ready =
+            new PriorityQueue<>();
+
+        /** Thread designated to wait for the next event, as in DelayedWorkQueue. */
+        private Thread leader;
+
+        /** The tick that the leader waits for. */
+        private long leaderTick;
+
+        /** The number of threads waiting on available. */
+        private int waiters;
+
+        /**
+         * Threads adding a task whose next event is before this tick
+         * must signal available. NO_WAITERS if no thread is waiting, and
+         * NO_LEADER if threads are waiting without a leader or a thread is
+         * deciding whether to wait.
+         */
+        private volatile long wakeupTick = NO_WAITERS;
+
+        /**
+         * Condition signalled when a task may be due earlier than the
+         * leader waits for or a new thread may need to become leader.
+         */
+        private final Condition available = lock.newCondition();
+
+        TimingWheelWorkQueue(long tickNanos) {
+            if (tickNanos <= 0)
+                throw new IllegalArgumentException();
+            this.tickNanos = tickNanos;
+            int n = Integer.highestOneBit(
+                Math.min(Runtime.getRuntime().availableProcessors(), 64) * 2 - 1);
+            shards = new Shard[n];
+            for (int i = 0; i < n; i++)
+                shards[i] = new Shard(this);
+        }
+
+        /**
+         * Sets f's heapIndex if it is a ScheduledFutureTask. As the
+         * queue does not keep tasks in an array, the index is only 0
+         * while the task is queued and -1 otherwise.
+         */
+        static void setIndex(RunnableScheduledFuture<?> f, int idx) {
+            if (f instanceof ScheduledFutureTask)
+                ((ScheduledFutureTask)f).heapIndex = idx;
+        }
+
+        /** Sets f's timerNode if it is a ScheduledFutureTask. */
+        static void setNode(RunnableScheduledFuture<?> f, Node node) {
+            if (f instanceof ScheduledFutureTask)
+                ((ScheduledFutureTask)f).timerNode = node;
+        }
+
+        private long currentTick() {
+            return (System.nanoTime() - origin) / tickNanos;
+        }
+
+        /**
+         * Returns the tick at which e is due, or -1 if it is due now.
+         */
+        private long deadlineTick(RunnableScheduledFuture<?> e) {
+            long delay = e.getDelay(NANOSECONDS);
+            if (delay <= 0L)
+                return -1L;
+            long elapsed = System.nanoTime() - origin;
+            if (delay > Long.MAX_VALUE - elapsed - tickNanos)
+                return Long.MAX_VALUE / 2; // never, in practice
+            long t = elapsed + delay;
+            return (t + tickNanos - 1) / tickNanos;
+        }
+
+        /** Returns the nanoseconds until tick, which is before Long.MAX_VALUE. */
+        private long nanosUntil(long tick) {
+            long elapsed = System.nanoTime() - origin;
+            if (tick >= (Long.MAX_VALUE >> 1) / tickNanos)
+                return Long.MAX_VALUE >> 1;
+            return tick * tickNanos - elapsed;
+        }
+
+        /** Returns the first tick at which a shard has an event. */
+        private long nextEventTick() {
+            long next = Long.MAX_VALUE;
+            for (Shard shard : shards) {
+                long event = shard.nextEvent;
+                if (event < next)
+                    next = event;
+            }
+            return next;
+        }
+
+        /** Publishes the tick that waiting threads will wake at. Call only when holding lock. */
+        private void updateWakeupTick() {
+            wakeupTick = (waiters == 0) ? NO_WAITERS
+                : (leader == null) ? NO_LEADER : leaderTick;
+        }
+
+        /** Moves tasks that are due to ready. Call only when holding lock. */
+        private void advance() {
+            long target = currentTick();
+            for (Shard shard : shards) {
+                if (shard.nextEvent <= target) {
+                    shard.lock.lock();
+                    try {
+                        shard.advance(target, ready);
+                    } finally {
+                        shard.lock.unlock();
+                    }
+                }
+            }
+        }
+
+        private boolean hasTasks() {
+            if (!ready.isEmpty())
+                return true;
+            for (Shard shard : shards)
+                if (shard.count != 0)
+                    return true;
+            return false;
+        }
+
+        private Node nodeOf(Object x) {
+            if (x instanceof ScheduledFutureTask) {
+                Node node = ((ScheduledFutureTask) x).timerNode;
+                // Sanity check; x could conceivably be a
+                // ScheduledFutureTask from some other pool.
+                if (node != null && node.shard.queue == this)
+                    return node;
+            }
+            return null;
+        }
+
+        public boolean contains(Object x) {
+            if (x == null)
+                return false;
+            Node node = nodeOf(x);
+            if (node != null) {
+                node.shard.lock.lock();
+                try {
+                    if (node.slot >= 0)
+                        return true;
+                } finally {
+                    node.shard.lock.unlock();
+                }
+            } else if (!(x instanceof ScheduledFutureTask)) {
+                for (Shard shard : shards) {
+                    shard.lock.lock();
+                    try {
+                        if (shard.find(x) != null)
+                            return true;
+                    } finally {
+                        shard.lock.unlock();
+                    }
+                }
+            }
+            final ReentrantLock lock = this.lock;
+            lock.lock();
+            try {
+                return ready.contains(x);
+            } finally {
+                lock.unlock();
+            }
+        }
+
+        public boolean remove(Object x) {
+            if (x == null)
+                return false;
+            Node node = nodeOf(x);
+            if (node != null) {
+                Shard shard = node.shard;
+                shard.lock.lock();
+                try {
+                    if (node.slot >= 0) {
+                        shard.unlink(node);
+                        shard.count--;
+                        setNode(node.task, null);
+                        setIndex(node.task, -1);
+                        return true;
+                    }
+                } finally {
+                    shard.lock.unlock();
+                }
+            } else if (!(x instanceof ScheduledFutureTask)) {
+                for (Shard shard : shards) {
+                    shard.lock.lock();
+                    try {
+                        Node n = shard.find(x);
+                        if (n != null) {
+                            shard.unlink(n);
+                            shard.count--;
+                            return true;
+                        }
+                    } finally {
+                        shard.lock.unlock();
+                    }
+                }
+            }
+            // The task may have been moved to ready since it was looked up;
+            // that is done holding lock, so it is now either there or taken.
+            final ReentrantLock lock = this.lock;
+            lock.lock();
+            try {
+                for (Iterator<RunnableScheduledFuture<?>> it = ready.iterator();
+                     it.hasNext(); ) {
+                    RunnableScheduledFuture<?> t = it.next();
+                    if (t == x || x.equals(t)) {
+                        it.remove();
+                        setIndex(t, -1);
+                        return true;
+                    }
+                }
+                return false;
+            } finally {
+                lock.unlock();
+            }
+        }
+
+        public int size() {
+            final ReentrantLock lock = this.lock;
+            lock.lock();
+            try {
+                long n = ready.size();
+                for (Shard shard : shards)
+                    n += shard.count;
+                return (int) Math.min(n, Integer.MAX_VALUE);
+            } finally {
+                lock.unlock();
+            }
+        }
+
+        public boolean isEmpty() {
+            return size() == 0;
+        }
+
+        public int remainingCapacity() {
+            return Integer.MAX_VALUE;
+        }
+
+        public RunnableScheduledFuture<?> peek() {
+            final ReentrantLock lock = this.lock;
+            lock.lock();
+            try {
+                advance();
+                RunnableScheduledFuture<?> first = ready.peek();
+                if (first != null)
+                    return first;
+                for (Shard shard : shards) {
+                    shard.lock.lock();
+                    try {
+                        for (Node head : shard.slots)
+                            for (Node n = head; n != null; n = n.next)
+                                if (first == null || n.task.compareTo(first) < 0)
+                                    first = n.task;
+                    } finally {
+                        shard.lock.unlock();
+                    }
+                }
+                return first;
+            } finally {
+                lock.unlock();
+            }
+        }
+
+        public boolean offer(Runnable x) {
+            if (x == null)
+                throw new NullPointerException();
+            RunnableScheduledFuture<?> e = (RunnableScheduledFuture<?>)x;
+            long deadline = deadlineTick(e);
+            if (deadline >= 0) {
+                Shard shard = shards[(int) Thread.currentThread().getId()
+                                     & (shards.length - 1)];
+                Node node = new Node(e, shard, deadline);
+                long event;
+                shard.lock.lock();
+                try {
+                    event = shard.add(node);
+                    if (event >= 0) {
+                        shard.count++;
+                        setIndex(e, 0);
+                        setNode(e, node);
+                    }
+                } finally {
+                    shard.lock.unlock();
+                }
+                if (event >= 0) {
+                    // Pairs with the write of wakeupTick before a thread
+                    // reads the shards' nextEvent in poll or take.
+                    if (event < wakeupTick) {
+                        final ReentrantLock lock = this.lock;
+                        lock.lock();
+                        try {
+                            leader = null;
+                            available.signal();
+                        } finally {
+                            lock.unlock();
+                        }
+                    }
+                    return true;
+                }
+            }
+            final ReentrantLock lock = this.lock;
+            lock.lock();
+            try {
+                ready.add(e);
+                setIndex(e, 0);
+                if (ready.peek() == e) {
+                    leader = null;
+                    available.signal();
+                }
+            } finally {
+                lock.unlock();
+            }
+            return true;
+        }
+
+        public void put(Runnable e) {
+            offer(e);
+        }
+
+        public boolean add(Runnable e) {
+            return offer(e);
+        }
+
+        public boolean offer(Runnable e, long timeout, TimeUnit unit) {
+            return offer(e);
+        }
+
+        /**
+         * Returns the first task that is due, or null. Call only when
+         * holding lock.
+         */
+        private RunnableScheduledFuture<?> pollReady() {
+            advance();
+            RunnableScheduledFuture<?> first = ready.poll();
+            if (first != null)
+                setIndex(first, -1);
+            return first;
+        }
+
+        public RunnableScheduledFuture<?> poll() {
+            final ReentrantLock lock = this.lock;
+            lock.lock();
+            try {
+                return pollReady();
+            } finally {
+                lock.unlock();
+            }
+        }
+
+        public RunnableScheduledFuture<?> take() throws InterruptedException {
+            return awaitTask(false, 0L);
+        }
+
+        public RunnableScheduledFuture<?> poll(long timeout, TimeUnit unit)
+            throws InterruptedException {
+            return awaitTask(true, unit.toNanos(timeout));
+        }
+
+        private RunnableScheduledFuture<?> awaitTask(boolean timed, long nanos)
+            throws InterruptedException {
+            final ReentrantLock lock = this.lock;
+            lock.lockInterruptibly();
+            try {
+                for (;;) {
+                    // Make threads adding tasks signal until we have
+                    // decided how long to wait.
+                    wakeupTick = NO_LEADER;
+                    RunnableScheduledFuture<?> first = pollReady();
+                    if (first != null)
+                        return first;
+                    if (timed && nanos <= 0L)
+                        return null;
+                    long next = nextEventTick();
+                    long delay = (next == Long.MAX_VALUE) ? Long.MAX_VALUE
+                        : nanosUntil(next);
+                    if (delay <= 0L)
+                        continue; // a task was added while advancing
+                    waiters++;
+                    try {
+                        if (leader != null || (timed && nanos < delay)) {
+                            updateWakeupTick();
+                            if (timed)
+                                nanos = available.awaitNanos(nanos);
+                            else
+                                available.await();
+                        } else {
+                            Thread thisThread = Thread.currentThread();
+                            leader = thisThread;
+                            leaderTick = next;
+                            updateWakeupTick();
+                            try {
+                                if (delay == Long.MAX_VALUE) {
+                                    if (timed)
+                                        nanos = available.awaitNanos(nanos);
+                                    else
+                                        available.await();
+                                } else {
+                                    long timeLeft = available.awaitNanos(delay);
+                                    if (timed)
+                                        nanos -= delay - timeLeft;
+                                }
+                            } finally {
+                                if (leader == thisThread)
+                                    leader = null;
+                            }
+                        }
+                    } finally {
+                        waiters--;
+                    }
+                }
+            } finally {
+                if (leader == null && hasTasks())
+                    available.signal();
+                updateWakeupTick();
+                lock.unlock();
+            }
+        }
+
+        public void clear() {
+            final ReentrantLock lock = this.lock;
+            lock.lock();
+            try {
+                for (Shard shard : shards) {
+                    shard.lock.lock();
+                    try {
+                        shard.clear();
+                    } finally {
+                        shard.lock.unlock();
+                    }
+                }
+                for (RunnableScheduledFuture<?> t : ready)
+                    setIndex(t, -1);
+                ready.clear();
+            } finally {
+                lock.unlock();
+            }
+        }
+
+        public int drainTo(Collection<? super Runnable> c) {
+            return drainTo(c, Integer.MAX_VALUE);
+        }
+
+        public int drainTo(Collection<? super Runnable> c, int maxElements) {
+            if (c == null)
+                throw new NullPointerException();
+            if (c == this)
+                throw new IllegalArgumentException();
+            if (maxElements <= 0)
+                return 0;
+            final ReentrantLock lock = this.lock;
+            lock.lock();
+            try {
+                advance();
+                RunnableScheduledFuture<?> first;
+                int n = 0;
+                while (n < maxElements && (first = ready.peek()) != null) {
+                    c.add(first);   // In this order, in case add() throws.
+                    ready.poll();
+                    setIndex(first, -1);
+                    ++n;
+                }
+                return n;
+            } finally {
+                lock.unlock();
+            }
+        }
+
+        /** Returns all queued tasks, due ones first. */
+        private ArrayList<RunnableScheduledFuture<?>> snapshot() {
+            final ReentrantLock lock = this.lock;
+            lock.lock();
+            try {
+                ArrayList<RunnableScheduledFuture<?>> tasks = new ArrayList<>(ready);
+                for (Shard shard : shards) {
+                    shard.lock.lock();
+                    try {
+                        shard.collect(tasks);
+                    } finally {
+                        shard.lock.unlock();
+                    }
+                }
+                return tasks;
+            } finally {
+                lock.unlock();
+            }
+        }
+
+        public Object[] toArray() {
+            return snapshot().toArray();
+        }
+
+        public <T> T[] toArray(T[] a) {
+            return snapshot().toArray(a);
+        }
+
+        public Iterator<Runnable> iterator() {
+            final Iterator<RunnableScheduledFuture<?>> it = snapshot().iterator();
+            return new Iterator<Runnable>() {
+                RunnableScheduledFuture<?> lastRet;
+
+                public boolean hasNext() {
+                    return it.hasNext();
+                }
+
+                public Runnable next() {
+                    return lastRet = it.next();
+                }
+
+                public void remove() {
+                    if (lastRet == null)
+                        throw new IllegalStateException();
+                    TimingWheelWorkQueue.this.remove(lastRet);
+                    lastRet = null;
+                }
+            };
+        }
+    }
+    // END Android-added: Timing wheel work queue.
 }
@@ -37,6 +37,8 @@ package java.util.concurrent;
 
 import dalvik.annotation.optimization.ReachabilitySensitive;
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
 import java.util.ConcurrentModificationException;
 import java.util.HashSet;
 import java.util.Iterator;
@@ -551,6 +553,46 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
      */
     private volatile boolean allowCoreThreadTimeOut;
 
+    // BEGIN Android-added: Per-worker local queues.
+    /**
+     * If true, tasks that workers submit to this pool while it is
+     * running are pushed onto the submitting worker's local queue
+     * rather than onto workQueue, and idle workers steal from the
+     * local queues of others. See allowLocalQueues.
+     */
+    private volatile boolean localQueues;
+
+    /**
+     * The number of workers that have found no local task to run or
+     * steal and are about to wait on, or are waiting on, workQueue.
+     * A worker increments this before its last scan of local queues,
+     * and execute rechecks it after pushing a task locally, so that a
+     * locally queued task is never left behind while a worker waits.
+     */
+    private final AtomicInteger idleWorkers = new AtomicInteger();
+
+    /**
+     * A snapshot of the workers set, replaced under mainLock whenever
+     * the set changes, so that idle workers can look for tasks to
+     * steal without taking mainLock.
+     */
+    private volatile Worker[] workerArray = new Worker[0];
+
+    /**
+     * The worker running on the current thread, if any. Only set for
+     * workers of pools that allow local queues.
+     */
+    private static final ThreadLocal<Worker> currentWorker =
+        ThreadLocal.withInitialIndexed(() -> null);
+
+    /**
+     * The number of local tasks a worker may run in a row before it
+     * polls workQueue, so that a steady stream of locally submitted
+     * tasks cannot starve tasks submitted from outside the pool.
+     */
+    private static final int LOCAL_TASKS_PER_SHARED_POLL = 32;
+    // END Android-added: Per-worker local queues.
+
     /**
      * Core pool size is the minimum number of workers to keep alive
      * (and not allow to time out etc) unless allowCoreThreadTimeOut
@@ -625,6 +667,18 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
         Runnable firstTask;
         /** Per-thread task counter */
         volatile long completedTasks;
+        // Android-added: Per-worker local queues.
+        /**
+         * Tasks submitted by tasks running in this worker. Created by
+         * this worker on first use. The worker takes from the tail and
+         * others steal from the head.
+         */
+        volatile ConcurrentLinkedDeque<Runnable> localQueue;
+        /**
+         * Local tasks taken in a row since workQueue was last polled.
+         * Only accessed by this worker's thread.
+         */
+        int localTaskStreak;
 
         /**
          * Creates with given first task and thread from ThreadFactory.
@@ -641,6 +695,12 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
             runWorker(this);
         }
 
+        // Android-added: Per-worker local queues.
+        /** Returns whether this worker belongs to the given pool. */
+        boolean isWorkerOf(ThreadPoolExecutor pool) {
+            return pool == ThreadPoolExecutor.this;
+        }
+
         // Lock methods
         //
         // The value 0 represents the unlocked state.
@@ -883,9 +943,78 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
                     taskList.add(r);
             }
         }
+        // Android-added: Per-worker local queues.
+        for (Worker w : workerArray) {
+            ConcurrentLinkedDeque<Runnable> lq = w.localQueue;
+            if (lq != null) {
+                for (Runnable r; (r = lq.pollFirst()) != null; )
+                    taskList.add(r);
+            }
+        }
         return taskList;
     }
 
+    // BEGIN Android-added: Per-worker local queues.
+    /**
+     * Replaces workerArray with a copy of the workers set. Call only
+     * while holding mainLock.
+     */
+    private void updateWorkerArray() {
+        workerArray = workers.toArray(new Worker[workers.size()]);
+    }
+
+    /**
+     * Pushes a task submitted by a worker of this pool onto that
+     * worker's local queue, if local queues are enabled and no worker
+     * is idle. (Idle workers wait on workQueue, so a task for them
+     * must go there.)
+     *
+     * @return true if the task was queued locally
+     */
+    private boolean offerLocal(Runnable command) {
+        if (idleWorkers.get() != 0)
+            return false;
+        Worker w = currentWorker.get();
+        if (w == null || !w.isWorkerOf(this))
+            return false;
+        ConcurrentLinkedDeque<Runnable> lq = w.localQueue;
+        if (lq == null)
+            w.localQueue = lq = new ConcurrentLinkedDeque<>();
+        lq.offerLast(command);
+        // A worker may have gone idle since the check above without
+        // seeing the task. If so, and it has not been stolen, move it
+        // to workQueue where the idle worker will find it.
+        int c = ctl.get();
+        if ((idleWorkers.get() != 0 || !isRunning(c))
+            && lq.removeLastOccurrence(command)) {
+            if (!isRunning(c))
+                reject(command);
+            else if (!workQueue.offer(command) && !addWorker(command, false))
+                reject(command);
+        }
+        return true;
+    }
+
+    /**
+     * Returns a task stolen from the local queue of a worker other
+     * than w, or null if there are none.
+     */
+    private Runnable stealLocal(Worker w) {
+        ConcurrentLinkedDeque<Runnable> lq;
+        Runnable r;
+        Worker[] ws = workerArray;
+        int n = ws.length;
+        // Start at a different victim for each thief.
+        int start = (n == 0) ? 0 : (System.identityHashCode(w) & 0x7fffffff) % n;
+        for (int i = 0; i < n; i++) {
+            Worker v = ws[(start + i) % n];
+            if (v != w && (lq = v.localQueue) != null && (r = lq.pollFirst()) != null)
+                return r;
+        }
+        return null;
+    }
+    // END Android-added: Per-worker local queues.
+
     /*
      * Methods for creating, running and cleaning up after workers
      */
@@ -963,6 +1092,8 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
                         if (t.isAlive()) // precheck that t is startable
                             throw new IllegalThreadStateException();
                         workers.add(w);
+                        // Android-added: Per-worker local queues.
+                        updateWorkerArray();
                         int s = workers.size();
                         if (s > largestPoolSize)
                             largestPoolSize = s;
@@ -994,8 +1125,9 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
         final ReentrantLock mainLock = this.mainLock;
         mainLock.lock();
         try {
-            if (w != null)
-                workers.remove(w);
+            // Android-changed: Per-worker local queues.
+            if (w != null && workers.remove(w))
+                updateWorkerArray();
             decrementWorkerCount();
             tryTerminate();
         } finally {
@@ -1025,10 +1157,28 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
         try {
             completedTaskCount += w.completedTasks;
             workers.remove(w);
+            // Android-added: Per-worker local queues.
+            updateWorkerArray();
         } finally {
             mainLock.unlock();
         }
 
+        // BEGIN Android-added: Per-worker local queues.
+        // A worker that dies from a task exception may leave local
+        // tasks behind; hand them to the remaining workers.
+        ArrayList<Runnable> unqueued = null;
+        ConcurrentLinkedDeque<Runnable> lq = w.localQueue;
+        if (lq != null) {
+            for (Runnable r; (r = lq.pollFirst()) != null; ) {
+                if (!isRunningOrShutdown(true) || !workQueue.offer(r)) {
+                    if (unqueued == null)
+                        unqueued = new ArrayList<>();
+                    unqueued.add(r);
+                }
+            }
+        }
+        // END Android-added: Per-worker local queues.
+
         tryTerminate();
 
         int c = ctl.get();
@@ -1042,6 +1192,16 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
             }
             addWorker(null, false);
         }
+
+        // BEGIN Android-added: Per-worker local queues.
+        // Reject last, so that a handler that throws cannot skip the
+        // bookkeeping above. Only abrupt exits, which never return
+        // early, leave local tasks behind.
+        if (unqueued != null) {
+            for (Runnable r : unqueued)
+                reject(r);
+        }
+        // END Android-added: Per-worker local queues.
     }
 
     /**
@@ -1058,16 +1218,43 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
      *    both before and after the timed wait, and if the queue is
      *    non-empty, this worker is not the last thread in the pool.
      *
+     * @param w the worker
      * @return task, or null if the worker must exit, in which case
      *         workerCount is decremented
      */
-    private Runnable getTask() {
+    // Android-changed: Per-worker local queues.
+    private Runnable getTask(Worker w) {
         boolean timedOut = false; // Did the last poll() time out?
 
         for (;;) {
             int c = ctl.get();
             int rs = runStateOf(c);
 
+            // BEGIN Android-added: Per-worker local queues.
+            // Local tasks come first, even when shut down, since they
+            // are not in workQueue. A worker drains its own local queue
+            // even if local queues have since been disabled.
+            if (rs < STOP) {
+                ConcurrentLinkedDeque<Runnable> lq = w.localQueue;
+                Runnable r;
+                if (lq != null && !lq.isEmpty()) {
+                    if (w.localTaskStreak >= LOCAL_TASKS_PER_SHARED_POLL) {
+                        w.localTaskStreak = 0;
+                        if ((r = workQueue.poll()) != null)
+                            return r;
+                    }
+                    if ((r = lq.pollLast()) != null) {
+                        w.localTaskStreak++;
+                        return r;
+                    }
+                }
+                w.localTaskStreak = 0;
+                if (localQueues &&
+                    ((r = workQueue.poll()) != null || (r = stealLocal(w)) != null))
+                    return r;
+            }
+            // END Android-added: Per-worker local queues.
+
             // Check if queue empty only if necessary.
             if (rs >= SHUTDOWN && (rs >= STOP || workQueue.isEmpty())) {
                 decrementWorkerCount();
@@ -1086,16 +1273,28 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
                 continue;
             }
 
+            // BEGIN Android-changed: Per-worker local queues.
+            // Announce that this worker is idle, then scan local
+            // queues once more; see idleWorkers.
+            final boolean idle = localQueues;
+            if (idle)
+                idleWorkers.incrementAndGet();
             try {
-                Runnable r = timed ?
-                    workQueue.poll(keepAliveTime, TimeUnit.NANOSECONDS) :
-                    workQueue.take();
+                Runnable r = idle ? stealLocal(w) : null;
+                if (r == null)
+                    r = timed ?
+                        workQueue.poll(keepAliveTime, TimeUnit.NANOSECONDS) :
+                        workQueue.take();
                 if (r != null)
                     return r;
                 timedOut = true;
             } catch (InterruptedException retry) {
                 timedOut = false;
+            } finally {
+                if (idle)
+                    idleWorkers.decrementAndGet();
             }
+            // END Android-changed: Per-worker local queues.
         }
     }
 
@@ -1147,9 +1346,20 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
         Runnable task = w.firstTask;
         w.firstTask = null;
         w.unlock(); // allow interrupts
+        // Android-added: Per-worker local queues.
+        boolean registered = false;
         boolean completedAbruptly = true;
         try {
-            while (task != null || (task = getTask()) != null) {
+            // Android-changed: Per-worker local queues.
+            while (task != null || (task = getTask(w)) != null) {
+                // BEGIN Android-added: Per-worker local queues.
+                // Only pay for the thread local once local queues are
+                // allowed. offerLocal falls back to workQueue until then.
+                if (!registered && localQueues) {
+                    currentWorker.set(w);
+                    registered = true;
+                }
+                // END Android-added: Per-worker local queues.
                 w.lock();
                 // If pool is stopping, ensure thread is interrupted;
                 // if not, ensure thread is not interrupted.  This
@@ -1182,6 +1392,9 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
             }
             completedAbruptly = false;
         } finally {
+            // Android-added: Per-worker local queues.
+            if (registered)
+                currentWorker.remove();
             processWorkerExit(w, completedAbruptly);
         }
     }
@@ -1383,6 +1596,9 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
                 return;
             c = ctl.get();
         }
+        // Android-added: Per-worker local queues.
+        if (localQueues && isRunning(c) && offerLocal(command))
+            return;
         if (isRunning(c) && workQueue.offer(command)) {
             int recheck = ctl.get();
             if (! isRunning(recheck) && remove(command))
@@ -1394,6 +1610,130 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
             reject(command);
     }
 
+    // BEGIN Android-added: Batch submission.
+    /**
+     * Executes the given tasks sometime in the future, as if by calling
+     * {@link #execute} for each of them in iteration order. If the work
+     * queue is a {@link LinkedBlockingQueue}, the tasks that are queued
+     * are inserted with a single acquisition of its lock, and waiting
+     * workers are signalled once rather than once per task.
+     *
+     * <p>Tasks are queued in the work queue even if local queues are
+     * {@linkplain #allowLocalQueues allowed}. Tasks that cannot be
+     * accepted are handled by the current {@code
+     * RejectedExecutionHandler}; if it throws, the tasks after the
+     * rejected one may or may not have been submitted.
+     *
+     * <p>Subclasses that override {@code execute} to change how tasks
+     * are queued should override this method too.
+     *
+     * @param commands the tasks to execute
+     * @throws RejectedExecutionException at discretion of
+     *         {@code RejectedExecutionHandler}, if a task
+     *         cannot be accepted for execution
+     * @throws NullPointerException if {@code commands} or any of its
+     *         elements is null
+     * @hide
+     */
+    public void executeAll(Collection<? extends Runnable> commands) {
+        Runnable[] tasks = commands.toArray(new Runnable[0]);
+        for (Runnable task : tasks)
+            if (task == null)
+                throw new NullPointerException();
+        executeAll(tasks);
+    }
+
+    /**
+     * Executes the given non-null tasks in the same three steps as
+     * execute, except that the second step queues as many tasks as
+     * possible at once.
+     */
+    private void executeAll(Runnable[] tasks) {
+        int i = 0;
+        int n = tasks.length;
+        int c = ctl.get();
+        while (i < n && workerCountOf(c) < corePoolSize) {
+            if (!addWorker(tasks[i], true)) {
+                c = ctl.get();
+                break;
+            }
+            i++;
+            c = ctl.get();
+        }
+        if (i < n && isRunning(c)) {
+            int queued = 0;
+            if (workQueue instanceof LinkedBlockingQueue) {
+                queued = ((LinkedBlockingQueue<Runnable>) workQueue)
+                    .offerAll(Arrays.asList(tasks).subList(i, n));
+            } else {
+                while (i + queued < n && workQueue.offer(tasks[i + queued]))
+                    queued++;
+            }
+            if (queued > 0) {
+                int recheck = ctl.get();
+                if (! isRunning(recheck)) {
+                    for (int j = i; j < i + queued; j++)
+                        if (remove(tasks[j]))
+                            reject(tasks[j]);
+                }
+                else if (workerCountOf(recheck) == 0)
+                    addWorker(null, false);
+                i += queued;
+            }
+        }
+        // The queue is full or the pool is shut down: try to add
+        // threads or reject, one task at a time.
+        for (; i < n; i++)
+            execute(tasks[i]);
+    }
+
+    /**
+     * Executes the given tasks, returning a list of Futures holding
+     * their status and results when all complete, as {@link #invokeAll}
+     * does. The tasks are submitted together by {@link #executeAll}.
+     *
+     * @param tasks the collection of tasks
+     * @param <T> the type of the values returned from the tasks
+     * @return a list of Futures representing the tasks, in the same
+     *         sequential order as produced by the iterator for the
+     *         given task list, each of which has completed
+     * @throws InterruptedException if interrupted while waiting, in
+     *         which case unfinished tasks are cancelled
+     * @throws NullPointerException if tasks or any of its elements are {@code null}
+     * @throws RejectedExecutionException if any task cannot be
+     *         scheduled for execution
+     * @hide
+     */
+    public <T> List<Future<T>> invokeAllBatched(Collection<? extends Callable<T>> tasks)
+        throws InterruptedException {
+        if (tasks == null)
+            throw new NullPointerException();
+        ArrayList<Future<T>> futures = new ArrayList<>(tasks.size());
+        ArrayList<Runnable> runnables = new ArrayList<>(tasks.size());
+        try {
+            for (Callable<T> t : tasks) {
+                RunnableFuture<T> f = newTaskFor(t);
+                futures.add(f);
+                runnables.add(f);
+            }
+            executeAll(runnables);
+            for (int i = 0, size = futures.size(); i < size; i++) {
+                Future<T> f = futures.get(i);
+                if (!f.isDone()) {
+                    try { f.get(); }
+                    catch (CancellationException ignore) {}
+                    catch (ExecutionException ignore) {}
+                }
+            }
+            return futures;
+        } catch (Throwable t) {
+            for (int i = 0, size = futures.size(); i < size; i++)
+                futures.get(i).cancel(true);
+            throw t;
+        }
+    }
+    // END Android-added: Batch submission.
+
     /**
      * Initiates an orderly shutdown in which previously submitted
      * tasks are executed, but no new tasks will be accepted.
@@ -1677,6 +2017,47 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
         }
     }
 
+    // BEGIN Android-added: Per-worker local queues.
+    /**
+     * Returns true if tasks submitted by this pool's own worker
+     * threads may be queued locally to those workers.
+     *
+     * @return {@code true} if local queues are allowed, else {@code false}
+     * @see #allowLocalQueues
+     * @hide
+     */
+    public boolean allowsLocalQueues() {
+        return localQueues;
+    }
+
+    /**
+     * Sets whether tasks that this pool's own worker threads submit by
+     * {@link #execute} may be queued locally to the submitting worker.
+     * This suits tasks that spawn further tasks: while every worker is
+     * busy, such submissions avoid the work queue and its locks. Each
+     * worker runs its own local tasks newest first, before tasks in
+     * the work queue, and a worker with nothing else to do steals the
+     * oldest local task of another worker. Submissions from other
+     * threads, and all submissions while any worker is idle, use the
+     * work queue as usual.
+     *
+     * <p>Local queues are unbounded, so the capacity of a bounded work
+     * queue does not limit locally queued tasks, and they do not
+     * appear in {@link #getQueue}. They are included in the tasks
+     * returned by {@link #shutdownNow} and are considered by
+     * {@link #remove}, but not by {@link #purge}. This has no effect
+     * on a {@link ScheduledThreadPoolExecutor}, whose tasks are always
+     * queued in its delayed work queue.
+     *
+     * @param value {@code true} if tasks may be queued locally, else
+     *        {@code false}
+     * @hide
+     */
+    public void allowLocalQueues(boolean value) {
+        localQueues = value;
+    }
+    // END Android-added: Per-worker local queues.
+
     /**
      * Sets the maximum allowed number of threads. This overrides any
      * value set in the constructor. If the new value is smaller than
@@ -1783,6 +2164,17 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
      */
     public boolean remove(Runnable task) {
         boolean removed = workQueue.remove(task);
+        // BEGIN Android-added: Per-worker local queues.
+        if (!removed) {
+            for (Worker w : workerArray) {
+                ConcurrentLinkedDeque<Runnable> lq = w.localQueue;
+                if (lq != null && lq.removeFirstOccurrence(task)) {
+                    removed = true;
+                    break;
+                }
+            }
+        }
+        // END Android-added: Per-worker local queues.
         tryTerminate(); // In case SHUTDOWN and now empty
         return removed;
     }
@@ -1891,6 +2283,10 @@ public class ThreadPoolExecutor extends AbstractExecutorService {
                 n += w.completedTasks;
                 if (w.isLocked())
                     ++n;
+                // Android-added: Per-worker local queues.
+                ConcurrentLinkedDeque<Runnable> lq = w.localQueue;
+                if (lq != null)
+                    n += lq.size();
             }
             return n + workQueue.size();
         } finally {
@@ -26,8 +26,14 @@
 
 package java.util.jar;
 
+import android.system.ErrnoException;
+import android.system.StructStat;
+import android.system.StructTimespec;
 import java.io.*;
 import java.lang.ref.SoftReference;
+import java.nio.charset.StandardCharsets;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
 import java.util.*;
 import java.util.stream.Stream;
 import java.util.stream.StreamSupport;
@@ -35,6 +41,7 @@ import java.util.zip.*;
 import java.security.CodeSigner;
 import java.security.cert.Certificate;
 import java.security.AccessController;
+import libcore.io.Libcore;
 import sun.misc.IOUtils;
 import sun.security.action.GetPropertyAction;
 import sun.security.util.ManifestEntryVerifier;
@@ -374,6 +381,11 @@ class JarFile extends ZipFile {
         try {
             String[] names = getMetaInfEntryNames();
             if (names != null) {
+                // BEGIN Android-changed: Skip the signature files of jars verified before.
+                // Read the signature-related entries first so that they can identify the
+                // jar in the cache of verified jars.
+                List<JarEntry> metaEntries = new ArrayList<>();
+                List<byte[]> metaBytes = new ArrayList<>();
                 for (int i = 0; i < names.length; i++) {
                     String uname = names[i].toUpperCase(Locale.ENGLISH);
                     if (MANIFEST_NAME.equals(uname)
@@ -382,18 +394,31 @@ class JarFile extends ZipFile {
                         if (e == null) {
                             throw new JarException("corrupted jar file");
                         }
-                        if (mev == null) {
-                            mev = new ManifestEntryVerifier
-                                (getManifestFromReference());
-                        }
-                        byte[] b = getBytes(e);
-                        if (b != null && b.length > 0) {
-                            jv.beginEntry(e, mev);
-                            jv.update(b.length, b, 0, b.length, mev);
-                            jv.update(-1, null, 0, 0, mev);
-                        }
+                        metaEntries.add(e);
+                        metaBytes.add(getBytes(e));
                     }
                 }
+                JarVerifier.CacheKey key = newVerificationCacheKey(metaEntries, metaBytes);
+                if (key != null && jv.initializeFromCache(key)) {
+                    if (JarVerifier.debug != null) {
+                        JarVerifier.debug.println("verified signers found in cache!");
+                    }
+                    return;
+                }
+                for (int i = 0; i < metaEntries.size(); i++) {
+                    JarEntry e = metaEntries.get(i);
+                    if (mev == null) {
+                        mev = new ManifestEntryVerifier
+                            (getManifestFromReference());
+                    }
+                    byte[] b = metaBytes.get(i);
+                    if (b != null && b.length > 0) {
+                        jv.beginEntry(e, mev);
+                        jv.update(b.length, b, 0, b.length, mev);
+                        jv.update(-1, null, 0, 0, mev);
+                    }
+                }
+                // END Android-changed: Skip the signature files of jars verified before.
             }
         } catch (IOException ex) {
             // if we had an error parsing any blocks, just
@@ -426,6 +451,83 @@ class JarFile extends ZipFile {
         }
     }
 
+    // BEGIN Android-added: Parallel verification and a process-wide cache of results.
+    /*
+     * Returns the key identifying this jar in the cache of verified jars, or
+     * null if the file can't be identified.
+     */
+    private JarVerifier.CacheKey newVerificationCacheKey(List<JarEntry> entries,
+            List<byte[]> contents) {
+        try {
+            FileDescriptor fd = new FileDescriptor();
+            fd.setInt$(getFileDescriptor());
+            StructStat st = Libcore.os.fstat(fd);
+            MessageDigest digest = MessageDigest.getInstance("SHA-256");
+            for (int i = 0; i < entries.size(); i++) {
+                digest.update(entries.get(i).getName().getBytes(StandardCharsets.UTF_8));
+                digest.update((byte) 0);
+                byte[] b = contents.get(i);
+                if (b != null) {
+                    digest.update(b);
+                }
+                digest.update((byte) 0);
+            }
+            return new JarVerifier.CacheKey(st.st_dev, st.st_ino, st.st_size,
+                    toNanos(st.st_mtim), toNanos(st.st_ctim), digest.digest());
+        } catch (ErrnoException | NoSuchAlgorithmException e) {
+            return null;
+        }
+    }
+
+    private static long toNanos(StructTimespec ts) {
+        return ts.tv_sec * 1_000_000_000L + ts.tv_nsec;
+    }
+
+    /**
+     * Verifies the digests of all signed entries up front, using up to
+     * {@code parallelism} threads, instead of as each entry is read.
+     *
+     * <p>Once every signed entry of a jar has been verified, the signers are
+     * remembered for the rest of the process. Reopening the same, unchanged
+     * file with the same signature files then skips both signature block
+     * verification and entry digesting.
+     *
+     * <p>This has no effect if the jar was opened without verification or
+     * is not signed.
+     *
+     * @throws SecurityException if any signed entry is incorrectly signed
+     * @throws IllegalArgumentException if {@code parallelism < 1}
+     * @hide
+     */
+    public void verifyAllEntries(int parallelism) throws IOException {
+        if (parallelism < 1) {
+            throw new IllegalArgumentException("parallelism < 1: " + parallelism);
+        }
+        JarVerifier verifier;
+        Manifest man;
+        // Don't hold the lock while verifying: the workers need it to read entries.
+        synchronized (this) {
+            maybeInstantiateVerifier();
+            if (jv != null && !jvInitialized) {
+                initializeVerifier();
+                jvInitialized = true;
+            }
+            verifier = jv;
+            man = verifier != null ? getManifestFromReference() : null;
+        }
+        if (verifier != null) {
+            verifier.verifyAllEntries(this, man, parallelism);
+        }
+    }
+
+    /*
+     * Returns the raw stream for {@code ze}, for callers that verify it themselves.
+     */
+    InputStream getUnverifiedInputStream(ZipEntry ze) throws IOException {
+        return super.getInputStream(ze);
+    }
+    // END Android-added: Parallel verification and a process-wide cache of results.
+
     /*
      * Reads all the bytes for a given entry. Used to process the
      * META-INF files.
@@ -31,8 +31,17 @@ import java.net.URL;
 import java.util.*;
 import java.security.*;
 import java.security.cert.CertificateException;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Future;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.util.zip.ZipEntry;
 
+import libcore.util.BasicLruCache;
+
 import sun.misc.JarIndex;
 import sun.security.util.ManifestDigester;
 import sun.security.util.ManifestEntryVerifier;
@@ -94,6 +103,25 @@ class JarVerifier {
     /** collect -DIGEST-MANIFEST values for blacklist */
     private List<Object> manifestDigests;
 
+    // BEGIN Android-added: Process-wide cache of fully verified jars.
+    /**
+     * Signers of every entry of jars whose entries were all verified by
+     * {@link #verifyAllEntries}, keyed by file identity and signature files.
+     */
+    private static final BasicLruCache<CacheKey, Map<String, CodeSigner[]>> verifiedJars =
+            new BasicLruCache<>(64);
+
+    /** Identifies this jar's file and signature files, or null if caching is not possible. */
+    private CacheKey cacheKey;
+
+    /**
+     * True if this verifier's signers came from {@link #verifiedJars} or all
+     * entries were verified by {@link #verifyAllEntries}. Entries are not
+     * digested again when they are read.
+     */
+    private volatile boolean verifiedFromCache;
+    // END Android-added: Process-wide cache of fully verified jars.
+
     public JarVerifier(byte rawBytes[]) {
         manifestRawBytes = rawBytes;
         sigFileSigners = new Hashtable<>();
@@ -179,6 +207,16 @@ class JarVerifier {
         if (name.startsWith("/"))
             name = name.substring(1);
 
+        // Android-added: Entries of a cached jar were verified when it was first opened.
+        if (verifiedFromCache) {
+            if (je.signers == null) {
+                je.signers = verifiedSigners.get(name);
+                je.certs = mapSignersToCertArray(je.signers);
+            }
+            mev.setEntry(null, je);
+            return;
+        }
+
         // only set the jev object for entries that have a signature
         // (either verified or not)
         if (sigFileSigners.get(name) != null ||
@@ -436,6 +474,203 @@ class JarVerifier {
         }
     }
 
+    // BEGIN Android-added: Parallel verification and a process-wide cache of results.
+    /**
+     * Identity of a verified jar: the file it was read from and a digest of its
+     * manifest and signature files. The inode change time is part of the key
+     * because, unlike the modification time, it cannot be set by the file owner.
+     */
+    static final class CacheKey {
+        private final long device;
+        private final long inode;
+        private final long size;
+        private final long modificationTimeNanos;
+        private final long changeTimeNanos;
+        private final byte[] metaInfDigest;
+
+        CacheKey(long device, long inode, long size, long modificationTimeNanos,
+                long changeTimeNanos, byte[] metaInfDigest) {
+            this.device = device;
+            this.inode = inode;
+            this.size = size;
+            this.modificationTimeNanos = modificationTimeNanos;
+            this.changeTimeNanos = changeTimeNanos;
+            this.metaInfDigest = metaInfDigest;
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            if (!(o instanceof CacheKey)) {
+                return false;
+            }
+            CacheKey that = (CacheKey) o;
+            return device == that.device
+                    && inode == that.inode
+                    && size == that.size
+                    && modificationTimeNanos == that.modificationTimeNanos
+                    && changeTimeNanos == that.changeTimeNanos
+                    && Arrays.equals(metaInfDigest, that.metaInfDigest);
+        }
+
+        @Override
+        public int hashCode() {
+            int result = Long.hashCode(inode);
+            result = 31 * result + Long.hashCode(size);
+            result = 31 * result + Long.hashCode(modificationTimeNanos);
+            result = 31 * result + Arrays.hashCode(metaInfDigest);
+            return result;
+        }
+    }
+
+    /**
+     * Sets the key under which this verifier's results are cached once all of
+     * the jar's entries have been verified. Returns true if the jar was
+     * already verified, in which case the META-INF entries need not be
+     * processed at all.
+     */
+    boolean initializeFromCache(CacheKey key) {
+        cacheKey = key;
+        Map<String, CodeSigner[]> signers = verifiedJars.get(key);
+        if (signers == null) {
+            return false;
+        }
+        verifiedSigners.putAll(signers);
+        verifiedFromCache = true;
+        parsingMeta = false;
+        anyToVerify = true;
+        baos = null;
+        sigFileData = null;
+        pendingBlocks = null;
+        signerCache = null;
+        manifestRawBytes = null;
+        return true;
+    }
+
+    private static final ThreadFactory VERIFIER_THREAD_FACTORY = new ThreadFactory() {
+        private final AtomicInteger count = new AtomicInteger();
+
+        @Override
+        public Thread newThread(Runnable r) {
+            Thread thread = new Thread(r, "JarVerifier-" + count.incrementAndGet());
+            thread.setDaemon(true);
+            return thread;
+        }
+    };
+
+    /**
+     * Threads shared by all calls to {@link #verifyAllEntries}, one per CPU.
+     * They exit when idle, so the pool costs nothing once jars are verified.
+     */
+    private static final class VerifierExecutorHolder {
+        static final ThreadPoolExecutor EXECUTOR;
+        static {
+            int threads = Runtime.getRuntime().availableProcessors();
+            EXECUTOR = new ThreadPoolExecutor(threads, threads, 10, TimeUnit.SECONDS,
+                    new LinkedBlockingQueue<Runnable>(), VERIFIER_THREAD_FACTORY);
+            EXECUTOR.allowCoreThreadTimeOut(true);
+        }
+    }
+
+    /**
+     * Digests every signed entry of {@code jar} on the calling thread and up
+     * to {@code parallelism - 1} threads of a shared pool, and caches the
+     * result if all entries verify. Each task reads its entries through its
+     * own stream; the zip reads are positional, so tasks only serialize on the
+     * reads themselves, not on digesting.
+     *
+     * <p>Once all entries have verified, this verifier is put in the same
+     * state as one found in the cache: entries read later are not digested
+     * again.
+     *
+     * @throws SecurityException if any entry does not match its digest.
+     */
+    void verifyAllEntries(final JarFile jar, final Manifest man, int parallelism)
+            throws IOException {
+        if (verifiedFromCache) {
+            return;
+        }
+
+        List<String> names = new ArrayList<>(sigFileSigners.keySet());
+        int tasks = Math.min(parallelism, Math.max(1, names.size()));
+        List<Future<Void>> results = new ArrayList<>(tasks - 1);
+        try {
+            for (int task = 1; task < tasks; task++) {
+                final List<String> batch = batch(names, task, tasks);
+                results.add(VerifierExecutorHolder.EXECUTOR.submit(() -> {
+                    verifyEntries(jar, man, batch);
+                    return null;
+                }));
+            }
+            verifyEntries(jar, man, batch(names, 0, tasks));
+            for (Future<Void> result : results) {
+                try {
+                    result.get();
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                    throw new InterruptedIOException("interrupted verifying " + jar.getName());
+                } catch (ExecutionException e) {
+                    Throwable cause = e.getCause();
+                    if (cause instanceof IOException) {
+                        throw (IOException) cause;
+                    } else if (cause instanceof RuntimeException) {
+                        throw (RuntimeException) cause;
+                    } else if (cause instanceof Error) {
+                        throw (Error) cause;
+                    }
+                    throw new IOException(cause);
+                }
+            }
+        } finally {
+            // Don't leave work for the shared threads if this call failed.
+            for (Future<Void> result : results) {
+                result.cancel(true);
+            }
+        }
+
+        // Entries named by a signature file but missing from the jar are left
+        // in sigFileSigners; only trust jars whose every signed entry verified.
+        if (sigFileSigners.isEmpty()) {
+            verifiedFromCache = true;
+            if (cacheKey != null) {
+                verifiedJars.put(cacheKey, new HashMap<>(verifiedSigners));
+            }
+        }
+    }
+
+    /** Returns every {@code tasks}-th name of {@code names}, starting at {@code task}. */
+    private static List<String> batch(List<String> names, int task, int tasks) {
+        List<String> batch = new ArrayList<>(names.size() / tasks + 1);
+        for (int i = task; i < names.size(); i += tasks) {
+            batch.add(names.get(i));
+        }
+        return batch;
+    }
+
+    private void verifyEntries(JarFile jar, Manifest man, List<String> names)
+            throws IOException {
+        for (String name : names) {
+            verifyEntry(jar, man, name);
+        }
+    }
+
+    private void verifyEntry(JarFile jar, Manifest man, String name) throws IOException {
+        JarEntry je = jar.getJarEntry(name);
+        if (je == null || je.isDirectory()) {
+            return;
+        }
+        ManifestEntryVerifier mev = new ManifestEntryVerifier(man);
+        mev.setEntry(name, je);
+        try (InputStream is = jar.getUnverifiedInputStream(je)) {
+            byte[] buffer = new byte[8192];
+            int n;
+            while ((n = is.read(buffer, 0, buffer.length)) != -1) {
+                mev.update(buffer, 0, n);
+            }
+        }
+        mev.verify(verifiedSigners, sigFileSigners);
+    }
+    // END Android-added: Parallel verification and a process-wide cache of results.
+
     static class VerifierStream extends java.io.InputStream {
 
         private InputStream is;
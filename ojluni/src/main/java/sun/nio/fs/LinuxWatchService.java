@@ -33,6 +33,7 @@ import java.io.IOException;
 
 import dalvik.annotation.optimization.ReachabilitySensitive;
 import dalvik.system.CloseGuard;
+import libcore.util.IntHashMap;
 import sun.misc.Unsafe;
 
 import static sun.nio.fs.UnixNativeDispatcher.*;
@@ -184,7 +185,8 @@ class LinuxWatchService
         // socketpair used to shutdown polling thread
         private final int socketpair[];
         // maps watch descriptor to Key
-        private final Map<Integer,LinuxWatchKey> wdToKey;
+        // Android-changed: Use IntHashMap to avoid boxing watch descriptors.
+        private final IntHashMap<LinuxWatchKey> wdToKey;
         // address of read buffer
         private final long address;
 
@@ -197,7 +199,8 @@ class LinuxWatchService
             this.watcher = watcher;
             this.ifd = ifd;
             this.socketpair = sp;
-            this.wdToKey = new HashMap<Integer,LinuxWatchKey>();
+            // Android-changed: Use IntHashMap to avoid boxing watch descriptors.
+            this.wdToKey = new IntHashMap<LinuxWatchKey>();
             this.address = unsafe.allocateMemory(BUFFER_SIZE);
             // Android-added: CloseGuard support.
             guard.open("close");
@@ -300,9 +303,8 @@ class LinuxWatchService
             // Android-added: CloseGuard support.
             guard.close();
             // invalidate all keys
-            for (Map.Entry<Integer,LinuxWatchKey> entry: wdToKey.entrySet()) {
-                entry.getValue().invalidate(true);
-            }
+            // Android-changed: Use IntHashMap to avoid boxing watch descriptors.
+            wdToKey.forEach((key, unusedWd) -> key.invalidate(true));
             wdToKey.clear();
 
             // free resources
@@ -429,10 +431,9 @@ class LinuxWatchService
         private void processEvent(int wd, int mask, final UnixPath name) {
             // overflow - signal all keys
             if ((mask & IN_Q_OVERFLOW) > 0) {
-                for (Map.Entry<Integer,LinuxWatchKey> entry: wdToKey.entrySet()) {
-                    entry.getValue()
-                        .signalEvent(StandardWatchEventKinds.OVERFLOW, null);
-                }
+                // Android-changed: Use IntHashMap to avoid boxing watch descriptors.
+                wdToKey.forEach((key, unusedWd) ->
+                    key.signalEvent(StandardWatchEventKinds.OVERFLOW, null));
                 return;
             }
 
@@ -26,6 +26,8 @@
 package sun.security.jca;
 
 import java.util.*;
+// Android-added: Index the services of a fully loaded ProviderList.
+import java.util.concurrent.ConcurrentHashMap;
 
 import java.security.*;
 import java.security.Provider.Service;
@@ -139,6 +141,16 @@ public final class ProviderList {
     // flag indicating whether all configs have been loaded successfully
     private volatile boolean allLoaded;
 
+    // BEGIN Android-added: Index the services of a fully loaded ProviderList.
+    // Index of the services found by getService() and getServices(), or null
+    // if not built yet. Replaced when any of the Providers changes.
+    private volatile ServiceIndex serviceIndex;
+
+    // cleared if a Provider overrides getService(), whose results may then
+    // change without notice and so cannot be indexed
+    private volatile boolean indexable = true;
+    // END Android-added: Index the services of a fully loaded ProviderList.
+
     // List returned by providers()
     private final List<Provider> userList = new AbstractList<Provider>() {
         public int size() {
@@ -327,6 +339,13 @@ public final class ProviderList {
      * algorithm.
      */
     public Service getService(String type, String name) {
+        // BEGIN Android-added: Index the services of a fully loaded ProviderList.
+        ServiceIndex index = getServiceIndex(type, name);
+        if (index != null) {
+            List<Service> services = index.getServices(type, name);
+            return services.isEmpty() ? null : services.get(0);
+        }
+        // END Android-added: Index the services of a fully loaded ProviderList.
         for (int i = 0; i < configs.length; i++) {
             Provider p = getProvider(i);
             Service s = p.getService(type, name);
@@ -347,6 +366,12 @@ public final class ProviderList {
      * The List returned is NOT thread safe.
      */
     public List<Service> getServices(String type, String algorithm) {
+        // BEGIN Android-added: Index the services of a fully loaded ProviderList.
+        ServiceIndex index = getServiceIndex(type, algorithm);
+        if (index != null) {
+            return index.getServices(type, algorithm);
+        }
+        // END Android-added: Index the services of a fully loaded ProviderList.
         return new ServiceList(type, algorithm);
     }
 
@@ -368,6 +393,144 @@ public final class ProviderList {
         return new ServiceList(ids);
     }
 
+    // BEGIN Android-added: Index the services of a fully loaded ProviderList.
+    /**
+     * Return the index to use for looking up the specified type and algorithm,
+     * or null if the Providers must be queried directly. The index is only used
+     * once all Providers are loaded, so that lookups do not load Providers that
+     * would otherwise not be needed.
+     */
+    private ServiceIndex getServiceIndex(String type, String algorithm) {
+        if ((type == null) || (algorithm == null) || !allLoaded || !indexable) {
+            return null;
+        }
+        ServiceIndex index = serviceIndex;
+        if ((index != null) && index.isCurrent()) {
+            return index;
+        }
+        Provider[] providers = new Provider[configs.length];
+        for (int i = 0; i < configs.length; i++) {
+            Provider p = getProvider(i);
+            if (!ServiceIndex.canIndex(p)) {
+                indexable = false;
+                return null;
+            }
+            providers[i] = p;
+        }
+        index = new ServiceIndex(providers);
+        serviceIndex = index;
+        return index;
+    }
+
+    /**
+     * Immutable view of the services of a list of Providers, keyed by type
+     * and algorithm name. Each entry holds the services in precedence order,
+     * as found by Provider.getService(), so aliases and differences in case
+     * are resolved when the entry is added rather than on every lookup.
+     *
+     * Entries are added on first use, as building the whole index would
+     * require parsing the legacy properties of every Provider. An index is
+     * valid only as long as isCurrent() returns true.
+     *
+     * Thread safe.
+     */
+    private static final class ServiceIndex {
+
+        // bound on the number of types, and algorithms per type, remembered,
+        // in case callers look up many names that are not supported
+        private final static int MAX_ENTRIES = 256;
+
+        private final Provider[] providers;
+
+        // Provider.getServiceVersion() of each Provider when indexed
+        private final int[] versions;
+
+        // type -> algorithm name as passed by the caller -> services
+        private final ConcurrentHashMap<String,
+                ConcurrentHashMap<String, List<Service>>> types =
+                        new ConcurrentHashMap<>();
+
+        ServiceIndex(Provider[] providers) {
+            this.providers = providers;
+            this.versions = new int[providers.length];
+            for (int i = 0; i < providers.length; i++) {
+                versions[i] = providers[i].getServiceVersion();
+            }
+        }
+
+        // whether the services of p can be indexed. A Provider that overrides
+        // getService() may return different services without changing its
+        // service version.
+        static boolean canIndex(Provider p) {
+            try {
+                return p.getClass().getMethod("getService", String.class,
+                        String.class).getDeclaringClass() == Provider.class;
+            } catch (NoSuchMethodException e) {
+                throw new AssertionError(e);
+            }
+        }
+
+        // whether none of the Providers has changed since it was indexed
+        boolean isCurrent() {
+            for (int i = 0; i < providers.length; i++) {
+                if (providers[i].getServiceVersion() != versions[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        List<Service> getServices(String type, String algorithm) {
+            ConcurrentHashMap<String, List<Service>> algorithms =
+                    types.get(type);
+            if (algorithms == null) {
+                if (types.size() >= MAX_ENTRIES) {
+                    return lookUp(type, algorithm);
+                }
+                algorithms = new ConcurrentHashMap<>();
+                ConcurrentHashMap<String, List<Service>> existing =
+                        types.putIfAbsent(type, algorithms);
+                if (existing != null) {
+                    algorithms = existing;
+                }
+            }
+            List<Service> services = algorithms.get(algorithm);
+            if (services == null) {
+                services = lookUp(type, algorithm);
+                if (algorithms.size() < MAX_ENTRIES) {
+                    algorithms.putIfAbsent(algorithm, services);
+                }
+            }
+            return services;
+        }
+
+        private List<Service> lookUp(String type, String algorithm) {
+            Service first = null;
+            List<Service> services = null;
+            for (Provider p : providers) {
+                Service s = p.getService(type, algorithm);
+                if (s == null) {
+                    continue;
+                }
+                if (first == null) {
+                    first = s;
+                } else {
+                    if (services == null) {
+                        services = new ArrayList<>(4);
+                        services.add(first);
+                    }
+                    services.add(s);
+                }
+            }
+            if (services != null) {
+                return Collections.unmodifiableList(services);
+            }
+            return (first != null) ? Collections.singletonList(first)
+                                   : Collections.<Service>emptyList();
+        }
+    }
+    // END Android-added: Index the services of a fully loaded ProviderList.
+
     /**
      * Inner class for a List of Services. Custom List implementation in
      * order to delay Provider initialization and lookup.
@@ -213,7 +213,8 @@ public class X509Factory {
     /**
      * Get the X509CertImpl or X509CRLImpl from the cache.
      */
-    private static synchronized <K,V> V getFromCache(Cache<K,V> cache,
+    // Android-changed: Don't synchronize; the cache is safe for concurrent use.
+    private static <K,V> V getFromCache(Cache<K,V> cache,
             byte[] encoding) {
         Object key = new Cache.EqualByteArray(encoding);
         return cache.get(key);
@@ -222,7 +223,8 @@ public class X509Factory {
     /**
      * Add the X509CertImpl or X509CRLImpl to the cache.
      */
-    private static synchronized <V> void addToCache(Cache<Object, V> cache,
+    // Android-changed: Don't synchronize; the cache is safe for concurrent use.
+    private static <V> void addToCache(Cache<Object, V> cache,
             byte[] encoding, V value) {
         if (encoding.length > ENC_MAX_LENGTH) {
             return;
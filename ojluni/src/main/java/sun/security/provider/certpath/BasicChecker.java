@@ -26,11 +26,15 @@
 package sun.security.provider.certpath;
 
 import java.math.BigInteger;
+// Android-added: Memoize signature verification.
+import java.nio.charset.StandardCharsets;
 import java.util.Collection;
 import java.util.Date;
 import java.util.Set;
 import java.security.GeneralSecurityException;
 import java.security.KeyFactory;
+// Android-added: Memoize signature verification.
+import java.security.MessageDigest;
 import java.security.PublicKey;
 import java.security.SignatureException;
 import java.security.cert.Certificate;
@@ -47,6 +51,10 @@ import java.security.interfaces.DSAPublicKey;
 import java.security.spec.DSAPublicKeySpec;
 import javax.security.auth.x500.X500Principal;
 import sun.security.x509.X500Name;
+// BEGIN Android-added: Memoize signature verification.
+import sun.security.x509.X509CertImpl;
+import sun.security.util.Cache;
+// END Android-added: Memoize signature verification.
 import sun.security.util.Debug;
 
 /**
@@ -68,6 +76,50 @@ class BasicChecker extends PKIXCertPathChecker {
     private X500Principal prevSubject;
     private PublicKey prevPubKey;
 
+    // BEGIN Android-added: Memoize signature verification.
+    // Digests of (certificate, issuer key, provider) triples whose signature
+    // has verified, used by checkers for parameters that enable
+    // PKIXCertPathValidator's result cache. Only successes are recorded.
+    private static final int VERIFIED_SIGNATURES_SIZE = 256;
+    private static final Cache<Cache.EqualByteArray, Boolean> verifiedSignatures =
+            Cache.newSoftMemoryCache(VERIFIED_SIGNATURES_SIZE);
+
+    private boolean memoizeSignatures;
+
+    /**
+     * Makes this checker skip signatures that have verified before, and
+     * record the ones it verifies.
+     */
+    void setMemoizeSignatures(boolean memoizeSignatures) {
+        this.memoizeSignatures = memoizeSignatures;
+    }
+
+    /**
+     * Returns a key identifying the signature of {@code cert} checked with
+     * {@code key} by {@code sigProvider}, or null if one can't be computed.
+     */
+    private static Cache.EqualByteArray signatureKey(X509Certificate cert,
+            PublicKey key, String sigProvider) {
+        byte[] keyEncoding = key.getEncoded();
+        if (keyEncoding == null) {
+            return null;
+        }
+        try {
+            MessageDigest md = MessageDigest.getInstance("SHA-256");
+            md.update((cert instanceof X509CertImpl)
+                    ? ((X509CertImpl) cert).getEncodedInternal()
+                    : cert.getEncoded());
+            md.update(keyEncoding);
+            if (sigProvider != null) {
+                md.update(sigProvider.getBytes(StandardCharsets.UTF_8));
+            }
+            return new Cache.EqualByteArray(md.digest());
+        } catch (GeneralSecurityException e) {
+            return null;
+        }
+    }
+    // END Android-added: Memoize signature verification.
+
     /**
      * Constructor that initializes the input parameters.
      *
@@ -162,6 +214,17 @@ class BasicChecker extends PKIXCertPathChecker {
         if (debug != null)
             debug.println("---checking " + msg + "...");
 
+        // BEGIN Android-added: Memoize signature verification.
+        Cache.EqualByteArray key = null;
+        if (memoizeSignatures) {
+            key = signatureKey(cert, prevPubKey, sigProvider);
+            if (key != null && verifiedSignatures.get(key) != null) {
+                if (debug != null)
+                    debug.println(msg + " verified (cached).");
+                return;
+            }
+        }
+        // END Android-added: Memoize signature verification.
         try {
             if (sigProvider != null) {
                 cert.verify(prevPubKey, sigProvider);
@@ -175,6 +238,10 @@ class BasicChecker extends PKIXCertPathChecker {
         } catch (GeneralSecurityException e) {
             throw new CertPathValidatorException(msg + " check failed", e);
         }
+        // Android-added: Memoize signature verification.
+        if (key != null) {
+            verifiedSignatures.put(key, Boolean.TRUE);
+        }
 
         if (debug != null)
             debug.println(msg + " verified.");
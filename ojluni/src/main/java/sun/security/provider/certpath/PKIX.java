@@ -172,6 +172,10 @@ class PKIX {
         boolean revocationEnabled() {
             return params.isRevocationEnabled();
         }
+        // Android-added: Opt-in caching of validation results.
+        boolean resultCacheEnabled() {
+            return params.isResultCacheEnabled();
+        }
         boolean policyMappingInhibited() {
             return params.isPolicyMappingInhibited();
         }
@@ -27,11 +27,16 @@ package sun.security.provider.certpath;
 
 import java.io.IOException;
 import java.security.InvalidAlgorithmParameterException;
+// Android-added: Cache of validation results.
+import java.security.MessageDigest;
+import java.security.GeneralSecurityException;
 import java.security.cert.*;
 import java.util.*;
 
 import sun.security.provider.certpath.PKIX.ValidatorParams;
 import sun.security.x509.X509CertImpl;
+// Android-added: Cache of validation results.
+import sun.security.util.Cache;
 import sun.security.util.Debug;
 
 /**
@@ -76,8 +81,200 @@ public final class PKIXCertPathValidator extends CertPathValidatorSpi {
         throws CertPathValidatorException, InvalidAlgorithmParameterException
     {
         ValidatorParams valParams = PKIX.checkParams(cp, params);
-        return validate(valParams);
+        // BEGIN Android-changed: Cache of validation results.
+        // return validate(valParams);
+        ResultKey key = valParams.resultCacheEnabled() ? ResultKey.of(valParams) : null;
+        if (key == null) {
+            return validate(valParams);
+        }
+        CachedResult cached = resultCache.get(key);
+        if (cached != null && cached.isValidAt(valParams.date())) {
+            if (debug != null)
+                debug.println("PKIXCertPathValidator: cached result");
+            return (CertPathValidatorResult) cached.result.clone();
+        }
+        PKIXCertPathValidatorResult result = validate(valParams);
+        resultCache.put(key, new CachedResult(result, valParams.certificates()));
+        return result;
+        // END Android-changed: Cache of validation results.
+    }
+
+    // BEGIN Android-added: Cache of validation results.
+    /*
+     * Clients that validate the same chains repeatedly, such as TLS clients
+     * talking to a few servers, may opt in to caching successful results
+     * with PKIXParameters.setResultCacheEnabled. A result is reused only for
+     * the same certificates, trust anchors with the same content and the
+     * same parameters, and only for validation dates within the validity
+     * periods of all the certificates. Paths validated with revocation
+     * checking, additional PKIXCertPathCheckers or target constraints are
+     * never cached, because their outcome may change over time or depend on
+     * caller state. For parameters with caching enabled, BasicChecker also
+     * remembers which certificate signatures verified.
+     */
+    private static final int RESULT_CACHE_SIZE = 64;
+    private static final Cache<ResultKey, CachedResult> resultCache =
+            Cache.newSoftMemoryCache(RESULT_CACHE_SIZE);
+
+    /**
+     * Digests of the trust anchors seen so far. TrustAnchor has identity
+     * equality, and anchor sets are usually long-lived, so this avoids
+     * digesting every anchor's certificate on each validation.
+     */
+    private static final Map<TrustAnchor, byte[]> anchorDigests =
+            Collections.synchronizedMap(new WeakHashMap<TrustAnchor, byte[]>());
+
+    private static byte[] anchorDigest(TrustAnchor anchor)
+            throws GeneralSecurityException {
+        byte[] digest = anchorDigests.get(anchor);
+        if (digest == null) {
+            MessageDigest md = MessageDigest.getInstance("SHA-256");
+            X509Certificate cert = anchor.getTrustedCert();
+            if (cert != null) {
+                md.update((byte) 0);
+                md.update((cert instanceof X509CertImpl)
+                        ? ((X509CertImpl) cert).getEncodedInternal()
+                        : cert.getEncoded());
+            } else {
+                // ValidatorParams rejects anchors with name constraints.
+                byte[] keyEncoding = anchor.getCAPublicKey().getEncoded();
+                if (keyEncoding == null) {
+                    throw new GeneralSecurityException("unencodable CA key");
+                }
+                md.update((byte) 1);
+                md.update(anchor.getCA().getEncoded());
+                md.update(keyEncoding);
+            }
+            digest = md.digest();
+            anchorDigests.put(anchor, digest);
+        }
+        return digest;
+    }
+
+    /**
+     * Returns a digest of the content of {@code anchors} that doesn't
+     * depend on their iteration order.
+     */
+    private static byte[] anchorsDigest(Set<TrustAnchor> anchors)
+            throws GeneralSecurityException {
+        byte[][] digests = new byte[anchors.size()][];
+        int i = 0;
+        for (TrustAnchor anchor : anchors) {
+            digests[i++] = anchorDigest(anchor);
+        }
+        Arrays.sort(digests, (a, b) -> {
+            for (int j = 0; j < a.length; j++) {
+                int c = Integer.compare(a[j] & 0xff, b[j] & 0xff);
+                if (c != 0) {
+                    return c;
+                }
+            }
+            return 0;
+        });
+        MessageDigest md = MessageDigest.getInstance("SHA-256");
+        for (byte[] digest : digests) {
+            md.update(digest);
+        }
+        return md.digest();
+    }
+
+    private static final class ResultKey {
+        private final byte[] chainDigest;
+        private final byte[] anchorsDigest;
+        private final Set<String> initialPolicies;
+        private final String sigProvider;
+        private final int flags;
+        private final int hash;
+
+        private ResultKey(byte[] chainDigest, byte[] anchorsDigest,
+                          ValidatorParams params) {
+            this.chainDigest = chainDigest;
+            this.anchorsDigest = anchorsDigest;
+            this.initialPolicies = params.initialPolicies();
+            this.sigProvider = params.sigProvider();
+            this.flags = (params.explicitPolicyRequired() ? 1 : 0)
+                    | (params.policyMappingInhibited() ? 2 : 0)
+                    | (params.anyPolicyInhibited() ? 4 : 0)
+                    | (params.policyQualifiersRejected() ? 8 : 0);
+            this.hash = Arrays.hashCode(chainDigest)
+                    ^ Arrays.hashCode(anchorsDigest) ^ flags;
+        }
+
+        /**
+         * Returns the key for validating with {@code params}, or null if the
+         * result must not be cached.
+         */
+        static ResultKey of(ValidatorParams params) {
+            // Target constraints are cloned on each access, so they can't
+            // be compared by identity, and may not implement equals.
+            if (params.revocationEnabled()
+                    || !params.certPathCheckers().isEmpty()
+                    || params.targetCertConstraints() != null) {
+                return null;
+            }
+            List<X509Certificate> certs = params.certificates();
+            if (certs.isEmpty()) {
+                return null;
+            }
+            try {
+                MessageDigest md = MessageDigest.getInstance("SHA-256");
+                for (X509Certificate cert : certs) {
+                    md.update((cert instanceof X509CertImpl)
+                            ? ((X509CertImpl) cert).getEncodedInternal()
+                            : cert.getEncoded());
+                }
+                return new ResultKey(md.digest(),
+                        anchorsDigest(params.trustAnchors()), params);
+            } catch (GeneralSecurityException e) {
+                return null;
+            }
+        }
+
+        @Override
+        public int hashCode() {
+            return hash;
+        }
+
+        @Override
+        public boolean equals(Object obj) {
+            if (!(obj instanceof ResultKey)) {
+                return false;
+            }
+            ResultKey other = (ResultKey) obj;
+            return hash == other.hash
+                    && Arrays.equals(anchorsDigest, other.anchorsDigest)
+                    && flags == other.flags
+                    && Arrays.equals(chainDigest, other.chainDigest)
+                    && Objects.equals(initialPolicies, other.initialPolicies)
+                    && Objects.equals(sigProvider, other.sigProvider);
+        }
+    }
+
+    private static final class CachedResult {
+        final PKIXCertPathValidatorResult result;
+        // The intersection of the certificates' validity periods.
+        private final long notBefore;
+        private final long notAfter;
+
+        CachedResult(PKIXCertPathValidatorResult result,
+                     List<X509Certificate> certs) {
+            this.result = result;
+            long notBefore = Long.MIN_VALUE;
+            long notAfter = Long.MAX_VALUE;
+            for (X509Certificate cert : certs) {
+                notBefore = Math.max(notBefore, cert.getNotBefore().getTime());
+                notAfter = Math.min(notAfter, cert.getNotAfter().getTime());
+            }
+            this.notBefore = notBefore;
+            this.notAfter = notAfter;
+        }
+
+        boolean isValidAt(Date date) {
+            long time = date.getTime();
+            return notBefore <= time && time <= notAfter;
+        }
     }
+    // END Android-added: Cache of validation results.
 
     private static PKIXCertPathValidatorResult validate(ValidatorParams params)
         throws CertPathValidatorException
@@ -194,6 +391,8 @@ public final class PKIXCertPathValidator extends CertPathValidatorSpi {
         // default value for date is current time
         BasicChecker bc = new BasicChecker(anchor, params.date(),
                                            params.sigProvider(), false);
+        // Android-added: Cache of validation results.
+        bc.setMemoizeSignatures(params.resultCacheEnabled());
         certPathCheckers.add(bc);
 
         boolean revCheckerAdded = false;
@@ -27,6 +27,10 @@ package sun.security.util;
 
 import java.util.*;
 import java.lang.ref.*;
+// BEGIN Android-added: Lock-free reads in MemoryCache.
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.LongAdder;
+// END Android-added: Lock-free reads in MemoryCache.
 
 /**
  * Abstract base class and factory for caches. A cache is a key-value mapping.
@@ -57,6 +61,9 @@ import java.lang.ref.*;
  * eagerly. Performance may be improved if the Java heap size is set to larger
  * value using e.g. java -ms64M -mx128M foo.Test
  *
+ * Android-note: the memory cache approximates LRU replacement; see
+ * MemoryCache.
+ *
  * Cache sizing: the memory cache is implemented on top of a LinkedHashMap.
  * In its current implementation, the number of buckets (NOT entries) in
  * (Linked)HashMaps is always a power of two. It is recommended to set the
@@ -115,6 +122,32 @@ public abstract class Cache<K,V> {
      */
     public abstract void accept(CacheVisitor<K,V> visitor);
 
+    // BEGIN Android-added: Cache statistics.
+    /**
+     * Return the number of calls to get() that returned a cached value,
+     * or 0 if this cache does not record statistics.
+     */
+    public long hitCount() {
+        return 0;
+    }
+
+    /**
+     * Return the number of calls to get() that did not return a value,
+     * or 0 if this cache does not record statistics.
+     */
+    public long missCount() {
+        return 0;
+    }
+
+    /**
+     * Return the number of entries removed to keep the cache within its
+     * maximum size, or 0 if this cache does not record statistics.
+     */
+    public long evictionCount() {
+        return 0;
+    }
+    // END Android-added: Cache statistics.
+
     /**
      * Return a new memory cache with the specified maximum size, unlimited
      * lifetime for entries, with the values held by SoftReferences.
@@ -242,6 +275,15 @@ class NullCache<K,V> extends Cache<K,V> {
 
 }
 
+// BEGIN Android-changed: Lock-free reads in MemoryCache.
+// The upstream implementation synchronized every call and kept entries in an
+// access-ordered LinkedHashMap, so all callers (for example X509Factory's
+// certificate and CRL caches) contended on the cache's monitor. This version
+// keeps entries in a ConcurrentHashMap and approximates LRU replacement with
+// the CLOCK algorithm: get() only marks an entry as referenced, and
+// unreferenced entries are replaced first. Writers are serialized by the
+// cache's monitor. Cleared soft references and expired entries are removed
+// incrementally by writers instead of by a scan on every call.
 class MemoryCache<K,V> extends Cache<K,V> {
 
     private final static float LOAD_FACTOR = 0.75f;
@@ -249,14 +291,21 @@ class MemoryCache<K,V> extends Cache<K,V> {
     // XXXX
     private final static boolean DEBUG = false;
 
-    private final Map<K, CacheEntry<K,V>> cacheMap;
-    private int maxSize;
-    private long lifetime;
+    private final ConcurrentHashMap<K, CacheEntry<K,V>> cacheMap;
+    // Entries in the order they are considered for replacement. May hold
+    // entries that have since been removed from cacheMap. Guarded by this.
+    private final ArrayDeque<CacheEntry<K,V>> clock = new ArrayDeque<>();
+    private volatile int maxSize;
+    private volatile long lifetime;
 
     // ReferenceQueue is of type V instead of Cache<K,V>
     // to allow SoftCacheEntry to extend SoftReference<V>
     private final ReferenceQueue<V> queue;
 
+    private final LongAdder hitCount = new LongAdder();
+    private final LongAdder missCount = new LongAdder();
+    private final LongAdder evictionCount = new LongAdder();
+
     public MemoryCache(boolean soft, int maxSize) {
         this(soft, maxSize, 0);
     }
@@ -270,15 +319,14 @@ class MemoryCache<K,V> extends Cache<K,V> {
             this.queue = null;
 
         int buckets = (int)(maxSize / LOAD_FACTOR) + 1;
-        cacheMap = new LinkedHashMap<>(buckets, LOAD_FACTOR, true);
+        cacheMap = new ConcurrentHashMap<>(buckets, LOAD_FACTOR);
     }
 
     /**
      * Empty the reference queue and remove all corresponding entries
      * from the cache.
      *
-     * This method should be called at the beginning of each public
-     * method.
+     * This is called by writers only, so that get() never polls the queue.
      */
     private void emptyQueue() {
         if (queue == null) {
@@ -296,12 +344,8 @@ class MemoryCache<K,V> extends Cache<K,V> {
                 // key is null, entry has already been removed
                 continue;
             }
-            CacheEntry<K,V> currentEntry = cacheMap.remove(key);
-            // check if the entry in the map corresponds to the expired
-            // entry. If not, readd the entry
-            if ((currentEntry != null) && (entry != currentEntry)) {
-                cacheMap.put(key, currentEntry);
-            }
+            // Only remove the entry if it has not been replaced.
+            cacheMap.remove(key, entry);
         }
         if (DEBUG) {
             int endSize = cacheMap.size();
@@ -322,12 +366,12 @@ class MemoryCache<K,V> extends Cache<K,V> {
         }
         int cnt = 0;
         long time = System.currentTimeMillis();
-        for (Iterator<CacheEntry<K,V>> t = cacheMap.values().iterator();
-                t.hasNext(); ) {
-            CacheEntry<K,V> entry = t.next();
+        for (Map.Entry<K, CacheEntry<K,V>> e : cacheMap.entrySet()) {
+            CacheEntry<K,V> entry = e.getValue();
             if (entry.isValid(time) == false) {
-                t.remove();
-                cnt++;
+                if (cacheMap.remove(e.getKey(), entry)) {
+                    cnt++;
+                }
             }
         }
         if (DEBUG) {
@@ -338,6 +382,74 @@ class MemoryCache<K,V> extends Cache<K,V> {
         }
     }
 
+    /**
+     * Returns whether {@code entry} is still the mapping for its key, as
+     * opposed to having been replaced, removed or invalidated.
+     */
+    private boolean isMapped(CacheEntry<K,V> entry) {
+        K key = entry.getKey();
+        return (key != null) && (cacheMap.get(key) == entry);
+    }
+
+    /**
+     * Remove entries in clock order until there are at most {@code limit}.
+     * Expired entries are removed as they are reached; referenced entries are
+     * given a second chance, but only during the first sweep of the clock, so
+     * that readers marking entries concurrently can't keep this going.
+     * {@code newest} is only removed if no other entry is left. Must be
+     * called holding this.
+     */
+    private void evict(int limit, CacheEntry<K,V> newest) {
+        long time = (lifetime == 0) ? 0 : System.currentTimeMillis();
+        int secondChances = clock.size();
+        while (cacheMap.size() > limit) {
+            CacheEntry<K,V> entry = clock.pollFirst();
+            if (entry == null) {
+                break;
+            }
+            if (!isMapped(entry)) {
+                continue;
+            }
+            K key = entry.getKey();
+            if (entry.isValid(time) == false) {
+                cacheMap.remove(key, entry);
+                continue;
+            }
+            if (entry == newest && !clock.isEmpty()) {
+                clock.addLast(entry);
+                continue;
+            }
+            if (secondChances > 0 && entry.clearReferenced()) {
+                secondChances--;
+                clock.addLast(entry);
+                continue;
+            }
+            if (DEBUG) {
+                System.out.println("** Overflow removal "
+                    + key + " | " + entry.getValue());
+            }
+            cacheMap.remove(key, entry);
+            entry.invalidate();
+            evictionCount.increment();
+        }
+    }
+
+    /**
+     * Drop entries that are no longer mapped from the clock once they
+     * outnumber the mapped ones. Must be called holding this.
+     */
+    private void compactClock() {
+        if (clock.size() <= 2 * cacheMap.size() + 16) {
+            return;
+        }
+        for (int i = clock.size(); i > 0; i--) {
+            CacheEntry<K,V> entry = clock.pollFirst();
+            if (isMapped(entry)) {
+                clock.addLast(entry);
+            }
+        }
+    }
+
     public synchronized int size() {
         expungeExpiredEntries();
         return cacheMap.size();
@@ -355,52 +467,54 @@ class MemoryCache<K,V> extends Cache<K,V> {
             }
         }
         cacheMap.clear();
+        clock.clear();
     }
 
-    public synchronized void put(K key, V value) {
-        emptyQueue();
+    public void put(K key, V value) {
         long expirationTime = (lifetime == 0) ? 0 :
                                         System.currentTimeMillis() + lifetime;
         CacheEntry<K,V> newEntry = newEntry(key, value, expirationTime, queue);
-        CacheEntry<K,V> oldEntry = cacheMap.put(key, newEntry);
-        if (oldEntry != null) {
-            oldEntry.invalidate();
-            return;
-        }
-        if (maxSize > 0 && cacheMap.size() > maxSize) {
-            expungeExpiredEntries();
-            if (cacheMap.size() > maxSize) { // still too large?
-                Iterator<CacheEntry<K,V>> t = cacheMap.values().iterator();
-                CacheEntry<K,V> lruEntry = t.next();
-                if (DEBUG) {
-                    System.out.println("** Overflow removal "
-                        + lruEntry.getKey() + " | " + lruEntry.getValue());
-                }
-                t.remove();
-                lruEntry.invalidate();
+        synchronized (this) {
+            emptyQueue();
+            CacheEntry<K,V> oldEntry = cacheMap.put(key, newEntry);
+            clock.addLast(newEntry);
+            if (oldEntry != null) {
+                oldEntry.invalidate();
+            } else if (maxSize > 0 && cacheMap.size() > maxSize) {
+                evict(maxSize, newEntry);
             }
+            compactClock();
         }
     }
 
-    public synchronized V get(Object key) {
-        emptyQueue();
+    public V get(Object key) {
         CacheEntry<K,V> entry = cacheMap.get(key);
         if (entry == null) {
+            missCount.increment();
             return null;
         }
         long time = (lifetime == 0) ? 0 : System.currentTimeMillis();
-        if (entry.isValid(time) == false) {
+        if (entry.hasExpired(time)) {
+            // Leave the entry to be removed by a writer, which holds the lock
+            // that invalidate() needs.
             if (DEBUG) {
                 System.out.println("Ignoring expired entry");
             }
-            cacheMap.remove(key);
+            missCount.increment();
+            return null;
+        }
+        V value = entry.getValue();
+        if (value == null) {
+            // Invalidated by a concurrent writer.
+            missCount.increment();
             return null;
         }
-        return entry.getValue();
+        entry.markReferenced();
+        hitCount.increment();
+        return value;
     }
 
     public synchronized void remove(Object key) {
-        emptyQueue();
         CacheEntry<K,V> entry = cacheMap.remove(key);
         if (entry != null) {
             entry.invalidate();
@@ -410,19 +524,11 @@ class MemoryCache<K,V> extends Cache<K,V> {
     public synchronized void setCapacity(int size) {
         expungeExpiredEntries();
         if (size > 0 && cacheMap.size() > size) {
-            Iterator<CacheEntry<K,V>> t = cacheMap.values().iterator();
-            for (int i = cacheMap.size() - size; i > 0; i--) {
-                CacheEntry<K,V> lruEntry = t.next();
-                if (DEBUG) {
-                    System.out.println("** capacity reset removal "
-                        + lruEntry.getKey() + " | " + lruEntry.getValue());
-                }
-                t.remove();
-                lruEntry.invalidate();
-            }
+            evict(size, null);
         }
 
         maxSize = size > 0 ? size : 0;
+        compactClock();
 
         if (DEBUG) {
             System.out.println("** capacity reset to " + size);
@@ -446,11 +552,31 @@ class MemoryCache<K,V> extends Cache<K,V> {
         visitor.visit(cached);
     }
 
+    @Override
+    public long hitCount() {
+        return hitCount.sum();
+    }
+
+    @Override
+    public long missCount() {
+        return missCount.sum();
+    }
+
+    @Override
+    public long evictionCount() {
+        return evictionCount.sum();
+    }
+
     private Map<K,V> getCachedEntries() {
         Map<K,V> kvmap = new HashMap<>(cacheMap.size());
 
         for (CacheEntry<K,V> entry : cacheMap.values()) {
-            kvmap.put(entry.getKey(), entry.getValue());
+            K key = entry.getKey();
+            V value = entry.getValue();
+            // Skip entries invalidated concurrently by get() or remove().
+            if (key != null && value != null) {
+                kvmap.put(key, value);
+            }
         }
 
         return kvmap;
@@ -469,12 +595,24 @@ class MemoryCache<K,V> extends Cache<K,V> {
 
         boolean isValid(long currentTime);
 
+        /**
+         * Returns whether the entry has expired, without invalidating it.
+         * Safe to call without holding the cache's lock.
+         */
+        boolean hasExpired(long currentTime);
+
         void invalidate();
 
         K getKey();
 
         V getValue();
 
+        /** Note that the entry has been read since the clock last passed it. */
+        void markReferenced();
+
+        /** Clear the referenced mark, returning whether it was set. */
+        boolean clearReferenced();
+
     }
 
     private static class HardCacheEntry<K,V> implements CacheEntry<K,V> {
@@ -482,6 +620,7 @@ class MemoryCache<K,V> extends Cache<K,V> {
         private K key;
         private V value;
         private long expirationTime;
+        private volatile boolean referenced;
 
         HardCacheEntry(K key, V value, long expirationTime) {
             this.key = key;
@@ -505,11 +644,30 @@ class MemoryCache<K,V> extends Cache<K,V> {
             return valid;
         }
 
+        public boolean hasExpired(long currentTime) {
+            return currentTime > expirationTime;
+        }
+
         public void invalidate() {
             key = null;
             value = null;
             expirationTime = -1;
         }
+
+        public void markReferenced() {
+            // Avoid the write when the entry is already marked.
+            if (!referenced) {
+                referenced = true;
+            }
+        }
+
+        public boolean clearReferenced() {
+            boolean wasReferenced = referenced;
+            if (wasReferenced) {
+                referenced = false;
+            }
+            return wasReferenced;
+        }
     }
 
     private static class SoftCacheEntry<K,V>
@@ -518,6 +676,7 @@ class MemoryCache<K,V> extends Cache<K,V> {
 
         private K key;
         private long expirationTime;
+        private volatile boolean referenced;
 
         SoftCacheEntry(K key, V value, long expirationTime,
                 ReferenceQueue<V> queue) {
@@ -542,11 +701,31 @@ class MemoryCache<K,V> extends Cache<K,V> {
             return valid;
         }
 
+        public boolean hasExpired(long currentTime) {
+            // A cleared reference is reported by getValue() returning null.
+            return currentTime > expirationTime;
+        }
+
         public void invalidate() {
             clear();
             key = null;
             expirationTime = -1;
         }
+
+        public void markReferenced() {
+            if (!referenced) {
+                referenced = true;
+            }
+        }
+
+        public boolean clearReferenced() {
+            boolean wasReferenced = referenced;
+            if (wasReferenced) {
+                referenced = false;
+            }
+            return wasReferenced;
+        }
     }
 
 }
+// END Android-changed: Lock-free reads in MemoryCache.
@@ -26,6 +26,8 @@
 package sun.security.util;
 
 import java.io.ByteArrayInputStream;
+// Android-added: Copy values out without an intermediate array.
+import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.io.OutputStream;
 import java.math.BigInteger;
@@ -83,6 +85,31 @@ class DerInputBuffer extends ByteArrayInputStream implements Cloneable {
     }
     // END Android-added: Added getPos & getSlice, needed for APK parsing
 
+    // BEGIN Android-added: Copy values out without an intermediate array.
+    /**
+     * Writes the next {@code len} bytes to {@code out} and advances past
+     * them, as {@code read(byte[])} followed by {@code out.write(byte[])}
+     * would.
+     */
+    void readTo(ByteArrayOutputStream out, int len) throws IOException {
+        if (len > available()) {
+            throw new IOException("short read");
+        }
+        out.write(buf, pos, len);
+        pos += len;
+    }
+    // END Android-added: Copy values out without an intermediate array.
+
+    // Android-added: Decode OIDs without copying when they are interned.
+    ObjectIdentifier getOID(int len) throws IOException {
+        if (len > available()) {
+            throw new IOException("short read of OID");
+        }
+        ObjectIdentifier oid = ObjectIdentifier.intern(buf, pos, len);
+        pos += len;
+        return oid;
+    }
+
     int peek() throws IOException {
         if (pos >= count)
             throw new IOException("out of data");
@@ -312,7 +312,9 @@ public class DerInputStream {
      * Reads an X.200 style Object Identifier from the stream.
      */
     public ObjectIdentifier getOID() throws IOException {
-        return new ObjectIdentifier(this);
+        // Android-changed: Share interned instances.
+        // return new ObjectIdentifier(this);
+        return ObjectIdentifier.of(this);
     }
 
     /**
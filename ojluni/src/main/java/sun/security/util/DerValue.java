@@ -413,16 +413,15 @@ public class DerValue {
     throws IOException {
         out.write(tag);
         out.putLength(length);
-        // XXX yeech, excess copies ... DerInputBuffer.write(OutStream)
+        // Android-changed: Copy straight from the buffer, not via a temporary array.
         if (length > 0) {
-            byte[] value = new byte[length];
             // always synchronized on data
             synchronized (data) {
                 buffer.reset();
-                if (buffer.read(value) != length) {
+                if (buffer.available() < length) {
                     throw new IOException("short DER value read (encode)");
                 }
-                out.write(value);
+                buffer.readTo(out, length);
             }
         }
     }
@@ -462,7 +461,9 @@ public class DerValue {
     public ObjectIdentifier getOID() throws IOException {
         if (tag != tag_ObjectId)
             throw new IOException("DerValue.getOID, not an OID " + tag);
-        return new ObjectIdentifier(buffer);
+        // Android-changed: Share interned instances.
+        // return new ObjectIdentifier(buffer);
+        return ObjectIdentifier.of(buffer);
     }
 
     private byte[] append(byte[] a, byte[] b) {
@@ -856,7 +857,8 @@ public class DerValue {
      * @return DER-encoded value, including tag and length.
      */
     public byte[] toByteArray() throws IOException {
-        DerOutputStream out = new DerOutputStream();
+        // Android-changed: Presize for the tag, up to 5 length bytes and the value.
+        DerOutputStream out = new DerOutputStream(length + 6);
 
         encode(out);
         data.reset();
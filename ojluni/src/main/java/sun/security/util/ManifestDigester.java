@@ -26,8 +26,8 @@
 package sun.security.util;
 
 import java.security.*;
-import java.util.HashMap;
-import java.io.ByteArrayOutputStream;
+// Android-changed: Index sections by offset instead of keeping an Entry per name.
+import java.util.Arrays;
 
 /**
  * This class is used to compute digests on sections of the Manifest.
@@ -39,8 +39,28 @@ public class ManifestDigester {
     /** the raw bytes of the manifest */
     private byte rawBytes[];
 
-    /** the offset/length pair for a section */
-    private HashMap<String, Entry> entries; // key is a UTF-8 string
+    // BEGIN Android-changed: Index sections by offset instead of keeping an Entry per name.
+    /** the start of each section, followed by the end of the last one */
+    private int[] sectionStarts = new int[16];
+
+    /** the number of sections */
+    private int sectionCount;
+
+    /** the index in sectionStarts of each named section */
+    private int[] namedSections = new int[16];
+
+    /** the hash code of the name of each named section */
+    private int[] nameHashes = new int[16];
+
+    /** the number of named sections */
+    private int namedCount;
+
+    /**
+     * open addressing hash table of named sections, by name. Each slot holds
+     * an index into namedSections plus one, or 0 if empty.
+     */
+    private int[] table;
+    // END Android-changed: Index sections by offset instead of keeping an Entry per name.
 
     /** state returned by findSection */
     static class Position {
@@ -107,80 +127,171 @@ public class ManifestDigester {
         return false;
     }
 
+    // BEGIN Android-changed: Index sections by offset instead of keeping an Entry per name.
+    // A JAR with many entries has as many manifest sections. Only the start of each
+    // section and the hash code of its name are kept; names are decoded again, and
+    // Entry objects created, when a section is looked up.
     public ManifestDigester(byte bytes[])
     {
         rawBytes = bytes;
-        entries = new HashMap<String, Entry>();
-
-        ByteArrayOutputStream baos = new ByteArrayOutputStream();
 
         Position pos = new Position();
 
-        if (!findSection(0, pos))
+        if (!findSection(0, pos)) {
+            table = new int[1];
             return; // XXX: exception?
+        }
 
         // create an entry for main attributes
-        entries.put(MF_MAIN_ATTRS,
-                new Entry(0, pos.endOfSection + 1, pos.startOfNext, rawBytes));
+        addSection(0, MF_MAIN_ATTRS);
 
         int start = pos.startOfNext;
         while(findSection(start, pos)) {
             int len = pos.endOfFirstLine-start+1;
-            int sectionLen = pos.endOfSection-start+1;
-            int sectionLenWithBlank = pos.startOfNext-start;
+            String name = null;
 
             if (len > 6) {
                 if (isNameAttr(bytes, start)) {
-                    StringBuilder nameBuf = new StringBuilder(sectionLen);
-
-                    try {
-                        nameBuf.append(
-                            new String(bytes, start+6, len-6, "UTF8"));
-
-                        int i = start + len;
-                        if ((i-start) < sectionLen) {
-                            if (bytes[i] == '\r') {
-                                i += 2;
-                            } else {
-                                i += 1;
-                            }
-                        }
-
-                        while ((i-start) < sectionLen) {
-                            if (bytes[i++] == ' ') {
-                                // name is wrapped
-                                int wrapStart = i;
-                                while (((i-start) < sectionLen)
-                                        && (bytes[i++] != '\n'));
-                                    if (bytes[i-1] != '\n')
-                                        return; // XXX: exception?
-                                    int wrapLen;
-                                    if (bytes[i-2] == '\r')
-                                        wrapLen = i-wrapStart-2;
-                                    else
-                                        wrapLen = i-wrapStart-1;
-
-                            nameBuf.append(new String(bytes, wrapStart,
-                                                      wrapLen, "UTF8"));
-                            } else {
-                                break;
-                            }
-                        }
-
-                        entries.put(nameBuf.toString(),
-                            new Entry(start, sectionLen, sectionLenWithBlank,
-                                rawBytes));
-
-                    } catch (java.io.UnsupportedEncodingException uee) {
-                        throw new IllegalStateException(
-                            "UTF8 not available on platform");
-                    }
+                    name = parseName(start, pos);
+                    if (name == null)
+                        break; // XXX: exception?
                 }
             }
+            addSection(start, name);
             start = pos.startOfNext;
         }
+        sectionStarts = Arrays.copyOf(sectionStarts, sectionCount + 1);
+        sectionStarts[sectionCount] = start;
+        buildTable();
+    }
+
+    /**
+     * Returns the name of the section at start, whose first line must be a
+     * Name attribute, or null if the name is malformed.
+     */
+    private String parseName(int start, Position pos)
+    {
+        byte[] bytes = rawBytes;
+        int len = pos.endOfFirstLine-start+1;
+        int sectionLen = pos.endOfSection-start+1;
+        StringBuilder nameBuf = new StringBuilder(sectionLen);
+
+        try {
+            nameBuf.append(
+                new String(bytes, start+6, len-6, "UTF8"));
+
+            int i = start + len;
+            if ((i-start) < sectionLen) {
+                if (bytes[i] == '\r') {
+                    i += 2;
+                } else {
+                    i += 1;
+                }
+            }
+
+            while ((i-start) < sectionLen) {
+                if (bytes[i++] == ' ') {
+                    // name is wrapped
+                    int wrapStart = i;
+                    while (((i-start) < sectionLen)
+                            && (bytes[i++] != '\n'));
+                        if (bytes[i-1] != '\n')
+                            return null;
+                        int wrapLen;
+                        if (bytes[i-2] == '\r')
+                            wrapLen = i-wrapStart-2;
+                        else
+                            wrapLen = i-wrapStart-1;
+
+                nameBuf.append(new String(bytes, wrapStart,
+                                          wrapLen, "UTF8"));
+                } else {
+                    break;
+                }
+            }
+        } catch (java.io.UnsupportedEncodingException uee) {
+            throw new IllegalStateException(
+                "UTF8 not available on platform");
+        }
+        return nameBuf.toString();
+    }
+
+    /**
+     * Records the section at start, which is named if name is not null.
+     */
+    private void addSection(int start, String name)
+    {
+        if (sectionCount == sectionStarts.length) {
+            sectionStarts = Arrays.copyOf(sectionStarts, sectionCount * 2);
+        }
+        if (name != null) {
+            if (namedCount == namedSections.length) {
+                namedSections = Arrays.copyOf(namedSections, namedCount * 2);
+                nameHashes = Arrays.copyOf(nameHashes, namedCount * 2);
+            }
+            namedSections[namedCount] = sectionCount;
+            nameHashes[namedCount] = name.hashCode();
+            namedCount++;
+        }
+        sectionStarts[sectionCount++] = start;
+    }
+
+    /**
+     * Builds the table of named sections. As with the HashMap this replaces,
+     * a later section replaces an earlier one with the same name.
+     */
+    private void buildTable()
+    {
+        int size = 2;
+        while (size < namedCount * 2) {
+            size <<= 1;
+        }
+        table = new int[size];
+        int mask = size - 1;
+        for (int n = 0; n < namedCount; n++) {
+            int slot = spread(nameHashes[n]) & mask;
+            while (table[slot] != 0) {
+                int other = table[slot] - 1;
+                if ((nameHashes[other] == nameHashes[n]) &&
+                        sectionName(namedSections[other]).equals(
+                            sectionName(namedSections[n]))) {
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
+            table[slot] = n + 1;
+        }
+        nameHashes = Arrays.copyOf(nameHashes, namedCount);
+        namedSections = Arrays.copyOf(namedSections, namedCount);
+    }
+
+    private static int spread(int h)
+    {
+        return h ^ (h >>> 16);
     }
 
+    /** Returns the name of a section that was recorded with a name. */
+    private String sectionName(int section)
+    {
+        if (section == 0) {
+            return MF_MAIN_ATTRS;
+        }
+        Position pos = new Position();
+        int start = sectionStarts[section];
+        findSection(start, pos);
+        return parseName(start, pos);
+    }
+
+    private Entry newEntry(int section)
+    {
+        Position pos = new Position();
+        int start = sectionStarts[section];
+        findSection(start, pos);
+        return new Entry(start, pos.endOfSection - start + 1,
+                sectionStarts[section + 1] - start, rawBytes);
+    }
+    // END Android-changed: Index sections by offset instead of keeping an Entry per name.
+
     private boolean isNameAttr(byte bytes[], int start)
     {
         return ((bytes[start] == 'N') || (bytes[start] == 'n')) &&
@@ -255,10 +366,24 @@ public class ManifestDigester {
     }
 
     public Entry get(String name, boolean oldStyle) {
-        Entry e = entries.get(name);
-        if (e != null)
-            e.oldStyle = oldStyle;
-        return e;
+        // BEGIN Android-changed: Index sections by offset instead of keeping an Entry per name.
+        if (name == null) {
+            return null;
+        }
+        int hash = name.hashCode();
+        int mask = table.length - 1;
+        for (int slot = spread(hash) & mask; table[slot] != 0;
+                slot = (slot + 1) & mask) {
+            int n = table[slot] - 1;
+            if ((nameHashes[n] == hash) &&
+                    name.equals(sectionName(namedSections[n]))) {
+                Entry e = newEntry(namedSections[n]);
+                e.oldStyle = oldStyle;
+                return e;
+            }
+        }
+        return null;
+        // END Android-changed: Index sections by offset instead of keeping an Entry per name.
     }
 
     public byte[] manifestDigest(MessageDigest md)
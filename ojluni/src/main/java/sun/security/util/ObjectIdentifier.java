@@ -28,6 +28,10 @@ package sun.security.util;
 import java.io.*;
 import java.math.BigInteger;
 import java.util.Arrays;
+// BEGIN Android-added: Intern ObjectIdentifiers.
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicReferenceArray;
+// END Android-added: Intern ObjectIdentifiers.
 
 /**
  * Represent an ISO Object Identifier.
@@ -61,6 +65,14 @@ class ObjectIdentifier implements Serializable
 
     private transient volatile String stringForm;
 
+    // BEGIN Android-added: Intern ObjectIdentifiers.
+    // Cached hashCode(), or 0 if not yet computed.
+    private transient int hash;
+
+    // Whether this was created by newInternal().
+    private transient boolean internal;
+    // END Android-added: Intern ObjectIdentifiers.
+
     /*
      * IMPORTANT NOTES FOR CODE CHANGES (bug 4811968) IN JDK 1.7.0
      * ===========================================================
@@ -266,6 +278,111 @@ class ObjectIdentifier implements Serializable
         check(encoding);
     }
 
+    // BEGIN Android-added: Intern ObjectIdentifiers.
+    /*
+     * Certificates repeat a small set of OIDs (algorithms, extensions and
+     * name attributes), so decoding returns a shared instance for an
+     * encoding seen before instead of allocating a new one. The table is
+     * direct mapped by hash: a slot holds the most recently decoded OID,
+     * except that a slot holding a constant from newInternal() is never
+     * replaced, so that decoded OIDs are usually identical to the constants
+     * they are compared with.
+     */
+    private static final int INTERN_TABLE_SIZE = 1024;  // power of two
+    private static final AtomicReferenceArray<ObjectIdentifier> internTable =
+            new AtomicReferenceArray<>(INTERN_TABLE_SIZE);
+
+    // Constants from newInternal(), by dotted form.
+    private static final ConcurrentHashMap<String, ObjectIdentifier> internalByString =
+            new ConcurrentHashMap<>();
+
+    private ObjectIdentifier(byte[] encoding, int hash) {
+        this.encoding = encoding;
+        this.hash = hash;
+    }
+
+    private static int internIndex(int hash) {
+        return (hash ^ (hash >>> 16)) & (INTERN_TABLE_SIZE - 1);
+    }
+
+    /**
+     * Returns an identifier with the encoding held in
+     * {@code buf[offset, offset + len)}, which is not retained. Validity
+     * check NOT included, as in the DER constructors.
+     */
+    static ObjectIdentifier intern(byte[] buf, int offset, int len)
+            throws IOException {
+        int end = offset + len;
+        int h = 1;  // as Arrays.hashCode(byte[])
+        for (int i = offset; i < end; i++) {
+            h = 31 * h + buf[i];
+        }
+        int index = internIndex(h);
+        ObjectIdentifier cached = internTable.get(index);
+        if (cached != null && cached.hashCode() == h
+                && regionEquals(cached.encoding, buf, offset, len)) {
+            return cached;
+        }
+        byte[] encoding = Arrays.copyOfRange(buf, offset, end);
+        check(encoding);
+        ObjectIdentifier oid = new ObjectIdentifier(encoding, h);
+        if (cached == null || !cached.internal) {
+            internTable.set(index, oid);
+        }
+        return oid;
+    }
+
+    private static boolean regionEquals(byte[] a, byte[] b, int offset, int len) {
+        if (a.length != len) {
+            return false;
+        }
+        for (int i = 0; i < len; i++) {
+            if (a[i] != b[offset + i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * As ObjectIdentifier(DerInputStream), but may return a shared instance.
+     */
+    static ObjectIdentifier of(DerInputStream in) throws IOException {
+        byte type_id = (byte) in.getByte();
+        if (type_id != DerValue.tag_ObjectId)
+            throw new IOException (
+                "ObjectIdentifier() -- data isn't an object ID"
+                + " (tag = " +  type_id + ")"
+                );
+
+        int len = in.getLength();
+        if (len > in.available()) {
+            throw new IOException("ObjectIdentifier() -- length exceeds" +
+                    "data available.  Length: " + len + ", Available: " +
+                    in.available());
+        }
+        return in.buffer.getOID(len);
+    }
+
+    /**
+     * As ObjectIdentifier(DerInputBuffer), but may return a shared instance.
+     */
+    static ObjectIdentifier of(DerInputBuffer buf) throws IOException {
+        buf.mark(Integer.MAX_VALUE);
+        return buf.getOID(buf.available());
+    }
+
+    /**
+     * Returns an identifier for the dotted form {@code oid}. This is the
+     * constant from newInternal() if there is one, otherwise as
+     * ObjectIdentifier(String).
+     */
+    public static ObjectIdentifier of(String oid) throws IOException {
+        ObjectIdentifier internal = internalByString.get(oid);
+        return (internal != null) ? internal : new ObjectIdentifier(oid);
+    }
+    // END Android-added: Intern ObjectIdentifiers.
+
     /*
      * Constructor, from the rest of a DER input buffer;
      * the tag and length have been removed/verified
@@ -309,7 +426,14 @@ class ObjectIdentifier implements Serializable
      */
     public static ObjectIdentifier newInternal(int[] values) {
         try {
-            return new ObjectIdentifier(values);
+            // BEGIN Android-changed: Intern constants, with their dotted form.
+            // return new ObjectIdentifier(values);
+            ObjectIdentifier oid = new ObjectIdentifier(values);
+            oid.internal = true;
+            internTable.set(internIndex(oid.hashCode()), oid);
+            internalByString.putIfAbsent(oid.toString(), oid);
+            return oid;
+            // END Android-changed: Intern constants, with their dotted form.
         } catch (IOException ex) {
             throw new RuntimeException(ex);
             // Should not happen, internal calls always uses legal values.
@@ -346,12 +470,23 @@ class ObjectIdentifier implements Serializable
             return false;
         }
         ObjectIdentifier other = (ObjectIdentifier)obj;
+        // Android-added: Compare cached hash codes first.
+        if (hash != 0 && other.hash != 0 && hash != other.hash) {
+            return false;
+        }
         return Arrays.equals(encoding, other.encoding);
     }
 
     @Override
     public int hashCode() {
-        return Arrays.hashCode(encoding);
+        // Android-changed: Cache the hash code.
+        // return Arrays.hashCode(encoding);
+        int h = hash;
+        if (h == 0) {
+            h = Arrays.hashCode(encoding);
+            hash = h;
+        }
+        return h;
     }
 
     /**
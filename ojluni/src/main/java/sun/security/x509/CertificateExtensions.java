@@ -30,6 +30,7 @@ import java.io.OutputStream;
 import java.lang.reflect.Constructor;
 import java.lang.reflect.Field;
 import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Modifier;
 import java.security.cert.CertificateException;
 import java.util.*;
 
@@ -63,6 +64,17 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
 
     private Map<String,Extension> unparseableExtensions;
 
+    // BEGIN Android-added: Decode non-critical extensions on first use.
+    // A non-critical extension whose constructor throws is recorded as
+    // unparseable instead of failing the certificate, so decoding can be
+    // deferred until the extensions are read without changing which
+    // certificates parse. Extensions that could fail any other way are
+    // decoded eagerly; see canDefer(). Callers that only need the subject,
+    // validity and key never pay for it. Cleared once the extensions have
+    // been decoded.
+    private volatile List<Extension> deferredExtensions;
+    // END Android-added: Decode non-critical extensions on first use.
+
     /**
      * Default constructor.
      */
@@ -83,12 +95,121 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
 
         DerValue[] exts = in.getSequence(5);
 
+        // BEGIN Android-changed: Decode non-critical extensions on first use.
+        Extension[] parsed = new Extension[exts.length];
+        Set<ObjectIdentifier> ids = new HashSet<>();
+        boolean duplicates = false;
         for (int i = 0; i < exts.length; i++) {
-            Extension ext = new Extension(exts[i]);
-            parseExtension(ext);
+            parsed[i] = new Extension(exts[i]);
+            duplicates |= !ids.add(parsed[i].getExtensionId());
+        }
+        // Extensions of the same class are stored under the same name.
+        Set<Class<?>> classes = new HashSet<>();
+        for (int i = 0; i < parsed.length && !duplicates; i++) {
+            Class<?> extClass = extensionClass(parsed[i]);
+            duplicates = extClass != null && !classes.add(extClass);
+        }
+        if (duplicates) {
+            // Decode everything now so that duplicates fail as before.
+            for (Extension ext : parsed) {
+                parseExtension(ext);
+            }
+            return;
+        }
+        List<Extension> deferred = null;
+        for (Extension ext : parsed) {
+            if (ext.isCritical() || !canDefer(ext)) {
+                parseExtension(ext);
+            } else {
+                if (deferred == null) {
+                    deferred = new ArrayList<>(parsed.length);
+                }
+                deferred.add(ext);
+            }
+        }
+        deferredExtensions = deferred;
+        // END Android-changed: Decode non-critical extensions on first use.
+    }
+
+    // BEGIN Android-added: Decode non-critical extensions on first use.
+    /**
+     * Decode the extensions deferred by init(), if any. Must be called
+     * before reading map or unparseableExtensions.
+     */
+    private void decodeDeferredExtensions() {
+        if (deferredExtensions == null) {
+            return;
+        }
+        synchronized (this) {
+            List<Extension> deferred = deferredExtensions;
+            if (deferred == null) {
+                return;
+            }
+            for (Extension ext : deferred) {
+                try {
+                    parseExtension(ext);
+                } catch (IOException e) {
+                    // Not expected: init() has ruled out duplicates and
+                    // checked that the extension class can be constructed.
+                    addUnparseableExtension(ext, e);
+                }
+            }
+            deferredExtensions = null;
         }
     }
 
+    /** Returns the class OIDMap maps {@code ext} to, or null. */
+    private static Class<?> extensionClass(Extension ext) {
+        try {
+            return OIDMap.getClass(ext.getExtensionId());
+        } catch (CertificateException e) {
+            return null;
+        }
+    }
+
+    /**
+     * Returns true if parseExtension() can only fail for {@code ext} by its
+     * constructor throwing, which makes a non-critical extension unparseable.
+     * Other failures fail the certificate, so they must happen in init().
+     */
+    private static boolean canDefer(Extension ext) {
+        Class<?> extClass;
+        try {
+            extClass = OIDMap.getClass(ext.getExtensionId());
+        } catch (CertificateException e) {
+            return false;
+        }
+        if (extClass == null) {
+            return true;
+        }
+        int modifiers = extClass.getModifiers();
+        if (!Modifier.isPublic(modifiers) || Modifier.isAbstract(modifiers)
+                || !CertAttrSet.class.isAssignableFrom(extClass)
+                || !Extension.class.isAssignableFrom(extClass)) {
+            return false;
+        }
+        try {
+            getConstructor(extClass);
+        } catch (NoSuchMethodException e) {
+            return false;
+        }
+        return true;
+    }
+
+    private static final Map<Class<?>, Constructor<?>> constructors =
+            new java.util.concurrent.ConcurrentHashMap<>();
+
+    private static Constructor<?> getConstructor(Class<?> extClass)
+            throws NoSuchMethodException {
+        Constructor<?> cons = constructors.get(extClass);
+        if (cons == null) {
+            cons = extClass.getConstructor(PARAMS);
+            constructors.put(extClass, cons);
+        }
+        return cons;
+    }
+    // END Android-added: Decode non-critical extensions on first use.
+
     private static Class[] PARAMS = {Boolean.class, Object.class};
 
     // Parse the encoded extension
@@ -105,7 +226,8 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
                     throw new IOException("Duplicate extensions not allowed");
                 }
             }
-            Constructor<?> cons = extClass.getConstructor(PARAMS);
+            // Android-changed: Cache the constructor of each extension class.
+            Constructor<?> cons = getConstructor(extClass);
 
             Object[] passed = new Object[] {Boolean.valueOf(ext.isCritical()),
                     ext.getExtensionValue()};
@@ -118,17 +240,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
             Throwable e = invk.getTargetException();
             if (ext.isCritical() == false) {
                 // ignore errors parsing non-critical extensions
-                if (unparseableExtensions == null) {
-                    unparseableExtensions = new TreeMap<String,Extension>();
-                }
-                unparseableExtensions.put(ext.getExtensionId().toString(),
-                        new UnparseableExtension(ext, e));
-                if (debug != null) {
-                    debug.println("Error parsing extension: " + ext);
-                    e.printStackTrace();
-                    HexDumpEncoder h = new HexDumpEncoder();
-                    System.err.println(h.encodeBuffer(ext.getExtensionValue()));
-                }
+                addUnparseableExtension(ext, e);
                 return;
             }
             if (e instanceof IOException) {
@@ -143,6 +255,21 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
         }
     }
 
+    // Android-changed: Moved out of parseExtension for decodeDeferredExtensions.
+    private void addUnparseableExtension(Extension ext, Throwable e) {
+        if (unparseableExtensions == null) {
+            unparseableExtensions = new TreeMap<String,Extension>();
+        }
+        unparseableExtensions.put(ext.getExtensionId().toString(),
+                new UnparseableExtension(ext, e));
+        if (debug != null) {
+            debug.println("Error parsing extension: " + ext);
+            e.printStackTrace();
+            HexDumpEncoder h = new HexDumpEncoder();
+            System.err.println(h.encodeBuffer(ext.getExtensionValue()));
+        }
+    }
+
     /**
      * Encode the extensions in DER form to the stream, setting
      * the context specific tag as needed in the X.509 v3 certificate.
@@ -166,6 +293,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
      */
     public void encode(OutputStream out, boolean isCertReq)
     throws CertificateException, IOException {
+        decodeDeferredExtensions();  // Android-added
         DerOutputStream extOut = new DerOutputStream();
         Collection<Extension> allExts = map.values();
         Object[] objs = allExts.toArray();
@@ -200,6 +328,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
      * @exception IOException if the object could not be cached.
      */
     public void set(String name, Object obj) throws IOException {
+        decodeDeferredExtensions();  // Android-added
         if (obj instanceof Extension) {
             map.put(name, (Extension)obj);
         } else {
@@ -213,6 +342,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
      * @exception IOException if named extension is not found.
      */
     public Extension get(String name) throws IOException {
+        decodeDeferredExtensions();  // Android-added
         Extension obj = map.get(name);
         if (obj == null) {
             throw new IOException("No extension found with name " + name);
@@ -223,6 +353,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
     // Similar to get(String), but throw no exception, might return null.
     // Used in X509CertImpl::getExtension(OID).
     Extension getExtension(String name) {
+        decodeDeferredExtensions();  // Android-added
         return map.get(name);
     }
 
@@ -232,6 +363,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
      * @exception IOException if named extension is not found.
      */
     public void delete(String name) throws IOException {
+        decodeDeferredExtensions();  // Android-added
         Object obj = map.get(name);
         if (obj == null) {
             throw new IOException("No extension found with name " + name);
@@ -240,6 +372,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
     }
 
     public String getNameByOid(ObjectIdentifier oid) throws IOException {
+        decodeDeferredExtensions();  // Android-added
         for (String name: map.keySet()) {
             if (map.get(name).getExtensionId().equals((Object)oid)) {
                 return name;
@@ -253,6 +386,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
      * attribute.
      */
     public Enumeration<Extension> getElements() {
+        decodeDeferredExtensions();  // Android-added
         return Collections.enumeration(map.values());
     }
 
@@ -261,10 +395,12 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
      * @return a collection view of the extensions in this Certificate.
      */
     public Collection<Extension> getAllExtensions() {
+        decodeDeferredExtensions();  // Android-added
         return map.values();
     }
 
     public Map<String,Extension> getUnparseableExtensions() {
+        decodeDeferredExtensions();  // Android-added
         if (unparseableExtensions == null) {
             return Collections.emptyMap();
         } else {
@@ -303,6 +439,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
             return true;
         if (!(other instanceof CertificateExtensions))
             return false;
+        decodeDeferredExtensions();  // Android-added
         Collection<Extension> otherC =
                 ((CertificateExtensions)other).getAllExtensions();
         Object[] objs = otherC.toArray();
@@ -335,6 +472,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
      * @return the hashcode value.
      */
     public int hashCode() {
+        decodeDeferredExtensions();  // Android-added
         return map.hashCode() + getUnparseableExtensions().hashCode();
     }
 
@@ -347,6 +485,7 @@ public class CertificateExtensions implements CertAttrSet<Extension> {
      * @return  a string representation of this CertificateExtensions.
      */
     public String toString() {
+        decodeDeferredExtensions();  // Android-added
         return map.toString();
     }
 
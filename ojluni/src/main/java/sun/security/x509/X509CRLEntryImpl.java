@@ -396,11 +396,16 @@ public class X509CRLEntryImpl extends X509CRLEntry
         if (extensions == null)
             return null;
         try {
-            String extAlias = OIDMap.getName(new ObjectIdentifier(oid));
+            // BEGIN Android-changed: Parse the OID once, using the constant if known.
+            // String extAlias = OIDMap.getName(new ObjectIdentifier(oid));
+            ObjectIdentifier findOID = ObjectIdentifier.of(oid);
+            String extAlias = OIDMap.getName(findOID);
+            // END Android-changed: Parse the OID once, using the constant if known.
             Extension crlExt = null;
 
             if (extAlias == null) { // may be unknown
-                ObjectIdentifier findOID = new ObjectIdentifier(oid);
+                // Android-removed: Parsed above.
+                // ObjectIdentifier findOID = new ObjectIdentifier(oid);
                 Extension ex = null;
                 ObjectIdentifier inCertOID;
                 for (Enumeration<Extension> e = extensions.getElements();
@@ -29,6 +29,7 @@ import java.io.InputStreamReader;
 import java.io.Reader;
 import java.util.HashMap;
 import java.util.Map;
+import libcore.internal.ConcurrentStringPool;
 import libcore.internal.StringPool;
 import org.xmlpull.v1.XmlPullParser;
 import org.xmlpull.v1.XmlPullParserException;
@@ -181,6 +182,12 @@ public class KXmlParser implements XmlPullParser, Closeable {
 
     public final StringPool stringPool = new StringPool();
 
+    /**
+     * An optional pool for element and attribute names that may be shared
+     * with other parsers. Null to use this parser's private {@link #stringPool}.
+     */
+    private ConcurrentStringPool namePool;
+
     /**
      * Retains namespace attributes like {@code xmlns="http://foo"} or {@code xmlns:foo="http:foo"}
      * in pulled elements. Most applications will only be interested in the effective namespaces of
@@ -191,6 +198,16 @@ public class KXmlParser implements XmlPullParser, Closeable {
         this.keepNamespaceAttributes = true;
     }
 
+    /**
+     * Interns element and attribute names in {@code namePool} rather than in
+     * this parser's private pool. Sharing one pool between the parsers that
+     * read documents of the same schema avoids allocating new name strings for
+     * each parser. Pass null to revert to the private pool.
+     */
+    public void setNamePool(ConcurrentStringPool namePool) {
+        this.namePool = namePool;
+    }
+
     private boolean adjustNsp() throws XmlPullParserException {
         boolean any = false;
 
@@ -1582,7 +1599,9 @@ public class KXmlParser implements XmlPullParser, Closeable {
 
             // we encountered a non-name character. done!
             if (result == null) {
-                return stringPool.get(buffer, start, position - start);
+                return namePool != null
+                        ? namePool.get(buffer, start, position - start)
+                        : stringPool.get(buffer, start, position - start);
             } else {
                 result.append(buffer, start, position - start);
                 return result.toString();
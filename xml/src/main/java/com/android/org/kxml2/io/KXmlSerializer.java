@@ -28,13 +28,25 @@ import org.xmlpull.v1.*;
 public class KXmlSerializer implements XmlSerializer {
 
     private static final int BUFFER_LEN = 8192;
-    private final char[] mText = new char[BUFFER_LEN];
+    private final char[] mText;
     private int mPos;
 
     //    static final String UNDEFINED = ":";
 
     private Writer writer;
 
+    // BEGIN Android-added: direct UTF-8 output.
+    // When output is a UTF-8 OutputStream we encode mText straight into
+    // mBytes instead of going through an OutputStreamWriter. Both buffers
+    // belong to this serializer and are reused across setOutput() calls.
+    private static final int MIN_BYTE_BUFFER_LEN = 4;
+    private final int byteBufferLength;
+    private byte[] mBytes;
+    private OutputStream outputStream;
+    // A high surrogate at the end of mText, waiting for its low surrogate.
+    private char pendingHighSurrogate;
+    // END Android-added: direct UTF-8 output.
+
     private boolean pending;
     private int auto;
     private int depth;
@@ -48,8 +60,31 @@ public class KXmlSerializer implements XmlSerializer {
     private boolean unicode;
     private String encoding;
 
+    public KXmlSerializer() {
+        this(BUFFER_LEN, BUFFER_LEN);
+    }
+
+    // BEGIN Android-added: configurable buffer sizes.
+    /**
+     * Creates a serializer that buffers up to {@code charBufferLength} chars
+     * before writing them out. When writing to a UTF-8 {@link OutputStream},
+     * chars are encoded into a buffer of {@code byteBufferLength} bytes.
+     */
+    public KXmlSerializer(int charBufferLength, int byteBufferLength) {
+        if (charBufferLength <= 0) {
+            throw new IllegalArgumentException("charBufferLength <= 0: " + charBufferLength);
+        }
+        if (byteBufferLength < MIN_BYTE_BUFFER_LEN) {
+            throw new IllegalArgumentException("byteBufferLength < " + MIN_BYTE_BUFFER_LEN
+                    + ": " + byteBufferLength);
+        }
+        this.mText = new char[charBufferLength];
+        this.byteBufferLength = byteBufferLength;
+    }
+    // END Android-added: configurable buffer sizes.
+
     private void append(char c) throws IOException {
-        if (mPos >= BUFFER_LEN) {
+        if (mPos >= mText.length) {
             flushBuffer();
         }
         mText[mPos++] = c;
@@ -57,10 +92,10 @@ public class KXmlSerializer implements XmlSerializer {
 
     private void append(String str, int i, int length) throws IOException {
         while (length > 0) {
-            if (mPos == BUFFER_LEN) {
+            if (mPos == mText.length) {
                 flushBuffer();
             }
-            int batch = BUFFER_LEN - mPos;
+            int batch = mText.length - mPos;
             if (batch > length) {
                 batch = length;
             }
@@ -77,12 +112,79 @@ public class KXmlSerializer implements XmlSerializer {
 
     private final void flushBuffer() throws IOException {
         if(mPos > 0) {
-            writer.write(mText, 0, mPos);
-            writer.flush();
+            if (outputStream != null) {
+                writeUtf8(mText, mPos);
+            } else {
+                writer.write(mText, 0, mPos);
+                writer.flush();
+            }
             mPos = 0;
         }
     }
 
+    // BEGIN Android-added: direct UTF-8 output.
+    /**
+     * Encodes {@code chars[0..count)} as UTF-8 and writes the bytes to
+     * {@link #outputStream}. Unpaired surrogates are replaced with '?', as
+     * an {@link OutputStreamWriter} would.
+     */
+    private void writeUtf8(char[] chars, int count) throws IOException {
+        byte[] bytes = mBytes;
+        int b = 0;
+        int i = 0;
+        if (pendingHighSurrogate != 0) {
+            char high = pendingHighSurrogate;
+            pendingHighSurrogate = 0;
+            if (Character.isLowSurrogate(chars[0])) {
+                b = putCodePoint(bytes, b, Character.toCodePoint(high, chars[0]));
+                i = 1;
+            } else {
+                bytes[b++] = '?';
+            }
+        }
+        while (i < count) {
+            if (b > bytes.length - 4) {
+                outputStream.write(bytes, 0, b);
+                b = 0;
+            }
+            char c = chars[i++];
+            if (c < 0x80) {
+                // Copy the rest of an ASCII run without further checks.
+                bytes[b++] = (byte) c;
+                int runEnd = Math.min(count, i + bytes.length - b);
+                while (i < runEnd && (c = chars[i]) < 0x80) {
+                    bytes[b++] = (byte) c;
+                    i++;
+                }
+            } else if (c < 0x800) {
+                bytes[b++] = (byte) (0xc0 | (c >> 6));
+                bytes[b++] = (byte) (0x80 | (c & 0x3f));
+            } else if (!Character.isSurrogate(c)) {
+                bytes[b++] = (byte) (0xe0 | (c >> 12));
+                bytes[b++] = (byte) (0x80 | ((c >> 6) & 0x3f));
+                bytes[b++] = (byte) (0x80 | (c & 0x3f));
+            } else if (Character.isHighSurrogate(c) && i == count) {
+                pendingHighSurrogate = c;
+            } else if (Character.isHighSurrogate(c) && Character.isLowSurrogate(chars[i])) {
+                b = putCodePoint(bytes, b, Character.toCodePoint(c, chars[i++]));
+            } else {
+                bytes[b++] = '?';
+            }
+        }
+        if (b > 0) {
+            outputStream.write(bytes, 0, b);
+        }
+    }
+
+    private static int putCodePoint(byte[] bytes, int b, int codePoint) {
+        bytes[b++] = (byte) (0xf0 | (codePoint >> 18));
+        bytes[b++] = (byte) (0x80 | ((codePoint >> 12) & 0x3f));
+        bytes[b++] = (byte) (0x80 | ((codePoint >> 6) & 0x3f));
+        bytes[b++] = (byte) (0x80 | (codePoint & 0x3f));
+        return b;
+    }
+    // END Android-added: direct UTF-8 output.
+
     private final void check(boolean close) throws IOException {
         if (!pending)
             return;
@@ -127,7 +229,20 @@ public class KXmlSerializer implements XmlSerializer {
     }
 
     private final void writeEscaped(String s, int quot) throws IOException {
-        for (int i = 0; i < s.length(); i++) {
+        final int length = s.length();
+        for (int i = 0; i < length; i++) {
+            // BEGIN Android-added: copy runs that need no escaping in bulk.
+            int runStart = i;
+            while (i < length && isPlain(s.charAt(i), quot)) {
+                i++;
+            }
+            if (i > runStart) {
+                append(s, runStart, i - runStart);
+                if (i == length) {
+                    break;
+                }
+            }
+            // END Android-added: copy runs that need no escaping in bulk.
             char c = s.charAt(i);
             switch (c) {
                 case '\n':
@@ -166,7 +281,7 @@ public class KXmlSerializer implements XmlSerializer {
                         } else {
                             append("&#" + ((int) c) + ";");
                         }
-                    } else if (Character.isHighSurrogate(c) && i < s.length() - 1) {
+                    } else if (Character.isHighSurrogate(c) && i < length - 1) {
                         writeSurrogate(c, s.charAt(i + 1));
                         ++i;
                     } else {
@@ -178,6 +293,16 @@ public class KXmlSerializer implements XmlSerializer {
     }
 
     // BEGIN Android-added
+    /**
+     * Returns true if {@code c} can be written as-is by {@link #writeEscaped}.
+     * This must agree with the escaping rules there.
+     */
+    private boolean isPlain(char c, int quot) {
+        return c >= 0x20 && c < 0xd800
+                && c != '&' && c != '<' && c != '>' && c != quot
+                && (unicode || c < 127);
+    }
+
     private static void reportInvalidCharacter(char ch) {
         throw new IllegalArgumentException("Illegal character (U+" + Integer.toHexString((int) ch) + ")");
     }
@@ -336,6 +461,8 @@ public class KXmlSerializer implements XmlSerializer {
 
     public void setOutput(Writer writer) {
         this.writer = writer;
+        this.outputStream = null;
+        this.pendingHighSurrogate = 0;
 
         // elementStack = new String[12]; //nsp/prefix/name
         //nspCounts = new int[4];
@@ -359,6 +486,18 @@ public class KXmlSerializer implements XmlSerializer {
         throws IOException {
         if (os == null)
             throw new IllegalArgumentException("os == null");
+        // BEGIN Android-added: direct UTF-8 output.
+        if ("UTF-8".equalsIgnoreCase(encoding) || "UTF8".equalsIgnoreCase(encoding)) {
+            setOutput((Writer) null);
+            if (mBytes == null) {
+                mBytes = new byte[byteBufferLength];
+            }
+            this.outputStream = os;
+            this.encoding = encoding;
+            this.unicode = true;
+            return;
+        }
+        // END Android-added: direct UTF-8 output.
         setOutput(
             encoding == null
                 ? new OutputStreamWriter(os)
@@ -501,6 +640,9 @@ public class KXmlSerializer implements XmlSerializer {
     public void flush() throws IOException {
         check(false);
         flushBuffer();
+        if (outputStream != null) {
+            outputStream.flush();
+        }
     }
     /*
         public void close() throws IOException {